@@ -31,6 +31,7 @@
 
 #include "brightness.h"
 #include "config.h"
+#include "framescheduler.h"
 #include "ledfunctions.h"
 #include "ntp.h"
 #include "webserver.h"
@@ -285,16 +286,22 @@ DisplayMode mmode = DisplayMode::plain;
 // loop
 //-----------------------------------------------------------------------------------
 void loop() {
-	delay( 10 );
-
 	// do OTA update stuff
 	ArduinoOTA.handle();
 
-	// update LEDs
-	LED.setBrightness( Brightness.value() );
-	LED.setTime( h, m, s, ms );
-	LED.setDate( year, month, day );
-	LED.process();
+	// render the next frame when its deadline is reached, the rest of each frame slot
+	// is left to OTA, HTTP and telnet handling instead of blocking in delay()
+	bool frameRendered = FrameScheduler.frameDue( micros(), LED.getFramePeriod() );
+	if( frameRendered ) {
+		// update LEDs
+		LED.setBrightness( Brightness.value() );
+		LED.setTime( h, m, s, ms );
+		LED.setDate( year, month, day );
+		LED.process();
+	}
+	// start the transfer of a frame rendered while the previous one was still clocked
+	// out, dithered frames are sent at a higher rate than slow display modes render them
+	LED.refresh();
 
 	// do not continue if OTA update is in progress
 	// OTA callbacks drive the LED display mode and OTA progress
@@ -305,39 +312,43 @@ void loop() {
 
 	// show the hourglass animation with green corners for the first 2.5 seconds
 	// after boot to be able to reflash with OTA during that time window if
-	// the firmware hangs afterwards
+	// the firmware hangs afterwards (25 frames at the 100 ms hourglass frame period)
 	if( updateCountdown ) {
-		setLED( 0, 1, 0 );
-		LED.setMode( DisplayMode::greenHourglass );
-		Serial.print( "." );
-		delay( 100 );
-		updateCountdown--;
-		if( updateCountdown == 0 ) {
-			LED.setMode( Config.defaultMode );
-			setLED( 0, 0, 0 );
+		if( frameRendered ) {
+			setLED( 0, 1, 0 );
+			LED.setMode( DisplayMode::greenHourglass );
+			Serial.print( "." );
+			updateCountdown--;
+			if( updateCountdown == 0 ) {
+				LED.setMode( Config.defaultMode );
+				setLED( 0, 0, 0 );
+			}
 		}
 		return;
 	}
 
-	// set special mode depending on current time
-	if( h == 22 && m == 00 ) {
-		specialModeTicker = 600;
-		LED.setMode( DisplayMode::heart );
-	} else if( h == 13 && m == 37 ) {
-		specialModeTicker = 600;
-		LED.setMode( DisplayMode::matrix );
-	} else if( h == 23 && m == 00 ) {
-		specialModeTicker = 600;
-		LED.setMode( DisplayMode::stars );
-	}
-	if( specialModeTicker-- > 0 ) {
-		if( specialModeTicker == 0 ) {
-			// still not clear why this leads to access exceptions?
-			// fetching it in a local var first works!!
-			int mx = (int)LED.mode;
-			int dm = (int)Config.defaultMode;
-			if( mx != dm ) {
-				LED.setMode( (DisplayMode)dm );
+	// set special mode depending on current time, once per frame since setMode()
+	// renders a frame as well
+	if( frameRendered ) {
+		if( h == 22 && m == 00 ) {
+			specialModeTicker = 600;
+			LED.setMode( DisplayMode::heart );
+		} else if( h == 13 && m == 37 ) {
+			specialModeTicker = 600;
+			LED.setMode( DisplayMode::matrix );
+		} else if( h == 23 && m == 00 ) {
+			specialModeTicker = 600;
+			LED.setMode( DisplayMode::stars );
+		}
+		if( specialModeTicker-- > 0 ) {
+			if( specialModeTicker == 0 ) {
+				// still not clear why this leads to access exceptions?
+				// fetching it in a local var first works!!
+				int mx = (int)LED.mode;
+				int dm = (int)Config.defaultMode;
+				if( mx != dm ) {
+					LED.setMode( (DisplayMode)dm );
+				}
 			}
 		}
 	}
@@ -357,8 +368,11 @@ void loop() {
 	// output current time if seconds value has changed
 	if( s != lastSecond ) {
 		lastSecond = s;
-		DEBUG( "%02i:%02i:%02i, ADC=%i, heap=%i, brightness=%i\r\n", h, m, s, Brightness.avg, ESP.getFreeHeap(),
-		       Brightness.value() );
+		DEBUG( "%02i:%02i:%02i, ADC=%i, heap=%i, brightness=%i, missed frames=%u, render=%uus, transfer=%uus, "
+		       "convert=%u/%u cycles, current=%umA, power scale=%u\r\n",
+		       h, m, s, Brightness.avg, ESP.getFreeHeap(), Brightness.value(), FrameScheduler.missedDeadlines,
+		       LED.getRenderMicros(), LED.getTransferMicros(), LED.getConvertCycles(), LED.getConvertMaxCycles(),
+		       LED.getPowerLimiter().getMilliamps(), LED.getPowerLimiter().getScale() );
 #if 0
 		Serial.printf( "mmu_is_iram/dram &LED.mode: %08x : %i %i size=%i\r\n", &( LED.mode ), mmu_is_iram( &( LED.mode ) ),
 		               mmu_is_dram( &( LED.mode ) ), sizeof( LED.mode ) );
@@ -0,0 +1,254 @@
+// ESP8266 Wordclock
+// Copyright (C) 2016 Thoralt Franz, https://github.com/thoralt
+// also (C) 2021 by Stefan Rinke, https://github.com/sker65
+//
+//  Compile time generator for the 8 bit brightness correction curves. Every LED
+//  type is described by one led_curve_params_t entry in ledCurveTypes[], the
+//  tables are computed by the compiler and end up in flash as uint8_t arrays.
+//
+//  A curve is either parametric (black level cutoff, gamma, white balance per
+//  channel) or follows a measured response given as knots per channel, which are
+//  linearly interpolated. Adding an LED type means adding one entry to
+//  ledCurveTypes[] and selecting it in LEDMatrix::brightnessCurveSelect, e. g.
+//
+//      { 12, 2.2, { 1.0, 0.85, 0.8 }, { NULL, NULL, NULL }, { 0, 0, 0 }, 1 }
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// one point of a measured LED response: input value -> output value
+typedef struct _curve_knot_t {
+	uint8_t index, value;
+} curve_knot_t;
+
+typedef struct _led_curve_params_t {
+	// input values below cutoff are switched off completely (black level)
+	uint8_t cutoff;
+	// parametric curve: out = 255 * whiteBalance * (in / 255) ^ gamma
+	double gamma;
+	double whiteBalance[3];
+	// optional measured response per channel (r, g, b), replaces gamma and white
+	// balance if present; knots must be sorted by index and not decreasing
+	const curve_knot_t* knots[3];
+	uint8_t knotCount[3];
+	// number of consecutive input values sharing one output value (measurement step)
+	uint8_t step;
+} led_curve_params_t;
+
+// measured response of LED type 2 (7 bit measurement, two inputs per output value)
+// clang-format off
+constexpr curve_knot_t ledType2KnotsR[] = {
+	{ 10, 3 }, { 12, 5 }, { 17, 5 }, { 18, 7 }, { 23, 7 }, { 24, 9 }, { 27, 9 }, { 28, 11 },
+	{ 31, 11 }, { 32, 13 }, { 35, 13 }, { 36, 15 }, { 39, 15 }, { 40, 17 }, { 43, 17 }, { 44, 19 },
+	{ 74, 49 }, { 77, 50 }, { 78, 53 }, { 81, 53 }, { 82, 55 }, { 110, 83 }, { 113, 83 }, { 114, 85 },
+	{ 144, 115 }, { 147, 115 }, { 148, 117 }, { 172, 142 }, { 174, 144 }, { 177, 144 }, { 178, 146 },
+	{ 184, 152 }, { 190, 156 }, { 218, 184 }, { 221, 184 }, { 222, 186 }, { 254, 218 }, { 255, 218 }
+};
+constexpr curve_knot_t ledType2KnotsG[] = {
+	{ 10, 3 }, { 12, 5 }, { 17, 5 }, { 18, 7 }, { 23, 7 }, { 24, 9 }, { 27, 9 }, { 28, 11 },
+	{ 31, 11 }, { 32, 13 }, { 35, 13 }, { 36, 15 }, { 39, 15 }, { 40, 17 }, { 43, 17 }, { 44, 19 },
+	{ 78, 53 }, { 84, 57 }, { 100, 74 }, { 106, 80 }, { 133, 80 }, { 134, 108 }, { 138, 112 },
+	{ 141, 113 }, { 142, 116 }, { 145, 117 }, { 146, 119 }, { 150, 124 }, { 154, 127 }, { 156, 131 },
+	{ 159, 132 }, { 160, 135 }, { 184, 159 }, { 187, 160 }, { 188, 163 }, { 216, 191 }, { 220, 197 },
+	{ 223, 198 }, { 224, 201 }, { 234, 212 }, { 238, 218 }, { 254, 234 }, { 255, 234 }
+};
+constexpr curve_knot_t ledType2KnotsB[] = {
+	{ 10, 3 }, { 12, 5 }, { 17, 5 }, { 18, 7 }, { 21, 7 }, { 22, 9 }, { 27, 9 }, { 28, 11 },
+	{ 31, 11 }, { 32, 13 }, { 35, 13 }, { 36, 15 }, { 39, 15 }, { 40, 17 }, { 44, 20 }, { 47, 21 },
+	{ 48, 23 }, { 66, 41 }, { 71, 43 }, { 72, 45 }, { 90, 63 }, { 93, 64 }, { 94, 66 }, { 96, 68 },
+	{ 98, 72 }, { 101, 72 }, { 102, 74 }, { 118, 90 }, { 124, 94 }, { 148, 118 }, { 151, 119 },
+	{ 152, 121 }, { 156, 124 }, { 160, 129 }, { 166, 135 }, { 167, 137 }, { 187, 157 }, { 189, 160 },
+	{ 192, 161 }, { 193, 163 }, { 197, 168 }, { 201, 171 }, { 205, 176 }, { 209, 180 }, { 211, 183 },
+	{ 214, 184 }, { 215, 187 }, { 218, 188 }, { 219, 191 }, { 223, 196 }, { 233, 206 }, { 235, 209 },
+	{ 238, 210 }, { 239, 212 }, { 243, 217 }, { 251, 226 }, { 255, 230 }
+};
+
+#define KNOTS( r, g, b ) { r, g, b }, { sizeof( r ) / sizeof( r[0] ), sizeof( g ) / sizeof( g[0] ), sizeof( b ) / sizeof( b[0] ) }
+
+constexpr led_curve_params_t ledCurveTypes[] = {
+	// LED type 1, 1:1 mapping (neutral)
+	{ 10, 1.0, { 1.0, 1.0, 1.0 }, { NULL, NULL, NULL }, { 0, 0, 0 }, 1 },
+	// LED type 2
+	{ 10, 1.0, { 1.0, 1.0, 1.0 }, KNOTS( ledType2KnotsR, ledType2KnotsG, ledType2KnotsB ), 2 }
+};
+// clang-format on
+
+#undef KNOTS
+
+#define NUM_BRIGHTNESS_CURVES ( (int)( sizeof( ledCurveTypes ) / sizeof( ledCurveTypes[0] ) ) )
+
+// generated tables: values[channel][curve * 256 + input], 8 bit or 8.8 fixed point
+template <size_t N, typename T = uint8_t> struct curve_table_t {
+	T values[3][256 * N];
+};
+
+//---------------------------------------------------------------------------------------
+// constexpr math helpers, only evaluated by the compiler
+//---------------------------------------------------------------------------------------
+constexpr double curveLn( double x ) {
+	// reduce to [0.5...1) and use ln(x) = 2 * atanh((x - 1) / (x + 1))
+	int e = 0;
+	while( x < 0.5 ) {
+		x *= 2.0;
+		e--;
+	}
+	while( x >= 1.0 ) {
+		x *= 0.5;
+		e++;
+	}
+	double y = ( x - 1.0 ) / ( x + 1.0 );
+	double y2 = y * y;
+	double term = y;
+	double sum = 0.0;
+	for( int k = 1; k < 60; k += 2 ) {
+		sum += term / k;
+		term *= y2;
+	}
+	return 2.0 * sum + e * 0.69314718055994530942;
+}
+
+constexpr double curveExp( double x ) {
+	// exp(x) = exp(x / 2^16) ^ (2^16), Taylor series for the small argument
+	double r = x / 65536.0;
+	double term = 1.0;
+	double sum = 1.0;
+	for( int k = 1; k < 12; k++ ) {
+		term *= r / k;
+		sum += term;
+	}
+	for( int k = 0; k < 16; k++ )
+		sum *= sum;
+	return sum;
+}
+
+constexpr double curvePow( double x, double y ) {
+	if( x <= 0.0 )
+		return 0.0;
+	if( y == 1.0 )
+		return x;
+	return curveExp( y * curveLn( x ) );
+}
+
+//---------------------------------------------------------------------------------------
+// curveValue
+//
+// Calculates one entry of a correction curve
+//
+// -> p: LED type parameters
+//    channel: 0...2 for r, g, b
+//    input: uncorrected color value [0...255]
+// <- corrected color value [0...255]
+//---------------------------------------------------------------------------------------
+constexpr uint8_t curveValue( const led_curve_params_t& p, int channel, int input ) {
+	if( input < p.cutoff )
+		return 0;
+
+	// quantize input to the measurement step
+	int step = p.step > 1 ? p.step : 1;
+
+	if( p.knots[channel] ) {
+		const curve_knot_t* k = p.knots[channel];
+		int n = p.knotCount[channel];
+		if( input < k[0].index )
+			return 0;
+		for( int i = 0; i + 1 < n; i++ ) {
+			int a = k[i].index, b = k[i + 1].index;
+			if( input >= a && input < b ) {
+				int q = a + ( input - a ) / step * step;
+				return k[i].value + ( ( k[i + 1].value - k[i].value ) * ( q - a ) * 2 + ( b - a ) ) / ( 2 * ( b - a ) );
+			}
+		}
+		return k[n - 1].value;
+	}
+
+	int q = input / step * step;
+	double v = 255.0 * p.whiteBalance[channel] * curvePow( q / 255.0, p.gamma ) + 0.5;
+	return v >= 255.0 ? 255 : (uint8_t)v;
+}
+
+//---------------------------------------------------------------------------------------
+// curveValue16
+//
+// Same as curveValue() without rounding to 8 bits, used by the 16 bit pipeline (see
+// LED_PIPELINE_16BIT in ledfunctions.h)
+//
+// -> p: LED type parameters
+//    channel: 0...2 for r, g, b
+//    input: uncorrected color value [0...255]
+// <- corrected color value [0...255] in 8.8 fixed point
+//---------------------------------------------------------------------------------------
+constexpr uint16_t curveValue16( const led_curve_params_t& p, int channel, int input ) {
+	if( input < p.cutoff )
+		return 0;
+
+	int step = p.step > 1 ? p.step : 1;
+
+	if( p.knots[channel] ) {
+		const curve_knot_t* k = p.knots[channel];
+		int n = p.knotCount[channel];
+		if( input < k[0].index )
+			return 0;
+		for( int i = 0; i + 1 < n; i++ ) {
+			int a = k[i].index, b = k[i + 1].index;
+			if( input >= a && input < b ) {
+				int q = a + ( input - a ) / step * step;
+				return ( k[i].value << 8 ) +
+				       ( ( k[i + 1].value - k[i].value ) * ( q - a ) * 512 + ( b - a ) ) / ( 2 * ( b - a ) );
+			}
+		}
+		return k[n - 1].value << 8;
+	}
+
+	int q = input / step * step;
+	double v = 65280.0 * p.whiteBalance[channel] * curvePow( q / 255.0, p.gamma ) + 0.5;
+	return v >= 65280.0 ? 65280 : (uint16_t)v;
+}
+
+//---------------------------------------------------------------------------------------
+// generateBrightnessCurves
+//
+// Creates the correction tables for all given LED types
+//
+// -> types: LED type parameters
+// <- table with 256 entries per channel and LED type
+//---------------------------------------------------------------------------------------
+template <size_t N> constexpr curve_table_t<N> generateBrightnessCurves( const led_curve_params_t ( &types )[N] ) {
+	curve_table_t<N> t = {};
+	for( size_t c = 0; c < N; c++ )
+		for( int ch = 0; ch < 3; ch++ )
+			for( int i = 0; i < 256; i++ )
+				t.values[ch][c * 256 + i] = curveValue( types[c], ch, i );
+	return t;
+}
+
+//---------------------------------------------------------------------------------------
+// generateBrightnessCurves16
+//
+// Creates the 8.8 fixed point correction tables for all given LED types
+//
+// -> types: LED type parameters
+// <- table with 256 entries per channel and LED type
+//---------------------------------------------------------------------------------------
+template <size_t N>
+constexpr curve_table_t<N, uint16_t> generateBrightnessCurves16( const led_curve_params_t ( &types )[N] ) {
+	curve_table_t<N, uint16_t> t = {};
+	for( size_t c = 0; c < N; c++ )
+		for( int ch = 0; ch < 3; ch++ )
+			for( int i = 0; i < 256; i++ )
+				t.values[ch][c * 256 + i] = curveValue16( types[c], ch, i );
+	return t;
+}
@@ -0,0 +1,136 @@
+// ESP8266 Wordclock
+// Copyright (C) 2016 Thoralt Franz, https://github.com/thoralt
+// also (C) 2021 by Stefan Rinke, https://github.com/sker65
+//
+//  Combines an ordered stack of layers (e. g. a background effect, the seconds fill,
+//  the time words and the corner minutes) into one frame. Each layer is a color
+//  buffer or a solid color, limited by a pixel range and an index mask, and is
+//  blended with its own alpha and blend mode over the layers below. All layers are
+//  applied in one pass over the pixels, the target may be the color buffer of the
+//  bottom layer.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#include "compositor.h"
+#include "ledfunctions.h"
+
+//---------------------------------------------------------------------------------------
+// add
+//
+// Puts a layer on top of the stack
+//
+// -> layer: layer, colors and mask must stay valid until render()
+// <- false if the stack is full
+//---------------------------------------------------------------------------------------
+bool Compositor::add( const layer_t& layer ) {
+	if( this->count >= MAX_LAYERS )
+		return false;
+	// weight 0...256, so that alpha 255 applies the source completely
+	this->weights[this->count] = layer.alpha + ( layer.alpha >> 7 );
+	this->layers[this->count++] = layer;
+	return true;
+}
+
+// blends one color channel, weight w 0...256
+template <BlendMode MODE> static inline int blendChannel( int d, int s, int w ) {
+	if( MODE == BlendMode::add ) {
+		int v = d + ( ( s * w ) >> 8 );
+		return v > 255 ? 255 : v;
+	}
+	if( MODE == BlendMode::multiply ) {
+		// multiplier faded from 255 (no change) to the source color
+		int m = 255 + ( ( ( s - 255 ) * w ) >> 8 );
+		return ( d * m + 255 ) >> 8;
+	}
+	return d + ( ( ( s - d ) * w ) >> 8 );
+}
+
+template <BlendMode MODE> static inline void blendPixel( int* d, const uint8_t* s, int w ) {
+	d[0] = blendChannel<MODE>( d[0], s[0], w );
+	d[1] = blendChannel<MODE>( d[1], s[1], w );
+	d[2] = blendChannel<MODE>( d[2], s[2], w );
+}
+
+static inline void blendPixel( int* d, const uint8_t* s, uint8_t alpha, BlendMode mode ) {
+	// weight 0...256, so that alpha 255 applies the source completely
+	int w = alpha + ( alpha >> 7 );
+	switch( mode ) {
+	case BlendMode::add:
+		blendPixel<BlendMode::add>( d, s, w );
+		break;
+	case BlendMode::multiply:
+		blendPixel<BlendMode::multiply>( d, s, w );
+		break;
+	default:
+		blendPixel<BlendMode::normal>( d, s, w );
+		break;
+	}
+}
+
+//---------------------------------------------------------------------------------------
+// blend
+//
+// Blends one color over another, alpha 255 gives the full effect of the blend mode
+//
+// -> d: destination color (r, g, b), overwritten with the result
+//    s: source color (r, g, b)
+//    alpha: opacity of the source
+//    mode: normal (s over d), add (saturating d + s) or multiply (d * s)
+// <- --
+//---------------------------------------------------------------------------------------
+void Compositor::blend( uint8_t* d, const uint8_t* s, uint8_t alpha, BlendMode mode ) {
+	int pixel[3] = { d[0], d[1], d[2] };
+	blendPixel( pixel, s, alpha, mode );
+	d[0] = pixel[0];
+	d[1] = pixel[1];
+	d[2] = pixel[2];
+}
+
+//---------------------------------------------------------------------------------------
+// render
+//
+// Composites all layers from bottom to top onto black
+//
+// -> target: color buffer in LED order, may be the colors of a layer
+// <- --
+//---------------------------------------------------------------------------------------
+void Compositor::render( uint8_t* target ) const {
+	for( int i = 0; i < NUM_PIXELS; i++ ) {
+		int ofs = LEDMatrix::getPixelOffset( i );
+		int pixel[3] = { 0, 0, 0 };
+		for( int l = 0; l < this->count; l++ ) {
+			const layer_t& layer = this->layers[l];
+			if( i < layer.first || i >= layer.last )
+				continue;
+			if( layer.mask && layer.mask->get( i ) != layer.maskIndex )
+				continue;
+			const uint8_t* s = layer.colors ? layer.colors + ofs : &layer.color.r;
+			int w = this->weights[l];
+			if( w == 256 && layer.blend == BlendMode::normal ) {
+				// opaque, e. g. the time words
+				pixel[0] = s[0];
+				pixel[1] = s[1];
+				pixel[2] = s[2];
+			} else if( layer.blend == BlendMode::add ) {
+				blendPixel<BlendMode::add>( pixel, s, w );
+			} else if( layer.blend == BlendMode::multiply ) {
+				blendPixel<BlendMode::multiply>( pixel, s, w );
+			} else {
+				blendPixel<BlendMode::normal>( pixel, s, w );
+			}
+		}
+		target[ofs + 0] = pixel[0];
+		target[ofs + 1] = pixel[1];
+		target[ofs + 2] = pixel[2];
+	}
+}
@@ -0,0 +1,58 @@
+// ESP8266 Wordclock
+// Copyright (C) 2016 Thoralt Franz, https://github.com/thoralt
+// also (C) 2021 by Stefan Rinke, https://github.com/sker65
+//
+//  See compositor.cpp for description.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#pragma once
+
+#include <stdint.h>
+
+#include "config.h"
+#include "packedbuffer.h"
+
+// upper limit of layers in one frame
+#define MAX_LAYERS 8
+
+enum class BlendMode : uint8_t { normal, add, multiply };
+
+typedef struct _layer_t {
+	// colors in LED order (like LEDMatrix::currentValues), NULL for the solid color
+	const uint8_t* colors;
+	palette_entry color;
+	// with a mask, the layer covers only the pixels whose mask value is maskIndex,
+	// e. g. the palette indexes of LEDMatrix::renderTime()
+	const PackedBuffer<2>* mask;
+	uint8_t maskIndex;
+	// logical pixels first...last - 1 covered by the layer
+	uint8_t first, last;
+	// opacity 0...255
+	uint8_t alpha;
+	BlendMode blend;
+} layer_t;
+
+class Compositor {
+public:
+	void clear() { this->count = 0; }
+	bool add( const layer_t& layer );
+	void render( uint8_t* target ) const;
+
+	static void blend( uint8_t* d, const uint8_t* s, uint8_t alpha, BlendMode mode );
+
+private:
+	layer_t layers[MAX_LAYERS];
+	uint16_t weights[MAX_LAYERS];
+	uint8_t count = 0;
+};
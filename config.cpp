@@ -107,6 +107,17 @@ void ConfigClass::save() {
 	this->config->autoOffMin = this->autoOffMin;
 	this->config->tmpl = this->tmpl;
 	this->config->fillMode = this->fillMode;
+	this->config->fadeTime = this->fadeTime;
+	this->config->fadeEasing = this->fadeEasing;
+	this->config->plasmaSpeed = this->plasmaSpeed;
+	this->config->matrixCount = this->matrixCount;
+	this->config->matrixDensity = this->matrixDensity;
+	this->config->background = this->background;
+	this->config->backgroundLevel = this->backgroundLevel;
+	this->config->crossfadeTime = this->crossfadeTime;
+	this->config->ditherBrightness = this->ditherBrightness;
+	this->config->ledOutput = this->ledOutput <= MAX_LED_OUTPUT ? this->ledOutput : DEFAULT_LED_OUTPUT;
+	this->config->powerLimit = this->powerLimit;
 
 	for( int i = 0; i < EEPROM_SIZE; i++ )
 		EEPROM.write( i, this->eeprom_data[i] );
@@ -160,6 +171,17 @@ void ConfigClass::reset() {
 	this->config->autoOffMin = this->autoOffMin = 0;
 	this->config->tmpl = this->tmpl = 0;
 	this->config->fillMode = this->fillMode = 0;
+	this->config->fadeTime = this->fadeTime = DEFAULT_FADE_TIME;
+	this->config->fadeEasing = this->fadeEasing = DEFAULT_FADE_EASING;
+	this->config->plasmaSpeed = this->plasmaSpeed = DEFAULT_PLASMA_SPEED;
+	this->config->matrixCount = this->matrixCount = DEFAULT_MATRIX_COUNT;
+	this->config->matrixDensity = this->matrixDensity = DEFAULT_MATRIX_DENSITY;
+	this->config->background = this->background = 0;
+	this->config->backgroundLevel = this->backgroundLevel = DEFAULT_BACKGROUND_LEVEL;
+	this->config->crossfadeTime = this->crossfadeTime = DEFAULT_CROSSFADE_TIME;
+	this->config->ditherBrightness = this->ditherBrightness = DEFAULT_DITHER_BRIGHTNESS;
+	this->config->ledOutput = this->ledOutput = DEFAULT_LED_OUTPUT;
+	this->config->powerLimit = this->powerLimit = DEFAULT_POWER_LIMIT;
 }
 
 //---------------------------------------------------------------------------------------
@@ -200,4 +222,29 @@ void ConfigClass::load() {
 	this->autoOffMin = this->config->autoOffMin;
 	this->tmpl = this->config->tmpl;
 	this->fillMode = this->config->fillMode;
+
+	// fade settings were added later, EEPROM written by older versions contains garbage
+	this->fadeTime = this->config->fadeTime <= MAX_FADE_TIME ? this->config->fadeTime : DEFAULT_FADE_TIME;
+	this->fadeEasing = this->config->fadeEasing <= MAX_FADE_EASING ? this->config->fadeEasing : DEFAULT_FADE_EASING;
+	this->plasmaSpeed = this->config->plasmaSpeed >= MIN_PLASMA_SPEED && this->config->plasmaSpeed <= MAX_PLASMA_SPEED
+	                        ? this->config->plasmaSpeed
+	                        : DEFAULT_PLASMA_SPEED;
+	this->matrixCount = this->config->matrixCount >= 1 && this->config->matrixCount <= MAX_MATRIX_COUNT
+	                        ? this->config->matrixCount
+	                        : DEFAULT_MATRIX_COUNT;
+	this->matrixDensity =
+	    this->config->matrixDensity >= MIN_MATRIX_DENSITY && this->config->matrixDensity <= MAX_MATRIX_DENSITY
+	        ? this->config->matrixDensity
+	        : DEFAULT_MATRIX_DENSITY;
+	this->background = this->config->background <= MAX_BACKGROUND ? this->config->background : 0;
+	this->backgroundLevel = this->config->backgroundLevel;
+	this->crossfadeTime =
+	    this->config->crossfadeTime <= MAX_FADE_TIME ? this->config->crossfadeTime : DEFAULT_CROSSFADE_TIME;
+	this->ditherBrightness = this->config->ditherBrightness <= MAX_DITHER_BRIGHTNESS ? this->config->ditherBrightness
+	                                                                                 : DEFAULT_DITHER_BRIGHTNESS;
+	this->ledOutput = this->config->ledOutput <= MAX_LED_OUTPUT ? this->config->ledOutput : DEFAULT_LED_OUTPUT;
+	this->powerLimit = this->config->powerLimit == 0 || ( this->config->powerLimit >= MIN_POWER_LIMIT &&
+	                                                      this->config->powerLimit <= MAX_POWER_LIMIT )
+	                       ? this->config->powerLimit
+	                       : DEFAULT_POWER_LIMIT;
 }
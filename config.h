@@ -22,6 +22,36 @@
 
 #define NUM_PIXELS 114
 #define HOURGLASS_ANIMATION_FRAMES 8
+#define DEFAULT_FADE_TIME 1000
+#define MAX_FADE_TIME 10000
+// FadeEasing::easeOut
+#define DEFAULT_FADE_EASING 2
+#define MAX_FADE_EASING 3
+#define DEFAULT_PLASMA_SPEED 100
+#define MIN_PLASMA_SPEED 10
+#define MAX_PLASMA_SPEED 250
+#define DEFAULT_MATRIX_COUNT 25
+// see MAX_MATRIX_OBJECTS
+#define MAX_MATRIX_COUNT 64
+#define DEFAULT_MATRIX_DENSITY 100
+#define MIN_MATRIX_DENSITY 25
+#define MAX_MATRIX_DENSITY 250
+// none, matrix, fire, plasma, stars, see TimeEffect::getBackgroundMode()
+#define MAX_BACKGROUND 4
+#define DEFAULT_BACKGROUND_LEVEL 128
+#define DEFAULT_CROSSFADE_TIME 1000
+// global brightness 0...256 below which the output is dithered, 0 = never
+#define DEFAULT_DITHER_BRIGHTNESS 128
+#define MAX_DITHER_BRIGHTNESS 256
+// LED output backend: DMA, UART1, bit bang, see LedOutputMethod. The recorder of the
+// host build is only set by the tests and never saved.
+#define DEFAULT_LED_OUTPUT 0
+#define MAX_LED_OUTPUT 2
+// current budget of the LEDs in mA, 0 = no limit, see PowerLimiter. Must stay well
+// above the idle current of the LEDs, smaller budgets would only leave black frames.
+#define DEFAULT_POWER_LIMIT 0
+#define MIN_POWER_LIMIT 500
+#define MAX_POWER_LIMIT 10000
 
 // structure to encapsulate a color value with red, green and blue values
 typedef struct _palette_entry {
@@ -49,6 +79,17 @@ typedef struct _config_struct {
 	uint8_t autoOffMin;
 	uint8_t tmpl;
 	uint8_t fillMode;
+	uint16_t fadeTime;
+	uint8_t fadeEasing;
+	uint8_t plasmaSpeed;
+	uint8_t matrixCount;
+	uint8_t matrixDensity;
+	uint8_t background;
+	uint8_t backgroundLevel;
+	uint16_t crossfadeTime;
+	uint16_t ditherBrightness;
+	uint8_t ledOutput;
+	uint16_t powerLimit;
 } config_struct;
 
 #define EEPROM_SIZE 512
@@ -108,6 +149,29 @@ public:
 	uint8_t autoOffMin;
 	uint8_t tmpl;
 	uint8_t fillMode;
+	// duration in ms and easing (see FadeEasing) of the fade display mode
+	uint16_t fadeTime = DEFAULT_FADE_TIME;
+	uint8_t fadeEasing = DEFAULT_FADE_EASING;
+	// animation speed of the plasma display mode in percent
+	uint8_t plasmaSpeed = DEFAULT_PLASMA_SPEED;
+	// number of trails and their density in percent of the matrix display mode
+	uint8_t matrixCount = DEFAULT_MATRIX_COUNT;
+	uint8_t matrixDensity = DEFAULT_MATRIX_DENSITY;
+	// effect behind the time of the plain and fade display modes (0 = none) and its
+	// opacity 0...255
+	uint8_t background = 0;
+	uint8_t backgroundLevel = DEFAULT_BACKGROUND_LEVEL;
+	// duration in ms of the crossfade between display modes (0 = switch immediately),
+	// shaped by fadeEasing
+	uint16_t crossfadeTime = DEFAULT_CROSSFADE_TIME;
+	// the output is dithered over consecutive frames while the global brightness is
+	// below this value, see LEDMatrix::show()
+	uint16_t ditherBrightness = DEFAULT_DITHER_BRIGHTNESS;
+	// output backend of the LEDs (LedOutputMethod), switched by LEDMatrix::process()
+	uint8_t ledOutput = DEFAULT_LED_OUTPUT;
+	// frames estimated to draw more than this current (mA) are dimmed, 0 = no limit,
+	// see LEDMatrix::show()
+	uint16_t powerLimit = DEFAULT_POWER_LIMIT;
 
 	bool debugMode = false;
 	int delayedWriteTimer = 0;
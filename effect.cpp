@@ -0,0 +1,66 @@
+// ESP8266 Wordclock
+// Copyright (C) 2016 Thoralt Franz, https://github.com/thoralt
+// also (C) 2021 by Stefan Rinke, https://github.com/sker65
+//
+//  Every display mode is an Effect registered in effectTable[] (see effects.cpp)
+//  with its frame period and whether it animates time changes. Only the effect of
+//  the active mode exists: it is constructed in the fixed size EffectArena when the
+//  mode is selected and destroyed when another mode takes over, so the state of a
+//  mode costs RAM only while it is shown and a new mode does not grow LEDMatrix.
+//  The time effects hold a smaller arena of their own for a background effect.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#include "effect.h"
+
+//---------------------------------------------------------------------------------------
+// select
+//
+// Returns the effect of the given mode, replaces the current effect if it belongs to
+// another mode
+//
+// -> m: display mode
+//    led: passed to Effect::begin() and Effect::end()
+// <- active effect, NULL if the effect of the mode does not fit into the slot
+//---------------------------------------------------------------------------------------
+Effect* EffectSlot::select( DisplayMode m, LEDMatrix& led ) {
+	if( this->effect && m == this->mode )
+		return this->effect;
+
+	this->release( led );
+	const effect_info_t& info = getEffectInfo( m );
+	if( info.size > this->size )
+		return nullptr;
+	this->effect = info.create( this->memory );
+	this->mode = m;
+	this->effect->begin( led );
+	return this->effect;
+}
+
+//---------------------------------------------------------------------------------------
+// release
+//
+// Ends and destroys the current effect, the arena is empty afterwards
+//
+// -> led: passed to Effect::end()
+// <- --
+//---------------------------------------------------------------------------------------
+void EffectSlot::release( LEDMatrix& led ) {
+	if( !this->effect )
+		return;
+
+	this->effect->end( led );
+	this->effect->~Effect();
+	this->effect = nullptr;
+	this->mode = DisplayMode::invalid;
+}
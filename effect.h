@@ -0,0 +1,97 @@
+// ESP8266 Wordclock
+// Copyright (C) 2016 Thoralt Franz, https://github.com/thoralt
+// also (C) 2021 by Stefan Rinke, https://github.com/sker65
+//
+//  See effect.cpp for description.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#pragma once
+
+#include <stdint.h>
+
+#include "config.h"
+
+// memory for the state of the active effect, must hold the largest effect (checked
+// in effects.cpp)
+#define EFFECT_ARENA_SIZE 2320
+// memory for the background effect behind the time, must hold the largest effect
+// registered as background
+#define BACKGROUND_ARENA_SIZE 1040
+
+class LEDMatrix;
+
+// time and transition information passed to every frame
+typedef struct _effect_frame_t {
+	int h, m, s, ms;
+	int year, month, day;
+	// the displayed time has changed (or a transition was forced by setMode()), the
+	// time displayed before
+	bool timeChanged;
+	int lastH, lastM;
+} effect_frame_t;
+
+class Effect {
+public:
+	virtual ~Effect() {}
+	// called once after construction in the arena and before destruction
+	virtual void begin( LEDMatrix& led ) {}
+	virtual void end( LEDMatrix& led ) {}
+	// renders one frame into LEDMatrix::currentValues, usually through LEDMatrix::set()
+	virtual void render( LEDMatrix& led, const effect_frame_t& frame ) = 0;
+};
+
+// registration of a display mode, see effectTable[] in effects.cpp
+typedef struct _effect_info_t {
+	// constructs the effect in the given memory of at least size bytes
+	Effect* ( *create )( void* memory );
+	uint16_t size;
+	// frame period in milliseconds the effect is designed for
+	uint8_t framePeriod;
+	// the effect animates the change of the displayed time
+	bool hasTransition;
+	// the effect fills the whole screen and can be shown behind the time
+	bool isBackground;
+	// milliseconds between two simulation steps, the frames in between are interpolated
+	// (see frameinterpolator.cpp), 0 renders every frame
+	uint8_t simulationPeriod;
+} effect_info_t;
+
+const effect_info_t& getEffectInfo( DisplayMode m );
+
+// holds at most one effect in memory provided by EffectArena
+class EffectSlot {
+public:
+	Effect* select( DisplayMode m, LEDMatrix& led );
+	void release( LEDMatrix& led );
+	Effect* current() { return this->effect; }
+	DisplayMode currentMode() { return this->mode; }
+
+protected:
+	EffectSlot( uint8_t* memory, uint16_t size ) : memory( memory ), size( size ) {}
+
+private:
+	uint8_t* memory;
+	uint16_t size;
+	Effect* effect = nullptr;
+	DisplayMode mode = DisplayMode::invalid;
+};
+
+template <int SIZE> class EffectArena : public EffectSlot {
+public:
+	EffectArena() : EffectSlot( storage, SIZE ) {}
+	EffectArena( const EffectArena& ) = delete;
+
+private:
+	uint8_t storage[SIZE] __attribute__( ( aligned( 8 ) ) );
+};
@@ -0,0 +1,1144 @@
+// ESP8266 Wordclock
+// Copyright (C) 2016 Thoralt Franz, https://github.com/thoralt
+// also (C) 2021 by Stefan Rinke, https://github.com/sker65
+//
+//  The display modes as effects (see effect.cpp): the time with and without fading,
+//  the transitions (flying letters, explosion, snake), the screen savers (matrix,
+//  stars, heart, fire, plasma, moon) and the status screens. effectTable[] at the
+//  end registers one effect per DisplayMode.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#include <new>
+
+#include "effects.h"
+#include "ledfunctions.h"
+
+#include "hourglass_animation.h"
+
+//---------------------------------------------------------------------------------------
+// TimeEffect
+//---------------------------------------------------------------------------------------
+
+// display modes selectable as background, index is Config.background
+static const DisplayMode backgroundModes[MAX_BACKGROUND + 1] = { DisplayMode::invalid, DisplayMode::matrix,
+	                                                              DisplayMode::fire, DisplayMode::plasma,
+	                                                              DisplayMode::stars };
+
+//---------------------------------------------------------------------------------------
+// getBackgroundMode
+//
+// Looks up the effect shown behind the time
+//
+// -> background: Config.background
+// <- display mode of the background effect, DisplayMode::invalid for none
+//---------------------------------------------------------------------------------------
+DisplayMode TimeEffect::getBackgroundMode( int background ) {
+	if( background <= 0 || background > MAX_BACKGROUND )
+		return DisplayMode::invalid;
+	return backgroundModes[background];
+}
+
+//---------------------------------------------------------------------------------------
+// end
+//
+// Ends the background effect
+//
+// -> led: passed to Effect::end() of the background effect
+// <- --
+//---------------------------------------------------------------------------------------
+void TimeEffect::end( LEDMatrix& led ) { this->background.release( led ); }
+
+//---------------------------------------------------------------------------------------
+// compose
+//
+// Puts the time on top of the background effect in led.currentValues: background
+// color, background effect dimmed to Config.backgroundLevel, seconds fill, time words
+// and corner minutes
+//
+// -> led: target, currentValues holds the frame of the background effect
+//    time: palette indexes of the time, see LEDMatrix::renderTime()
+//    palette: colors of the time
+// <- --
+//---------------------------------------------------------------------------------------
+void TimeEffect::compose( LEDMatrix& led, const PackedBuffer<2>& time, const palette_entry palette[] ) {
+	const uint8_t words = LEDMatrix::width * LEDMatrix::height;
+	uint8_t level = Config.backgroundLevel;
+	const palette_entry& bg = palette[0];
+	Compositor layers;
+	if( level < 255 && bg.r == 0 && bg.g == 0 && bg.b == 0 ) {
+		// dimming over black is a plain scale of the whole buffer, same weight as the
+		// compositor uses
+		fbScale( led.currentValues, led.currentValues, sizeof( led.currentValues ), level + ( level >> 7 ) );
+		level = 255;
+	}
+	if( level < 255 )
+		layers.add( { nullptr, bg, nullptr, 0, 0, NUM_PIXELS, 255, BlendMode::normal } );
+	layers.add( { led.currentValues, bg, nullptr, 0, 0, NUM_PIXELS, level, BlendMode::normal } );
+	layers.add( { nullptr, palette[2], &time, 2, 0, NUM_PIXELS, 255, BlendMode::add } );
+	layers.add( { nullptr, palette[1], &time, 1, 0, words, 255, BlendMode::normal } );
+	layers.add( { nullptr, palette[1], &time, 1, words, NUM_PIXELS, 255, BlendMode::normal } );
+	layers.render( led.currentValues );
+}
+
+//---------------------------------------------------------------------------------------
+// render
+//
+// Renders the current time, either over the background effect, immediately or faded
+// from the colors shown
+//
+// -> led: target
+//    frame: current time
+// <- --
+//---------------------------------------------------------------------------------------
+void TimeEffect::render( LEDMatrix& led, const effect_frame_t& frame ) {
+	PackedBuffer<2> buf;
+	palette_entry palette[3];
+	led.preparePalette( palette );
+
+	Effect* background = nullptr;
+	DisplayMode backgroundMode = TimeEffect::getBackgroundMode( Config.background );
+	if( led.isDisplayOn() && getEffectInfo( backgroundMode ).isBackground )
+		background = this->background.select( backgroundMode, led );
+	else
+		this->background.release( led );
+
+	led.renderTime( buf, frame.h, frame.m, frame.s, frame.ms );
+	if( background ) {
+		// the background effect renders into led.currentValues, the time is composited
+		// on top in place, so fading does not apply
+		led.renderEffect( background, backgroundMode, frame );
+		this->compose( led, buf, palette );
+	} else if( this->fading ) {
+		led.set( buf, palette, false );
+		led.fade();
+	} else {
+		led.set( buf, palette, true );
+	}
+}
+
+//---------------------------------------------------------------------------------------
+// FlyingLettersEffect
+//---------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------
+// prepare
+//
+// Sets the current buffer as target state for flying letters, initializes current
+// positions of the letters below the visible area with some random jitter
+//
+// -> source: buffer to read the currently active LEDs from
+//    frame: current time, for debug output
+// <- --
+//---------------------------------------------------------------------------------------
+void FlyingLettersEffect::prepare( const PackedBuffer<2>& source, const effect_frame_t& frame ) {
+	// transfer the previous flying letters in the leaving letters vector to prepare for
+	// outgoing animation
+	this->leavingCount = 0;
+	for( int i = 0; i < this->arrivingCount; i++ ) {
+		xy_t& p = this->arrivingLetters[i];
+		// delay every letter depending on its position
+		// and set new target coordinate
+		if( this->up ) {
+			p.delay = p.y * 2 + p.x + 1 + random( 5 );
+			p.yTarget = -1;
+		} else {
+			p.delay = ( LEDMatrix::height - p.y - 1 ) * 2 + p.x + 1 + random( 5 );
+			p.yTarget = LEDMatrix::height;
+		}
+		this->leavingLetters[this->leavingCount++] = p;
+	}
+
+	// initialize arriving letters from scratch
+	this->arrivingCount = 0;
+	int ofs = 0;
+
+	// iterate over every position in the screen buffer
+	for( int y = 0; y < LEDMatrix::height; y++ ) {
+		for( int x = 0; x < LEDMatrix::width; x++ ) {
+			// create entry in arrivingLetters if current pixel is foreground
+			if( source.get( ofs++ ) == 1 && this->arrivingCount < MAX_FLYING_LETTERS ) {
+				if( this->up ) {
+					xy_t p = { x, y, x, LEDMatrix::height, y * 2 + x + 1 + (int)random( 5 ), 200, 0 };
+					this->arrivingLetters[this->arrivingCount++] = p;
+				} else {
+					xy_t p = { x, y, x, -1, ( LEDMatrix::height - y - 1 ) * 2 + x + 1 + (int)random( 5 ), 200, 0 };
+					this->arrivingLetters[this->arrivingCount++] = p;
+				}
+			}
+		}
+	}
+
+	// DEBUG
+	Serial.printf( "h=%i, m=%i, s=%i, lastH=%i, lastM=%i\r\n", frame.h, frame.m, frame.s, frame.lastH, frame.lastM );
+	Serial.println( "leavingLetters:" );
+	for( int i = 0; i < this->leavingCount; i++ ) {
+		xy_t& p = this->leavingLetters[i];
+		Serial.printf( "  counter=%i, delay=%i, speed=%i, x=%i, y=%i, xTarget=%i, yTarget=%i\r\n", p.counter, p.delay,
+		               p.speed, p.x, p.y, p.xTarget, p.yTarget );
+	}
+	Serial.println( "arrivingLetters:" );
+	for( int i = 0; i < this->arrivingCount; i++ ) {
+		xy_t& p = this->arrivingLetters[i];
+		Serial.printf( "  counter=%i, delay=%i, speed=%i, x=%i, y=%i, xTarget=%i, yTarget=%i\r\n", p.counter, p.delay,
+		               p.speed, p.x, p.y, p.xTarget, p.yTarget );
+	}
+}
+
+//---------------------------------------------------------------------------------------
+// render
+//
+// Takes the current arrivingLetters and leavingLetters to render the flying letters
+// animation
+//
+// -> led: target
+//    frame: current time, a time change starts a new animation
+// <- --
+//---------------------------------------------------------------------------------------
+void FlyingLettersEffect::render( LEDMatrix& led, const effect_frame_t& frame ) {
+	PackedBuffer<2> buf;
+
+	palette_entry palette[3];
+	led.preparePalette( palette );
+
+	// check if the displayed time has changed
+	if( frame.timeChanged ) {
+		// prepare new animation
+		led.renderTime( buf, frame.h, frame.m, frame.s, frame.ms );
+		this->prepare( buf, frame );
+	}
+
+	// create empty buffer filled with seconds color
+	led.fillBackground( frame.s, frame.ms, buf );
+
+	led.renderCorner( buf, frame.m );
+
+	// leaving letters animation has priority
+	if( this->leavingCount > 0 ) {
+		// count actually moved letters to detect end of animation
+		int movedLetters = 0;
+
+		// iterate over all leavingLetters
+		for( int i = 0; i < this->leavingCount; i++ ) {
+			xy_t& p = this->leavingLetters[i];
+			// draw letter only if inside visible area
+			if( p.x >= 0 && p.y >= 0 && p.x < LEDMatrix::width && p.y < LEDMatrix::height )
+				buf.set( p.x + p.y * LEDMatrix::width, 1 );
+
+			// continue with next letter if the current letter already
+			// reached its target position
+			if( p.y == p.yTarget && p.x == p.xTarget )
+				continue;
+			p.counter += p.speed;
+			movedLetters++;
+			if( p.counter >= 1000 ) {
+				p.counter -= 1000;
+				if( p.delay > 0 ) {
+					// do not move if animation of current letter is delayed
+					p.delay--;
+				} else {
+					if( p.y > p.yTarget )
+						p.y--;
+					else
+						p.y++;
+				}
+			}
+		}
+		if( movedLetters == 0 )
+			this->leavingCount = 0;
+	} else {
+		// iterate over all arrivingLetters
+		for( int i = 0; i < this->arrivingCount; i++ ) {
+			xy_t& p = this->arrivingLetters[i];
+			// draw letter only if inside visible area
+			if( p.x >= 0 && p.y >= 0 && p.x < LEDMatrix::width && p.y < LEDMatrix::height )
+				buf.set( p.x + p.y * LEDMatrix::width, 1 );
+
+			// continue with next letter if the current letter already
+			// reached its target position
+			if( p.y == p.yTarget && p.x == p.xTarget )
+				continue;
+			p.counter += p.speed;
+			if( p.counter >= 1000 ) {
+				p.counter -= 1000;
+				if( p.delay > 0 ) {
+					// do not move if animation of current letter is delayed
+					p.delay--;
+				} else {
+					if( p.y > p.yTarget )
+						p.y--;
+					else
+						p.y++;
+				}
+			}
+		}
+	}
+
+	// present the current content immediately without fading
+	led.set( buf, palette, true );
+}
+
+//---------------------------------------------------------------------------------------
+// ExplosionEffect
+//---------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------
+// prepare
+//
+// Prepare particles based on current screen state
+//
+// -> source: buffer to read the currently active LEDs from
+// <- --
+//---------------------------------------------------------------------------------------
+void ExplosionEffect::prepare( const PackedBuffer<2>& source ) {
+	int ofs = 0;
+	Serial.printf( "prepare explosion ... \n\r" );
+
+	// iterate over every position in the screen buffer
+	for( int y = 0; y < LEDMatrix::height; y++ ) {
+		for( int x = 0; x < LEDMatrix::width; x++ ) {
+			// explode the current pixel if it is foreground, add a random delay of
+			// zero to approx. 3 seconds to each explosion
+			if( source.get( ofs++ ) == 1 )
+				this->particles.addExplosion( x, y, random( 300 ) );
+		}
+	}
+}
+
+//---------------------------------------------------------------------------------------
+// render
+//
+// Renders the exploding letters animation
+//
+// -> led: target
+//    frame: current time, a time change explodes the time displayed before
+// <- --
+//---------------------------------------------------------------------------------------
+void ExplosionEffect::render( LEDMatrix& led, const effect_frame_t& frame ) {
+	PackedBuffer<2> buf;
+
+	palette_entry palette[3];
+	led.preparePalette( palette );
+
+	// check if the displayed time has changed
+	if( frame.timeChanged ) {
+		// prepare new animation with old time
+		led.renderTime( buf, frame.lastH, frame.lastM, 0, 0 );
+		this->prepare( buf );
+	}
+
+	// create empty buffer filled with seconds color
+	led.fillBackground( frame.s, frame.ms, buf );
+
+	led.renderCorner( buf, frame.lastM );
+
+	// Do we have something to explode?
+	if( this->particles.count() > 0 ) {
+		// transfer background created by fillBackground to target buffer
+		led.set( buf, palette, true );
+		// move and render all particles
+		this->particles.render( led.currentValues, palette[1] );
+	} else {
+		// present the current time in boring mode with simple fading
+		led.renderTime( buf, frame.h, frame.m, frame.s, frame.ms );
+		led.set( buf, palette, false );
+		led.fade();
+	}
+}
+
+//---------------------------------------------------------------------------------------
+// SnakeEffect
+//---------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------
+// render
+//
+// Renders the snake animation, the snake eats the time displayed before line by line
+// and leaves the current time behind
+//
+// -> led: target
+//    frame: current time, a time change starts a new snake
+// <- --
+//---------------------------------------------------------------------------------------
+void SnakeEffect::render( LEDMatrix& led, const effect_frame_t& frame ) {
+	const int width = LEDMatrix::width;
+	const int height = LEDMatrix::height;
+	PackedBuffer<4> buf;
+	PackedBuffer<4> act;
+	palette_entry palette[5]; // 4/5. color for snake
+	led.preparePalette( palette );
+
+	palette[3] = { 255, 0, 0 };
+	palette[4] = { 0, 255, 0 };
+
+	if( frame.timeChanged ) {
+		// prepare new animation with old time
+		led.renderTime( this->previous, frame.lastH, frame.lastM, 0, 0 );
+		snakeX = 0;
+		snakeY = 0;
+		snakeDX = 1;
+		snakeHead = 0;
+		snakeTail = 0;
+		snake[snakeHead++] = 0;
+		snakeTicker = snakeSpeed;
+		Serial.printf( "prepare snake ... \n\r" );
+	}
+
+	// create empty buffer filled with seconds color
+	led.fillBackground( frame.s, frame.ms, buf );
+	led.fillBackground( frame.s, frame.ms, act );
+
+	led.renderCorner( buf, frame.lastM );
+
+	led.renderTime( act, frame.h, frame.m, frame.s, frame.ms );
+
+	// animate
+	int len = snakeHead > snakeTail ? snakeHead - snakeTail : snakeTail - snakeHead;
+	if( snakeY < height || len > 0 ) { // animate until the tail has vanished
+		if( snakeTicker <= 0 ) {
+			snakeTicker = snakeSpeed;
+
+			if( snakeY < height ) { // move
+				// check if there is someting in current line
+				int hit = 0;
+				for( int x = 0; x < width; x++ ) {
+					if( this->previous.get( x + snakeY * width ) == 1 || act.get( x + snakeY * width ) == 1 ) {
+						hit = 1;
+						break;
+					}
+				}
+				if( hit )
+					snakeX += snakeDX;
+				else
+					snakeY++;
+				if( snakeX < 0 || snakeX > width - 1 ) {
+					snakeY++;
+					snakeDX = snakeDX == 1 ? -1 : 1;
+					snakeX += snakeDX;
+				}
+				Serial.printf( "snake moved x=%i, y=%i\n\r", snakeX, snakeY );
+				snake[snakeHead++] = snakeY * width + snakeX;
+			}
+			int len = snakeHead > snakeTail ? snakeHead - snakeTail : snakeTail - snakeHead;
+			if( len > 8 || snakeY >= height )
+				snakeTail++;
+			if( snakeHead == SNAKE_LEN )
+				snakeHead = 0;
+			if( snakeTail == SNAKE_LEN )
+				snakeTail = 0;
+		} else {
+			snakeTicker--;
+		}
+		// the current time above the snake and behind its head, the previous time below
+		// and in front of it
+		if( snakeY >= height ) {
+			buf.copy( act, 0, width * height );
+		} else if( snakeDX == 1 ) { // rennt rechts
+			int head = snakeY * width + snakeX;
+			buf.copy( act, 0, head );
+			buf.copy( this->previous, head, width * height );
+		} else {
+			int row = snakeY * width;
+			int head = row + snakeX + 1;
+			buf.copy( act, 0, row );
+			buf.copy( this->previous, row, head );
+			buf.copy( act, head, row + width );
+			buf.copy( this->previous, row + width, width * height );
+		}
+		uint8_t t = snakeTail;
+		while( t != snakeHead ) {
+			buf.set( snake[t], 4 );
+			t++;
+			if( t == SNAKE_LEN )
+				t = 0;
+		}
+		if( snakeY * width + snakeX < width * height )
+			buf.set( snakeY * width + snakeX, 3 );
+		led.set( buf, palette, true );
+	} else {
+		led.renderTime( buf, frame.h, frame.m, frame.s, frame.ms );
+		led.set( buf, palette, true );
+		led.fade();
+	}
+}
+
+//---------------------------------------------------------------------------------------
+// MatrixEffect
+//---------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------
+// render
+//
+// Renders one frame of the matrix animation and displays it immediately
+//
+// -> led: target
+//    frame: --
+// <- --
+//---------------------------------------------------------------------------------------
+void MatrixEffect::render( LEDMatrix& led, const effect_frame_t& frame ) {
+	static_assert( MAX_MATRIX_COUNT <= MAX_MATRIX_OBJECTS, "matrix objects" );
+	uint8_t levels[LEDMatrix::width * LEDMatrix::height];
+
+	// clear buffers
+	memset( levels, 0, sizeof( levels ) );
+	fbClear( led.currentValues, sizeof( led.currentValues ) );
+
+	// move the active matrix objects and combine their trails, then convert to colors
+	for( int i = 0; i < Config.matrixCount; i++ )
+		this->matrix[i].render( levels, Config.matrixDensity );
+	MatrixObject::resolve( levels, led.currentValues );
+}
+
+//---------------------------------------------------------------------------------------
+// StarsEffect
+//---------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------
+// begin
+//
+// Sets random coordinates with minimum distance to the other stars
+//
+// -> led: --
+// <- --
+//---------------------------------------------------------------------------------------
+void StarsEffect::begin( LEDMatrix& led ) {
+	for( StarObject& s : this->stars )
+		s.randomize( this->grid );
+}
+
+//---------------------------------------------------------------------------------------
+// render
+//
+// Renders one step of the stars animation and displays it immediately
+//
+// -> led: target
+//    frame: --
+// <- --
+//---------------------------------------------------------------------------------------
+void StarsEffect::render( LEDMatrix& led, const effect_frame_t& frame ) {
+	static_assert( STAR_GRID_WIDTH == LEDMatrix::width && STAR_GRID_HEIGHT == LEDMatrix::height, "star grid size" );
+	// clear buffer
+	fbClear( led.currentValues, sizeof( led.currentValues ) );
+
+	for( StarObject& s : this->stars )
+		s.render( led.currentValues, this->grid );
+}
+
+//---------------------------------------------------------------------------------------
+// HeartEffect
+//---------------------------------------------------------------------------------------
+
+// clang-format off
+static const uint8_t PROGMEM __attribute__( ( aligned( 4 ) ) ) heartImage[NUM_PIXELS_ALIGNED] = {
+	0, 1, 1, 1, 0, 0, 0, 1, 1, 1, 0,
+	1, 1, 1, 1, 1, 0, 1, 1, 1, 1, 1,
+	1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+	1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+	0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0,
+	0, 0, 1, 1, 1, 1, 1, 1, 1, 0, 0,
+	0, 0, 0, 1, 1, 1, 1, 1, 0, 0, 0,
+	0, 0, 0, 0, 1, 1, 1, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	1, 1, 1, 1
+};
+// clang-format on
+
+//---------------------------------------------------------------------------------------
+// render
+//
+// Renders one step of the heart animation and displays it immediately, the brightness
+// changes as much as in HEART_STEP_MS / 10 frames of 10 ms
+//
+// -> led: target
+//    frame: --
+// <- --
+//---------------------------------------------------------------------------------------
+void HeartEffect::render( LEDMatrix& led, const effect_frame_t& frame ) {
+	palette_entry palette[2];
+	palette[0] = { 0, 0, 0 };
+	palette[1] = { (uint8_t)this->brightness, 0, 0 };
+	led.set( heartImage, palette, true );
+
+	switch( this->state ) {
+	case 0:
+		if( this->brightness >= 255 )
+			this->state = 1;
+		else
+			this->brightness += 32 * HEART_STEP_MS / 10;
+		break;
+
+	case 1:
+		if( this->brightness < 128 )
+			this->state = 2;
+		else
+			this->brightness -= 32 * HEART_STEP_MS / 10;
+		break;
+
+	case 2:
+		if( this->brightness >= 255 )
+			this->state = 3;
+		else
+			this->brightness += 32 * HEART_STEP_MS / 10;
+		break;
+
+	case 3:
+	default:
+		if( this->brightness <= 0 )
+			this->state = 0;
+		else
+			this->brightness -= 4 * HEART_STEP_MS / 10;
+		break;
+	}
+
+	if( this->brightness > 255 )
+		this->brightness = 255;
+	if( this->brightness < 0 )
+		this->brightness = 0;
+}
+
+//---------------------------------------------------------------------------------------
+// FireEffect, PlasmaEffect
+//---------------------------------------------------------------------------------------
+
+// clang-format off
+static const palette_entry firePalette[256] = {
+	{0, 0, 0}, {4, 0, 0}, {8, 0, 0}, {12, 0, 0}, {16, 0, 0}, {20, 0, 0}, {24, 0, 0}, {28, 0, 0},
+	{32, 0, 0}, {36, 0, 0}, {40, 0, 0}, {44, 0, 0}, {48, 0, 0}, {52, 0, 0}, {56, 0, 0}, {60, 0, 0},
+	{64, 0, 0}, {68, 0, 0}, {72, 0, 0}, {76, 0, 0}, {80, 0, 0}, {85, 0, 0}, {89, 0, 0}, {93, 0, 0},
+	{97, 0, 0}, {101, 0, 0}, {105, 0, 0}, {109, 0, 0}, {113, 0, 0}, {117, 0, 0}, {121, 0, 0}, {125, 0, 0},
+	{129, 0, 0}, {133, 0, 0}, {137, 0, 0}, {141, 0, 0}, {145, 0, 0}, {149, 0, 0}, {153, 0, 0}, {157, 0, 0},
+	{161, 0, 0}, {165, 0, 0}, {170, 0, 0}, {174, 0, 0}, {178, 0, 0}, {182, 0, 0}, {186, 0, 0}, {190, 0, 0},
+	{194, 0, 0}, {198, 0, 0}, {202, 0, 0}, {206, 0, 0}, {210, 0, 0}, {214, 0, 0}, {218, 0, 0}, {222, 0, 0},
+	{226, 0, 0}, {230, 0, 0}, {234, 0, 0}, {238, 0, 0}, {242, 0, 0}, {246, 0, 0}, {250, 0, 0}, {255, 0, 0},
+	{255, 0, 0}, {255, 8, 0}, {255, 16, 0}, {255, 24, 0}, {255, 32, 0}, {255, 41, 0}, {255, 49, 0}, {255, 57, 0},
+	{255, 65, 0}, {255, 74, 0}, {255, 82, 0}, {255, 90, 0}, {255, 98, 0}, {255, 106, 0}, {255, 115, 0}, {255, 123, 0},
+	{255, 131, 0}, {255, 139, 0}, {255, 148, 0}, {255, 156, 0}, {255, 164, 0}, {255, 172, 0}, {255, 180, 0}, {255, 189, 0},
+	{255, 197, 0}, {255, 205, 0}, {255, 213, 0}, {255, 222, 0}, {255, 230, 0}, {255, 238, 0}, {255, 246, 0}, {255, 255, 0},
+	{255, 255, 0}, {255, 255, 1}, {255, 255, 3}, {255, 255, 4}, {255, 255, 6}, {255, 255, 8}, {255, 255, 9}, {255, 255, 11},
+	{255, 255, 12}, {255, 255, 14}, {255, 255, 16}, {255, 255, 17}, {255, 255, 19}, {255, 255, 20}, {255, 255, 22}, {255, 255, 24},
+	{255, 255, 25}, {255, 255, 27}, {255, 255, 28}, {255, 255, 30}, {255, 255, 32}, {255, 255, 33}, {255, 255, 35}, {255, 255, 36},
+	{255, 255, 38}, {255, 255, 40}, {255, 255, 41}, {255, 255, 43}, {255, 255, 44}, {255, 255, 46}, {255, 255, 48}, {255, 255, 49},
+	{255, 255, 51}, {255, 255, 52}, {255, 255, 54}, {255, 255, 56}, {255, 255, 57}, {255, 255, 59}, {255, 255, 60}, {255, 255, 62},
+	{255, 255, 64}, {255, 255, 65}, {255, 255, 67}, {255, 255, 68}, {255, 255, 70}, {255, 255, 72}, {255, 255, 73}, {255, 255, 75},
+	{255, 255, 76}, {255, 255, 78}, {255, 255, 80}, {255, 255, 81}, {255, 255, 83}, {255, 255, 85}, {255, 255, 86}, {255, 255, 88},
+	{255, 255, 89}, {255, 255, 91}, {255, 255, 93}, {255, 255, 94}, {255, 255, 96}, {255, 255, 97}, {255, 255, 99}, {255, 255, 101},
+	{255, 255, 102}, {255, 255, 104}, {255, 255, 105}, {255, 255, 107}, {255, 255, 109}, {255, 255, 110}, {255, 255, 112}, {255, 255, 113},
+	{255, 255, 115}, {255, 255, 117}, {255, 255, 118}, {255, 255, 120}, {255, 255, 121}, {255, 255, 123}, {255, 255, 125}, {255, 255, 126},
+	{255, 255, 128}, {255, 255, 129}, {255, 255, 131}, {255, 255, 133}, {255, 255, 134}, {255, 255, 136}, {255, 255, 137}, {255, 255, 139},
+	{255, 255, 141}, {255, 255, 142}, {255, 255, 144}, {255, 255, 145}, {255, 255, 147}, {255, 255, 149}, {255, 255, 150}, {255, 255, 152},
+	{255, 255, 153}, {255, 255, 155}, {255, 255, 157}, {255, 255, 158}, {255, 255, 160}, {255, 255, 161}, {255, 255, 163}, {255, 255, 165},
+	{255, 255, 166}, {255, 255, 168}, {255, 255, 170}, {255, 255, 171}, {255, 255, 173}, {255, 255, 174}, {255, 255, 176}, {255, 255, 178},
+	{255, 255, 179}, {255, 255, 181}, {255, 255, 182}, {255, 255, 184}, {255, 255, 186}, {255, 255, 187}, {255, 255, 189}, {255, 255, 190},
+	{255, 255, 192}, {255, 255, 194}, {255, 255, 195}, {255, 255, 197}, {255, 255, 198}, {255, 255, 200}, {255, 255, 202}, {255, 255, 203},
+	{255, 255, 205}, {255, 255, 206}, {255, 255, 208}, {255, 255, 210}, {255, 255, 211}, {255, 255, 213}, {255, 255, 214}, {255, 255, 216},
+	{255, 255, 218}, {255, 255, 219}, {255, 255, 221}, {255, 255, 222}, {255, 255, 224}, {255, 255, 226}, {255, 255, 227}, {255, 255, 229},
+	{255, 255, 230}, {255, 255, 232}, {255, 255, 234}, {255, 255, 235}, {255, 255, 237}, {255, 255, 238}, {255, 255, 240}, {255, 255, 242},
+	{255, 255, 243}, {255, 255, 245}, {255, 255, 246}, {255, 255, 248}, {255, 255, 250}, {255, 255, 251}, {255, 255, 253}, {255, 255, 255}
+};
+static const palette_entry plasmaPalette[256] = {
+	{255, 0, 0}, {255, 6, 0}, {255, 12, 0}, {255, 18, 0}, {255, 24, 0}, {255, 30, 0}, {255, 36, 0}, {255, 42, 0},
+	{255, 48, 0}, {255, 54, 0}, {255, 60, 0}, {255, 66, 0}, {255, 72, 0}, {255, 78, 0}, {255, 84, 0}, {255, 90, 0},
+	{255, 96, 0}, {255, 102, 0}, {255, 108, 0}, {255, 114, 0}, {255, 120, 0}, {255, 126, 0}, {255, 131, 0}, {255, 137, 0},
+	{255, 143, 0}, {255, 149, 0}, {255, 155, 0}, {255, 161, 0}, {255, 167, 0}, {255, 173, 0}, {255, 179, 0}, {255, 185, 0},
+	{255, 191, 0}, {255, 197, 0}, {255, 203, 0}, {255, 209, 0}, {255, 215, 0}, {255, 221, 0}, {255, 227, 0}, {255, 233, 0},
+	{255, 239, 0}, {255, 245, 0}, {255, 251, 0}, {253, 255, 0}, {247, 255, 0}, {241, 255, 0}, {235, 255, 0}, {229, 255, 0},
+	{223, 255, 0}, {217, 255, 0}, {211, 255, 0}, {205, 255, 0}, {199, 255, 0}, {193, 255, 0}, {187, 255, 0}, {181, 255, 0},
+	{175, 255, 0}, {169, 255, 0}, {163, 255, 0}, {157, 255, 0}, {151, 255, 0}, {145, 255, 0}, {139, 255, 0}, {133, 255, 0},
+	{128, 255, 0}, {122, 255, 0}, {116, 255, 0}, {110, 255, 0}, {104, 255, 0}, {98, 255, 0}, {92, 255, 0}, {86, 255, 0},
+	{80, 255, 0}, {74, 255, 0}, {68, 255, 0}, {62, 255, 0}, {56, 255, 0}, {50, 255, 0}, {44, 255, 0}, {38, 255, 0},
+	{32, 255, 0}, {26, 255, 0}, {20, 255, 0}, {14, 255, 0}, {8, 255, 0}, {2, 255, 0}, {0, 255, 4}, {0, 255, 10},
+	{0, 255, 16}, {0, 255, 22}, {0, 255, 28}, {0, 255, 34}, {0, 255, 40}, {0, 255, 46}, {0, 255, 52}, {0, 255, 58},
+	{0, 255, 64}, {0, 255, 70}, {0, 255, 76}, {0, 255, 82}, {0, 255, 88}, {0, 255, 94}, {0, 255, 100}, {0, 255, 106},
+	{0, 255, 112}, {0, 255, 118}, {0, 255, 124}, {0, 255, 129}, {0, 255, 135}, {0, 255, 141}, {0, 255, 147}, {0, 255, 153},
+	{0, 255, 159}, {0, 255, 165}, {0, 255, 171}, {0, 255, 177}, {0, 255, 183}, {0, 255, 189}, {0, 255, 195}, {0, 255, 201},
+	{0, 255, 207}, {0, 255, 213}, {0, 255, 219}, {0, 255, 225}, {0, 255, 231}, {0, 255, 237}, {0, 255, 243}, {0, 255, 249},
+	{0, 255, 255}, {0, 249, 255}, {0, 243, 255}, {0, 237, 255}, {0, 231, 255}, {0, 225, 255}, {0, 219, 255}, {0, 213, 255},
+	{0, 207, 255}, {0, 201, 255}, {0, 195, 255}, {0, 189, 255}, {0, 183, 255}, {0, 177, 255}, {0, 171, 255}, {0, 165, 255},
+	{0, 159, 255}, {0, 153, 255}, {0, 147, 255}, {0, 141, 255}, {0, 135, 255}, {0, 129, 255}, {0, 124, 255}, {0, 118, 255},
+	{0, 112, 255}, {0, 106, 255}, {0, 100, 255}, {0, 94, 255}, {0, 88, 255}, {0, 82, 255}, {0, 76, 255}, {0, 70, 255},
+	{0, 64, 255}, {0, 58, 255}, {0, 52, 255}, {0, 46, 255}, {0, 40, 255}, {0, 34, 255}, {0, 28, 255}, {0, 22, 255},
+	{0, 16, 255}, {0, 10, 255}, {0, 4, 255}, {2, 0, 255}, {8, 0, 255}, {14, 0, 255}, {20, 0, 255}, {26, 0, 255},
+	{32, 0, 255}, {38, 0, 255}, {44, 0, 255}, {50, 0, 255}, {56, 0, 255}, {62, 0, 255}, {68, 0, 255}, {74, 0, 255},
+	{80, 0, 255}, {86, 0, 255}, {92, 0, 255}, {98, 0, 255}, {104, 0, 255}, {110, 0, 255}, {116, 0, 255}, {122, 0, 255},
+	{128, 0, 255}, {133, 0, 255}, {139, 0, 255}, {145, 0, 255}, {151, 0, 255}, {157, 0, 255}, {163, 0, 255}, {169, 0, 255},
+	{175, 0, 255}, {181, 0, 255}, {187, 0, 255}, {193, 0, 255}, {199, 0, 255}, {205, 0, 255}, {211, 0, 255}, {217, 0, 255},
+	{223, 0, 255}, {229, 0, 255}, {235, 0, 255}, {241, 0, 255}, {247, 0, 255}, {253, 0, 255}, {255, 0, 251}, {255, 0, 245},
+	{255, 0, 239}, {255, 0, 233}, {255, 0, 227}, {255, 0, 221}, {255, 0, 215}, {255, 0, 209}, {255, 0, 203}, {255, 0, 197},
+	{255, 0, 191}, {255, 0, 185}, {255, 0, 179}, {255, 0, 173}, {255, 0, 167}, {255, 0, 161}, {255, 0, 155}, {255, 0, 149},
+	{255, 0, 143}, {255, 0, 137}, {255, 0, 131}, {255, 0, 126}, {255, 0, 120}, {255, 0, 114}, {255, 0, 108}, {255, 0, 102},
+	{255, 0, 96}, {255, 0, 90}, {255, 0, 84}, {255, 0, 78}, {255, 0, 72}, {255, 0, 66}, {255, 0, 60}, {255, 0, 54},
+	{255, 0, 48}, {255, 0, 42}, {255, 0, 36}, {255, 0, 30}, {255, 0, 24}, {255, 0, 18}, {255, 0, 12}, {255, 0, 6}
+};
+// clang-format on
+
+//---------------------------------------------------------------------------------------
+// begin
+//
+// Starts the simulation clock
+//
+// -> led: --
+// <- --
+//---------------------------------------------------------------------------------------
+void FireEffect::begin( LEDMatrix& led ) { this->stepMillis = millis(); }
+
+//---------------------------------------------------------------------------------------
+// render
+//
+// Renders the fire animation, the simulation advances every FIRE_STEP_MS (see
+// fire.cpp) independent of the frame rate
+//
+// -> led: target
+//    frame: --
+// <- --
+//---------------------------------------------------------------------------------------
+void FireEffect::render( LEDMatrix& led, const effect_frame_t& frame ) {
+	static_assert( FIRE_WIDTH == LEDMatrix::width && FIRE_HEIGHT == LEDMatrix::height, "fire buffer size" );
+	advanceFire( this->heat, this->rng, this->stepMillis, millis() );
+	led.set( this->heat, (palette_entry*)firePalette, true );
+}
+
+//---------------------------------------------------------------------------------------
+// begin
+//
+// Starts the animation clock
+//
+// -> led: --
+// <- --
+//---------------------------------------------------------------------------------------
+void PlasmaEffect::begin( LEDMatrix& led ) { this->lastMillis = millis(); }
+
+//---------------------------------------------------------------------------------------
+// render
+//
+// Renders one frame of the plasma animation, see plasma.cpp. The animation time
+// advances with the elapsed milliseconds scaled by Config.plasmaSpeed.
+//
+// -> led: target
+//    frame: --
+// <- --
+//---------------------------------------------------------------------------------------
+void PlasmaEffect::render( LEDMatrix& led, const effect_frame_t& frame ) {
+	uint32_t now = millis();
+	this->time = advancePlasmaTime( this->time, now - this->lastMillis, Config.plasmaSpeed );
+	this->lastMillis = now;
+
+	renderPlasmaFrame( this->buf, LEDMatrix::width, LEDMatrix::height, this->time );
+	led.set( this->buf, (palette_entry*)plasmaPalette, true );
+}
+
+//---------------------------------------------------------------------------------------
+// MoonEffect
+//---------------------------------------------------------------------------------------
+
+// clang-format off
+static const uint32_t moonphases[8][10] = {
+	  {
+				  0b0000111000000000,
+				  0b0011000110000000,
+				  0b0100000001000000,
+				  0b0100000001000000,
+				  0b1000000000100000,
+				  0b1000000000100000,
+				  0b0100000001000000,
+				  0b0100000001000000,
+				  0b0011000110000000,
+				  0b0000111000000000
+	  },
+		{
+				  0b0000111000000000,
+				  0b0000001110000000,
+				  0b0000000111000000,
+				  0b0000000111000000,
+				  0b0000000111100000,
+				  0b0000000111100000,
+				  0b0000000111000000,
+				  0b0000000111000000,
+				  0b0000001110000000,
+				  0b0000111000000000
+	  },
+		{
+				  0b0000011000000000,
+				  0b0000011110000000,
+				  0b0000011111000000,
+				  0b0000011111000000,
+				  0b0000011111100000,
+				  0b0000011111100000,
+				  0b0000011111000000,
+				  0b0000011111000000,
+				  0b0000011110000000,
+				  0b0000011000000000
+	  },
+		{
+				  0b0000111000000000,
+				  0b0001111110000000,
+				  0b0001111111000000,
+				  0b0001111111000000,
+				  0b0001111111100000,
+				  0b0001111111100000,
+				  0b0001111111000000,
+				  0b0001111111000000,
+				  0b0001111110000000,
+				  0b0000111000000000
+	  },
+		{
+				  0b0000111000000000,
+				  0b0011111110000000,
+				  0b0111111111000000,
+				  0b0111111111000000,
+				  0b1111111111100000,
+				  0b1111111111100000,
+				  0b0111111111000000,
+				  0b0111111111000000,
+				  0b0011111110000000,
+				  0b0000111000000000
+	  },
+		{
+				  0b0000111000000000,
+				  0b0011111100000000,
+				  0b0111111100000000,
+				  0b0111111100000000,
+				  0b1111111100000000,
+				  0b1111111100000000,
+				  0b0111111100000000,
+				  0b0111111100000000,
+				  0b0011111100000000,
+				  0b0000111000000000
+	  },
+		{
+				  0b0000110000000000,
+				  0b0011110000000000,
+				  0b0111110000000000,
+				  0b0111110000000000,
+				  0b1111110000000000,
+				  0b1111110000000000,
+				  0b0111110000000000,
+				  0b0111110000000000,
+				  0b0011110000000000,
+				  0b0000110000000000
+	  },
+		{
+				  0b0000111000000000,
+				  0b0011100000000000,
+				  0b0111000000000000,
+				  0b0111000000000000,
+				  0b1111000000000000,
+				  0b1111000000000000,
+				  0b0111000000000000,
+				  0b0111000000000000,
+				  0b0011100000000000,
+				  0b0000111000000000
+				
+		}
+};
+// clang-format on
+
+int MoonEffect::getMoonphase( int y, int m, int d ) {
+	int b, c, e;
+	double jd;
+	if( m < 3 ) {
+		y--;
+		m += 12;
+	}
+	++m;
+	c = 365.25 * y;
+	e = 30.6 * m;
+	jd = c + e + d - 694039.09; // jd is total days elapsed
+	jd /= 29.53;                // divide by the moon cycle (29.53 days)
+	b = jd;                     // int(jd) -> b, take integer part of jd
+	jd -= b;                    // subtract integer part to leave fractional part of original jd
+	b = jd * 8 + 0.5;           // scale fraction from 0-8 and round by adding 0.5
+	b = b & 7;                  // 0 and 8 are the same so turn 8 into 0
+	return b;
+}
+
+//---------------------------------------------------------------------------------------
+// render
+//
+// Renders the current moon phase on the seconds background
+//
+// -> led: target
+//    frame: current date and time
+// <- --
+//---------------------------------------------------------------------------------------
+void MoonEffect::render( LEDMatrix& led, const effect_frame_t& frame ) {
+	const int width = LEDMatrix::width;
+	PackedBuffer<2> buf;
+	palette_entry palette[3];
+	led.preparePalette( palette );
+	palette[1] = { 255, 255, 255 };
+	int phase = getMoonphase( frame.year, frame.month, frame.day );
+	led.fillBackground( frame.s, frame.ms, buf );
+
+	for( int i = 0; i < LEDMatrix::height; i++ ) {
+		uint32_t pattern = moonphases[phase][i];
+		for( int j = 0; j < width; j++ ) {
+			if( pattern & ( 1 << ( 15 - j ) ) )
+				buf.set( i * width + j, 1 );
+		}
+	}
+	led.set( buf, palette, true );
+}
+
+//---------------------------------------------------------------------------------------
+// HourglassEffect
+//---------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------
+// render
+//
+// Immediately displays the animation step Config.hourglassState of the hourglass
+// animation.
+// ATTENTION: Animation frames must start at 32 bit boundary each!
+//
+// -> led: target
+//    frame: --
+// <- --
+//---------------------------------------------------------------------------------------
+void HourglassEffect::render( LEDMatrix& led, const effect_frame_t& frame ) {
+	// colors in palette: black, white, yellow
+	palette_entry p[] = { { 0, 0, 0 }, { 255, 255, 255 }, { 255, 255, 0 }, { 255, 255, 0 } };
+
+	// delete red component in palette entry 3 to make this color green (used in the
+	// second half of the hourglass animation to indicate the short wait-for-OTA window)
+	if( this->green )
+		p[3].r = 0;
+
+	uint8_t animationStep = Config.hourglassState;
+	if( animationStep >= HOURGLASS_ANIMATION_FRAMES )
+		animationStep = 0;
+	led.set( hourglass_animation[animationStep], p, true );
+}
+
+//---------------------------------------------------------------------------------------
+// UpdateEffect, ImageEffect
+//---------------------------------------------------------------------------------------
+
+// clang-format off
+static const uint8_t PROGMEM __attribute__( ( aligned( 4 ) ) ) fullImage[NUM_PIXELS_ALIGNED] = {
+	1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+	1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+	1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+	1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+	1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+	1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+	1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+	1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+	1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+	1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+	1, 1, 1, 1
+};
+
+static const uint8_t PROGMEM __attribute__( ( aligned( 4 ) ) ) updateImage[NUM_PIXELS_ALIGNED] = {
+	0, 0, 0, 1, 1, 1, 1, 1, 0, 0, 0,
+	0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0,
+	0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0,
+	0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0,
+	0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0,
+	0, 1, 1, 1, 0, 0, 0, 1, 1, 1, 0,
+	0, 0, 1, 0, 0, 0, 0, 0, 1, 0, 0,
+	0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0,
+	0, 0, 0, 0, 1, 0, 1, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0,
+	1, 1, 1, 1
+};
+
+static const uint8_t PROGMEM __attribute__( ( aligned( 4 ) ) ) updateCompleteImage[NUM_PIXELS_ALIGNED] = {
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0,
+	0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0,
+	0, 0, 0, 1, 0, 1, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	1, 1, 1, 1
+};
+
+static const uint8_t PROGMEM __attribute__( ( aligned( 4 ) ) ) updateErrorImage[NUM_PIXELS_ALIGNED] = {
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0,
+	0, 0, 0, 0, 1, 0, 1, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 1, 0, 1, 0, 0, 0, 0,
+	0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	1, 1, 1, 1
+};
+
+static const uint8_t PROGMEM __attribute__( ( aligned( 4 ) ) ) wifiManagerImage[NUM_PIXELS_ALIGNED] = {
+	0, 0, 0, 1, 1, 1, 1, 0, 0, 0, 0,
+	0, 0, 1, 1, 0, 0, 1, 1, 0, 0, 0,
+	0, 0, 1, 1, 0, 0, 1, 1, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 1, 1, 0, 0, 0,
+	0, 0, 0, 0, 0, 1, 1, 0, 0, 0, 0,
+	0, 0, 0, 0, 1, 1, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 1, 1, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 1, 1, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 1, 1, 0, 0, 0, 0, 0,
+	1, 1, 1, 1
+};
+// clang-format on
+
+//---------------------------------------------------------------------------------------
+// render
+//
+// Renders the OTA update screen with progress information depending on
+// Config.updateProgress
+//
+// -> led: target
+//    frame: --
+// <- --
+//---------------------------------------------------------------------------------------
+void UpdateEffect::render( LEDMatrix& led, const effect_frame_t& frame ) {
+	PackedBuffer<2> update;
+	palette_entry p[] = { { 0, 0, 0 }, { 255, 0, 0 }, { 42, 21, 0 }, { 255, 85, 0 } };
+	for( int i = 0; i < NUM_PIXELS; i++ ) {
+		uint8_t index = pgm_read_byte( &updateImage[i] );
+		if( i < 110 && i < Config.updateProgress )
+			index = index == 0 ? 2 : 3;
+		update.set( i, index );
+	}
+	led.set( update, p, true );
+}
+
+//---------------------------------------------------------------------------------------
+// render
+//
+// Renders the image
+//
+// -> led: target
+//    frame: --
+// <- --
+//---------------------------------------------------------------------------------------
+void ImageEffect::render( LEDMatrix& led, const effect_frame_t& frame ) { led.set( this->image, this->palette, true ); }
+
+//---------------------------------------------------------------------------------------
+// registration
+//---------------------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------------------
+// construct
+//
+// Constructs an effect in the arena memory
+//
+// -> memory: EFFECT_ARENA_SIZE bytes, aligned at 8 bytes
+//    args: constructor arguments
+// <- the effect
+//---------------------------------------------------------------------------------------
+template <class T, typename... A> static Effect* construct( void* memory, A... args ) {
+	static_assert( sizeof( T ) <= EFFECT_ARENA_SIZE, "effect arena too small" );
+	static_assert( alignof( T ) <= 8, "effect arena alignment" );
+	return new( memory ) T( args... );
+}
+
+// the background effects must fit into the arena of TimeEffect
+static_assert( sizeof( MatrixEffect ) <= BACKGROUND_ARENA_SIZE && sizeof( FireEffect ) <= BACKGROUND_ARENA_SIZE &&
+                   sizeof( PlasmaEffect ) <= BACKGROUND_ARENA_SIZE && sizeof( StarsEffect ) <= BACKGROUND_ARENA_SIZE,
+               "background arena too small" );
+
+// one entry per DisplayMode, in enum order
+static const effect_info_t effectTable[] = {
+	// plain
+	{ []( void* m ) { return construct<TimeEffect>( m, false ); }, sizeof( TimeEffect ),
+	  DEFAULT_FRAME_PERIOD, false, false, 0 },
+	// fade
+	{ []( void* m ) { return construct<TimeEffect>( m, true ); }, sizeof( TimeEffect ),
+	  DEFAULT_FRAME_PERIOD, false, false, 0 },
+	// flyingLettersVerticalUp
+	{ []( void* m ) { return construct<FlyingLettersEffect>( m, true ); }, sizeof( FlyingLettersEffect ),
+	  DEFAULT_FRAME_PERIOD, true, false, 0 },
+	// flyingLettersVerticalDown
+	{ []( void* m ) { return construct<FlyingLettersEffect>( m, false ); }, sizeof( FlyingLettersEffect ),
+	  DEFAULT_FRAME_PERIOD, true, false, 0 },
+	// explode
+	{ []( void* m ) { return construct<ExplosionEffect>( m ); }, sizeof( ExplosionEffect ),
+	  DEFAULT_FRAME_PERIOD, true, false, 0 },
+	// random, only a placeholder, LEDMatrix::setMode() picks one of LEDMatrix::randomModes[]
+	{ []( void* m ) { return construct<TimeEffect>( m, false ); }, sizeof( TimeEffect ),
+	  DEFAULT_FRAME_PERIOD, false, false, 0 },
+	// matrix
+	{ []( void* m ) { return construct<MatrixEffect>( m ); }, sizeof( MatrixEffect ),
+	  DEFAULT_FRAME_PERIOD, false, true, 0 },
+	// heart, interpolated between the steps of the beat
+	{ []( void* m ) { return construct<HeartEffect>( m ); }, sizeof( HeartEffect ), DEFAULT_FRAME_PERIOD, false, false,
+	  HEART_STEP_MS },
+	// fire, interpolated between the simulation steps
+	{ []( void* m ) { return construct<FireEffect>( m ); }, sizeof( FireEffect ), DEFAULT_FRAME_PERIOD, false, true,
+	  FIRE_STEP_MS },
+	// plasma
+	{ []( void* m ) { return construct<PlasmaEffect>( m ); }, sizeof( PlasmaEffect ),
+	  DEFAULT_FRAME_PERIOD, false, true, 0 },
+	// stars, interpolated between the brightness steps
+	{ []( void* m ) { return construct<StarsEffect>( m ); }, sizeof( StarsEffect ), DEFAULT_FRAME_PERIOD, false, true,
+	  STAR_STEP_MS },
+	// snake
+	{ []( void* m ) { return construct<SnakeEffect>( m ); }, sizeof( SnakeEffect ),
+	  DEFAULT_FRAME_PERIOD, true, false, 0 },
+	// moon
+	{ []( void* m ) { return construct<MoonEffect>( m ); }, sizeof( MoonEffect ), DEFAULT_FRAME_PERIOD, false, false, 0 },
+	// red, green, blue for testing purposes
+	{ []( void* m ) { return construct<ImageEffect>( m, fullImage, palette_entry{ 0, 0, 0 }, palette_entry{ 32, 0, 0 } ); },
+	  sizeof( ImageEffect ), DEFAULT_FRAME_PERIOD, false, false, 0 },
+	{ []( void* m ) { return construct<ImageEffect>( m, fullImage, palette_entry{ 0, 0, 0 }, palette_entry{ 0, 32, 0 } ); },
+	  sizeof( ImageEffect ), DEFAULT_FRAME_PERIOD, false, false, 0 },
+	{ []( void* m ) { return construct<ImageEffect>( m, fullImage, palette_entry{ 0, 0, 0 }, palette_entry{ 0, 0, 32 } ); },
+	  sizeof( ImageEffect ), DEFAULT_FRAME_PERIOD, false, false, 0 },
+	// yellowHourglass, animation advances every 100 ms
+	{ []( void* m ) { return construct<HourglassEffect>( m, false ); }, sizeof( HourglassEffect ), 100, false, false, 0 },
+	// greenHourglass
+	{ []( void* m ) { return construct<HourglassEffect>( m, true ); }, sizeof( HourglassEffect ), 100, false, false, 0 },
+	// update
+	{ []( void* m ) { return construct<UpdateEffect>( m ); }, sizeof( UpdateEffect ),
+	  DEFAULT_FRAME_PERIOD, false, false, 0 },
+	// updateComplete
+	{ []( void* m ) {
+		 return construct<ImageEffect>( m, updateCompleteImage, palette_entry{ 0, 21, 0 }, palette_entry{ 0, 255, 0 } );
+	 },
+	  sizeof( ImageEffect ), DEFAULT_FRAME_PERIOD, false, false, 0 },
+	// updateError
+	{ []( void* m ) {
+		 return construct<ImageEffect>( m, updateErrorImage, palette_entry{ 0, 0, 0 }, palette_entry{ 255, 0, 0 } );
+	 },
+	  sizeof( ImageEffect ), DEFAULT_FRAME_PERIOD, false, false, 0 },
+	// wifiManager
+	{ []( void* m ) {
+		 return construct<ImageEffect>( m, wifiManagerImage, palette_entry{ 0, 0, 0 }, palette_entry{ 255, 255, 0 } );
+	 },
+	  sizeof( ImageEffect ), DEFAULT_FRAME_PERIOD, false, false, 0 },
+	// invalid
+	{ []( void* m ) { return construct<TimeEffect>( m, false ); }, sizeof( TimeEffect ),
+	  DEFAULT_FRAME_PERIOD, false, false, 0 }
+};
+
+//---------------------------------------------------------------------------------------
+// getEffectInfo
+//
+// Looks up the registration of a display mode
+//
+// -> m: display mode
+// <- entry in effectTable[], the one of DisplayMode::invalid for unknown modes
+//---------------------------------------------------------------------------------------
+const effect_info_t& getEffectInfo( DisplayMode m ) {
+	static_assert( sizeof( effectTable ) / sizeof( effectTable[0] ) == (int)DisplayMode::invalid + 1,
+	               "one effect per DisplayMode" );
+	if( (unsigned)m > (unsigned)DisplayMode::invalid )
+		m = DisplayMode::invalid;
+	return effectTable[(int)m];
+}
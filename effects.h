@@ -0,0 +1,185 @@
+// ESP8266 Wordclock
+// Copyright (C) 2016 Thoralt Franz, https://github.com/thoralt
+// also (C) 2021 by Stefan Rinke, https://github.com/sker65
+//
+//  See effects.cpp for description.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#pragma once
+
+#include <stdint.h>
+
+#include "compositor.h"
+#include "config.h"
+#include "effect.h"
+#include "matrixobject.h"
+#include "packedbuffer.h"
+#include "particlepool.h"
+#include "starobject.h"
+
+#define NUM_STARS 20
+// upper limit of lit pixels in a time text, see the check in effects.cpp
+#define MAX_FLYING_LETTERS 24
+#define SNAKE_LEN 20
+
+typedef struct _xy_t {
+	int xTarget, yTarget, x, y, delay, speed, counter;
+} xy_t;
+
+// current time, faded to the target if fading is set, or composited over the
+// background effect selected by Config.background
+class TimeEffect : public Effect {
+public:
+	TimeEffect( bool fading ) : fading( fading ) {}
+	void end( LEDMatrix& led ) override;
+	void render( LEDMatrix& led, const effect_frame_t& frame ) override;
+
+	static DisplayMode getBackgroundMode( int background );
+
+private:
+	void compose( LEDMatrix& led, const PackedBuffer<2>& time, const palette_entry palette[] );
+
+	bool fading;
+	EffectArena<BACKGROUND_ARENA_SIZE> background;
+};
+
+class FlyingLettersEffect : public Effect {
+public:
+	FlyingLettersEffect( bool up ) : up( up ) {}
+	void render( LEDMatrix& led, const effect_frame_t& frame ) override;
+
+private:
+	void prepare( const PackedBuffer<2>& source, const effect_frame_t& frame );
+
+	bool up;
+	xy_t arrivingLetters[MAX_FLYING_LETTERS];
+	xy_t leavingLetters[MAX_FLYING_LETTERS];
+	uint8_t arrivingCount = 0;
+	uint8_t leavingCount = 0;
+};
+
+class ExplosionEffect : public Effect {
+public:
+	void render( LEDMatrix& led, const effect_frame_t& frame ) override;
+
+private:
+	void prepare( const PackedBuffer<2>& source );
+
+	ParticlePool particles;
+};
+
+class SnakeEffect : public Effect {
+public:
+	void render( LEDMatrix& led, const effect_frame_t& frame ) override;
+
+private:
+	// time displayed before the transition
+	PackedBuffer<4> previous = {};
+	uint8_t snakeX = 0;
+	uint8_t snakeY = 0;
+	uint8_t snake[SNAKE_LEN + 1];
+	uint8_t snakeHead = 0;
+	uint8_t snakeTail = 0;
+	int snakeDX = 1;
+	int snakeTicker = 0;
+	int snakeSpeed = 10;
+};
+
+class MatrixEffect : public Effect {
+public:
+	void render( LEDMatrix& led, const effect_frame_t& frame ) override;
+
+private:
+	MatrixObject matrix[MAX_MATRIX_OBJECTS];
+};
+
+class StarsEffect : public Effect {
+public:
+	void begin( LEDMatrix& led ) override;
+	void render( LEDMatrix& led, const effect_frame_t& frame ) override;
+
+private:
+	StarObject stars[NUM_STARS];
+	StarGrid grid;
+};
+
+// one step of the beat per HEART_STEP_MS, the frames in between are interpolated
+#define HEART_STEP_MS 40
+
+class HeartEffect : public Effect {
+public:
+	void render( LEDMatrix& led, const effect_frame_t& frame ) override;
+
+private:
+	int brightness = 0;
+	int state = 0;
+};
+
+class FireEffect : public Effect {
+public:
+	void begin( LEDMatrix& led ) override;
+	void render( LEDMatrix& led, const effect_frame_t& frame ) override;
+
+private:
+	uint8_t heat[NUM_PIXELS] __attribute__( ( aligned( 4 ) ) ) = {};
+	// xorshift32 state and time of the last simulation step, see fire.cpp
+	uint32_t rng = 0x2545F491;
+	uint32_t stepMillis = 0;
+};
+
+class PlasmaEffect : public Effect {
+public:
+	void begin( LEDMatrix& led ) override;
+	void render( LEDMatrix& led, const effect_frame_t& frame ) override;
+
+private:
+	uint8_t buf[NUM_PIXELS] __attribute__( ( aligned( 4 ) ) ) = {};
+	// animation time in 16.16, see plasma.cpp
+	uint32_t time = 0;
+	uint32_t lastMillis = 0;
+};
+
+class MoonEffect : public Effect {
+public:
+	void render( LEDMatrix& led, const effect_frame_t& frame ) override;
+
+private:
+	static int getMoonphase( int y, int m, int d );
+};
+
+class HourglassEffect : public Effect {
+public:
+	HourglassEffect( bool green ) : green( green ) {}
+	void render( LEDMatrix& led, const effect_frame_t& frame ) override;
+
+private:
+	bool green;
+};
+
+class UpdateEffect : public Effect {
+public:
+	void render( LEDMatrix& led, const effect_frame_t& frame ) override;
+};
+
+// static picture with up to two colors, i. e. test colors and status screens
+class ImageEffect : public Effect {
+public:
+	ImageEffect( const uint8_t* image, palette_entry background, palette_entry foreground )
+	    : image( image ), palette{ background, foreground } {}
+	void render( LEDMatrix& led, const effect_frame_t& frame ) override;
+
+private:
+	const uint8_t* image;
+	palette_entry palette[2];
+};
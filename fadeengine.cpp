@@ -0,0 +1,73 @@
+// ESP8266 Wordclock
+// Copyright (C) 2016 Thoralt Franz, https://github.com/thoralt
+// also (C) 2021 by Stefan Rinke, https://github.com/sker65
+//
+//  Time based fading of color buffers. A fade runs from a snapshot of the current
+//  colors to the target colors within a given duration, the progress is derived from
+//  elapsed milliseconds and shaped by an easing function, so the fade speed does not
+//  depend on how often loop() runs.
+//
+//  The interpolation itself is fbLerp() from fbkernels.cpp.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#include "fadeengine.h"
+#include "fbkernels.h"
+
+//---------------------------------------------------------------------------------------
+// fadeWeight
+//
+// Calculates the progress of a fade for the given elapsed time
+//
+// -> easing: shape of the fade
+//    elapsed: milliseconds since the fade started
+//    duration: fade duration in milliseconds, 0 switches immediately
+// <- weight of the target colors [0...FADE_WEIGHT_MAX]
+//---------------------------------------------------------------------------------------
+uint16_t fadeWeight( FadeEasing easing, uint32_t elapsed, uint32_t duration ) {
+	if( elapsed >= duration )
+		return FADE_WEIGHT_MAX;
+
+	// progress with 12 bit resolution, durations up to 2^20 ms
+	uint32_t t = ( elapsed << 12 ) / duration;
+	switch( easing ) {
+	case FadeEasing::easeIn:
+		return ( t * t ) >> 16;
+	case FadeEasing::easeOut:
+		return FADE_WEIGHT_MAX - ( ( ( 4096 - t ) * ( 4096 - t ) ) >> 16 );
+	case FadeEasing::easeInOut:
+		// smoothstep 3t^2 - 2t^3
+		return ( ( ( t * t ) >> 12 ) * ( 3 * 4096 - 2 * t ) ) >> 16;
+	case FadeEasing::linear:
+	default:
+		return t >> 4;
+	}
+}
+
+//---------------------------------------------------------------------------------------
+// fadeBuffer
+//
+// Interpolates between two color buffers: current = start + (target - start) * weight.
+//
+// Attention: All buffers must be aligned at 32 bit!
+//
+// -> current: output buffer
+//    start: colors at the beginning of the fade
+//    target: colors at the end of the fade
+//    len: buffer length in bytes
+//    weight: weight of the target colors [0...FADE_WEIGHT_MAX]
+// <- --
+//---------------------------------------------------------------------------------------
+void fadeBuffer( uint8_t* current, const uint8_t* start, const uint8_t* target, int len, uint16_t weight ) {
+	fbLerp( current, start, target, len, weight );
+}
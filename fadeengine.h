@@ -0,0 +1,30 @@
+// ESP8266 Wordclock
+// Copyright (C) 2016 Thoralt Franz, https://github.com/thoralt
+// also (C) 2021 by Stefan Rinke, https://github.com/sker65
+//
+//  See fadeengine.cpp for description.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#pragma once
+
+#include <stdint.h>
+
+// weight of the fade target at the end of a fade
+#define FADE_WEIGHT_MAX 256
+
+enum class FadeEasing { linear, easeIn, easeOut, easeInOut, invalid };
+
+uint16_t fadeWeight( FadeEasing easing, uint32_t elapsed, uint32_t duration );
+void fadeBuffer( uint8_t* current, const uint8_t* start, const uint8_t* target, int len, uint16_t weight );
+
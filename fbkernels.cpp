@@ -0,0 +1,415 @@
+// ESP8266 Wordclock
+// Copyright (C) 2016 Thoralt Franz, https://github.com/thoralt
+// also (C) 2021 by Stefan Rinke, https://github.com/sker65
+//
+//  Kernels for the operations on whole color buffers (LEDMatrix::currentValues and
+//  friends): clear, fill with one color, scale, interpolate and saturating add. The
+//  ESP8266 uses the SWAR implementation, four 8 bit channels per 32 bit word with
+//  saturating arithmetic. The host build uses SSE2 (16 channels per instruction) or,
+//  when compiled with -mavx2, AVX2 (32 channels). All implementations give the same
+//  bytes for the same input, host/bench/kernel_bench verifies that.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#include <string.h>
+
+#include "fbkernels.h"
+
+#if defined( __SSE2__ )
+#include <emmintrin.h>
+#endif
+#if defined( __x86_64__ ) || defined( __i386__ )
+#include <immintrin.h>
+#define AVX2_TARGET __attribute__( ( target( "avx2" ) ) )
+#endif
+
+#define LANE_HIGH 0x80808080u
+#define LANE_LOW 0x7F7F7F7Fu
+#define LANE_EVEN 0x00FF00FFu
+
+//---------------------------------------------------------------------------------------
+// swarAddSat8
+//
+// Adds four unsigned 8 bit lanes, lanes overflowing 255 are clamped to 255
+//
+// -> a, b: four 8 bit values each
+// <- per lane min(a + b, 255)
+//---------------------------------------------------------------------------------------
+uint32_t swarAddSat8( uint32_t a, uint32_t b ) {
+	// add the low 7 bits, then the high bits without carrying into the next lane
+	uint32_t sum = ( ( a & LANE_LOW ) + ( b & LANE_LOW ) ) ^ ( ( a ^ b ) & LANE_HIGH );
+	// carry out of each lane
+	uint32_t carry = ( ( a & b ) | ( ( a | b ) & ~sum ) ) & LANE_HIGH;
+	return sum | ( ( carry >> 7 ) * 0xFF );
+}
+
+//---------------------------------------------------------------------------------------
+// swarSubSat8
+//
+// Subtracts four unsigned 8 bit lanes, lanes dropping below 0 are clamped to 0
+//
+// -> a, b: four 8 bit values each
+// <- per lane max(a - b, 0)
+//---------------------------------------------------------------------------------------
+uint32_t swarSubSat8( uint32_t a, uint32_t b ) {
+	// borrow from the forced high bit only, then fix the high bit of the result
+	uint32_t diff = ( ( a | LANE_HIGH ) - ( b & LANE_LOW ) ) ^ ( ( a ^ ~b ) & LANE_HIGH );
+	// borrow out of each lane
+	uint32_t borrow = ( ( ~a & b ) | ( ~( a ^ b ) & diff ) ) & LANE_HIGH;
+	return diff & ~( ( borrow >> 7 ) * 0xFF );
+}
+
+//---------------------------------------------------------------------------------------
+// swarScale8
+//
+// Scales four unsigned 8 bit lanes by weight / 256, two lanes per multiplication
+//
+// -> x: four 8 bit values
+//    weight: [0...256]
+// <- per lane (x * weight) >> 8
+//---------------------------------------------------------------------------------------
+uint32_t swarScale8( uint32_t x, uint16_t weight ) {
+	// 255 * 256 still fits into the 16 bits available for each lane
+	uint32_t even = ( ( ( x & LANE_EVEN ) * weight ) >> 8 ) & LANE_EVEN;
+	uint32_t odd = ( ( ( x >> 8 ) & LANE_EVEN ) * weight ) & ~LANE_EVEN;
+	return even | odd;
+}
+
+//---------------------------------------------------------------------------------------
+// byte wise operations for the bytes behind the last full word or vector, the results
+// define the operations for all implementations
+//---------------------------------------------------------------------------------------
+static inline void fillBytes( uint8_t* buf, int from, int len, const palette_entry& color ) {
+	const uint8_t* c = &color.r;
+	int ch = from % 3;
+	for( int i = from; i < len; i++ ) {
+		buf[i] = c[ch];
+		if( ++ch == 3 )
+			ch = 0;
+	}
+}
+
+// repeats the pixels of a 12 byte pattern (4 pixels) into the pattern for the vectors
+static inline void fillPattern( uint8_t* pattern, int len, const palette_entry& color ) {
+	fillBytes( pattern, 0, 12, color );
+	for( int i = 12; i < len; i += 12 )
+		memcpy( pattern + i, pattern, 12 );
+}
+
+static inline void scaleBytes( uint8_t* dst, const uint8_t* src, int from, int len, uint16_t weight ) {
+	for( int i = from; i < len; i++ )
+		dst[i] = ( src[i] * weight ) >> 8;
+}
+
+static inline void lerpBytes( uint8_t* dst, const uint8_t* start, const uint8_t* target, int from, int len,
+                              uint16_t weight ) {
+	for( int i = from; i < len; i++ ) {
+		if( target[i] >= start[i] )
+			dst[i] = start[i] + ( ( ( target[i] - start[i] ) * weight ) >> 8 );
+		else
+			dst[i] = start[i] - ( ( ( start[i] - target[i] ) * weight ) >> 8 );
+	}
+}
+
+static inline void addSatBytes( uint8_t* dst, const uint8_t* src, int from, int len ) {
+	for( int i = from; i < len; i++ ) {
+		int v = dst[i] + src[i];
+		dst[i] = v > 255 ? 255 : v;
+	}
+}
+
+//---------------------------------------------------------------------------------------
+// SWAR, 4 channels per 32 bit word, the buffers must be aligned at 32 bit
+//---------------------------------------------------------------------------------------
+static void clearSwar( uint8_t* buf, int len ) {
+	uint32_t* w = (uint32_t*)buf;
+	int words = len >> 2;
+	for( int i = 0; i < words; i++ )
+		w[i] = 0;
+	for( int i = words << 2; i < len; i++ )
+		buf[i] = 0;
+}
+
+static void fillSwar( uint8_t* buf, int len, const palette_entry& color ) {
+	// 4 pixels in 3 words
+	uint8_t bytes[12];
+	fillBytes( bytes, 0, 12, color );
+	uint32_t pattern[3];
+	memcpy( pattern, bytes, sizeof( pattern ) );
+
+	uint32_t* w = (uint32_t*)buf;
+	int words = len >> 2;
+	int p = 0;
+	for( int i = 0; i < words; i++ ) {
+		w[i] = pattern[p];
+		if( ++p == 3 )
+			p = 0;
+	}
+	fillBytes( buf, words << 2, len, color );
+}
+
+static void scaleSwar( uint8_t* dst, const uint8_t* src, int len, uint16_t weight ) {
+	uint32_t* d = (uint32_t*)dst;
+	const uint32_t* s = (const uint32_t*)src;
+	int words = len >> 2;
+	for( int i = 0; i < words; i++ )
+		d[i] = swarScale8( s[i], weight );
+	scaleBytes( dst, src, words << 2, len, weight );
+}
+
+static void lerpSwar( uint8_t* dst, const uint8_t* start, const uint8_t* target, int len, uint16_t weight ) {
+	uint32_t* d = (uint32_t*)dst;
+	const uint32_t* s = (const uint32_t*)start;
+	const uint32_t* t = (const uint32_t*)target;
+	int words = len >> 2;
+	for( int i = 0; i < words; i++ ) {
+		// the distance is split into a rising and a falling part per channel, so all
+		// arithmetic stays unsigned
+		uint32_t up = swarSubSat8( t[i], s[i] );
+		uint32_t down = swarSubSat8( s[i], t[i] );
+		d[i] = swarSubSat8( swarAddSat8( s[i], swarScale8( up, weight ) ), swarScale8( down, weight ) );
+	}
+	lerpBytes( dst, start, target, words << 2, len, weight );
+}
+
+static void addSatSwar( uint8_t* dst, const uint8_t* src, int len ) {
+	uint32_t* d = (uint32_t*)dst;
+	const uint32_t* s = (const uint32_t*)src;
+	int words = len >> 2;
+	for( int i = 0; i < words; i++ )
+		d[i] = swarAddSat8( d[i], s[i] );
+	addSatBytes( dst, src, words << 2, len );
+}
+
+const fb_kernels_t fbKernelsSwar = { "swar", clearSwar, fillSwar, scaleSwar, lerpSwar, addSatSwar };
+
+#if defined( __SSE2__ )
+//---------------------------------------------------------------------------------------
+// SSE2, 16 channels per vector, host only
+//---------------------------------------------------------------------------------------
+static inline __m128i scaleSse2( __m128i x, __m128i weight ) {
+	__m128i zero = _mm_setzero_si128();
+	__m128i lo = _mm_srli_epi16( _mm_mullo_epi16( _mm_unpacklo_epi8( x, zero ), weight ), 8 );
+	__m128i hi = _mm_srli_epi16( _mm_mullo_epi16( _mm_unpackhi_epi8( x, zero ), weight ), 8 );
+	return _mm_packus_epi16( lo, hi );
+}
+
+static void clearSse2( uint8_t* buf, int len ) {
+	int i = 0;
+	for( ; i + 16 <= len; i += 16 )
+		_mm_storeu_si128( (__m128i*)( buf + i ), _mm_setzero_si128() );
+	for( ; i < len; i++ )
+		buf[i] = 0;
+}
+
+static void fillSse2( uint8_t* buf, int len, const palette_entry& color ) {
+	// 16 pixels in 3 vectors
+	uint8_t bytes[48];
+	fillPattern( bytes, sizeof( bytes ), color );
+	__m128i p0 = _mm_loadu_si128( (const __m128i*)bytes );
+	__m128i p1 = _mm_loadu_si128( (const __m128i*)( bytes + 16 ) );
+	__m128i p2 = _mm_loadu_si128( (const __m128i*)( bytes + 32 ) );
+	int i = 0;
+	for( ; i + 48 <= len; i += 48 ) {
+		_mm_storeu_si128( (__m128i*)( buf + i ), p0 );
+		_mm_storeu_si128( (__m128i*)( buf + i + 16 ), p1 );
+		_mm_storeu_si128( (__m128i*)( buf + i + 32 ), p2 );
+	}
+	// the pattern starts with red again
+	memcpy( buf + i, bytes, len - i );
+}
+
+static void scaleSse2( uint8_t* dst, const uint8_t* src, int len, uint16_t weight ) {
+	__m128i w = _mm_set1_epi16( weight );
+	int i = 0;
+	for( ; i + 16 <= len; i += 16 )
+		_mm_storeu_si128( (__m128i*)( dst + i ), scaleSse2( _mm_loadu_si128( (const __m128i*)( src + i ) ), w ) );
+	scaleBytes( dst, src, i, len, weight );
+}
+
+static void lerpSse2( uint8_t* dst, const uint8_t* start, const uint8_t* target, int len, uint16_t weight ) {
+	__m128i w = _mm_set1_epi16( weight );
+	int i = 0;
+	for( ; i + 16 <= len; i += 16 ) {
+		__m128i s = _mm_loadu_si128( (const __m128i*)( start + i ) );
+		__m128i t = _mm_loadu_si128( (const __m128i*)( target + i ) );
+		__m128i up = scaleSse2( _mm_subs_epu8( t, s ), w );
+		__m128i down = scaleSse2( _mm_subs_epu8( s, t ), w );
+		_mm_storeu_si128( (__m128i*)( dst + i ), _mm_subs_epu8( _mm_adds_epu8( s, up ), down ) );
+	}
+	lerpBytes( dst, start, target, i, len, weight );
+}
+
+static void addSatSse2( uint8_t* dst, const uint8_t* src, int len ) {
+	int i = 0;
+	for( ; i + 16 <= len; i += 16 ) {
+		__m128i d = _mm_loadu_si128( (const __m128i*)( dst + i ) );
+		__m128i s = _mm_loadu_si128( (const __m128i*)( src + i ) );
+		_mm_storeu_si128( (__m128i*)( dst + i ), _mm_adds_epu8( d, s ) );
+	}
+	addSatBytes( dst, src, i, len );
+}
+
+const fb_kernels_t fbKernelsSse2 = { "sse2", clearSse2, fillSse2, scaleSse2, lerpSse2, addSatSse2 };
+#endif
+
+#if defined( __x86_64__ ) || defined( __i386__ )
+//---------------------------------------------------------------------------------------
+// AVX2, 32 channels per vector, host only. Unpacking and packing both work within the
+// 128 bit halves, so the channel order is kept.
+//---------------------------------------------------------------------------------------
+AVX2_TARGET static inline __m256i scaleAvx2( __m256i x, __m256i weight ) {
+	__m256i zero = _mm256_setzero_si256();
+	__m256i lo = _mm256_srli_epi16( _mm256_mullo_epi16( _mm256_unpacklo_epi8( x, zero ), weight ), 8 );
+	__m256i hi = _mm256_srli_epi16( _mm256_mullo_epi16( _mm256_unpackhi_epi8( x, zero ), weight ), 8 );
+	return _mm256_packus_epi16( lo, hi );
+}
+
+AVX2_TARGET static void clearAvx2( uint8_t* buf, int len ) {
+	int i = 0;
+	for( ; i + 32 <= len; i += 32 )
+		_mm256_storeu_si256( (__m256i*)( buf + i ), _mm256_setzero_si256() );
+	for( ; i < len; i++ )
+		buf[i] = 0;
+}
+
+AVX2_TARGET static void fillAvx2( uint8_t* buf, int len, const palette_entry& color ) {
+	// 32 pixels in 3 vectors
+	uint8_t bytes[96];
+	fillPattern( bytes, sizeof( bytes ), color );
+	__m256i p0 = _mm256_loadu_si256( (const __m256i*)bytes );
+	__m256i p1 = _mm256_loadu_si256( (const __m256i*)( bytes + 32 ) );
+	__m256i p2 = _mm256_loadu_si256( (const __m256i*)( bytes + 64 ) );
+	int i = 0;
+	for( ; i + 96 <= len; i += 96 ) {
+		_mm256_storeu_si256( (__m256i*)( buf + i ), p0 );
+		_mm256_storeu_si256( (__m256i*)( buf + i + 32 ), p1 );
+		_mm256_storeu_si256( (__m256i*)( buf + i + 64 ), p2 );
+	}
+	// the pattern starts with red again
+	memcpy( buf + i, bytes, len - i );
+}
+
+AVX2_TARGET static void scaleAvx2( uint8_t* dst, const uint8_t* src, int len, uint16_t weight ) {
+	__m256i w = _mm256_set1_epi16( weight );
+	int i = 0;
+	for( ; i + 32 <= len; i += 32 )
+		_mm256_storeu_si256( (__m256i*)( dst + i ),
+		                     scaleAvx2( _mm256_loadu_si256( (const __m256i*)( src + i ) ), w ) );
+	scaleBytes( dst, src, i, len, weight );
+}
+
+AVX2_TARGET static void lerpAvx2( uint8_t* dst, const uint8_t* start, const uint8_t* target, int len,
+                                  uint16_t weight ) {
+	__m256i w = _mm256_set1_epi16( weight );
+	int i = 0;
+	for( ; i + 32 <= len; i += 32 ) {
+		__m256i s = _mm256_loadu_si256( (const __m256i*)( start + i ) );
+		__m256i t = _mm256_loadu_si256( (const __m256i*)( target + i ) );
+		__m256i up = scaleAvx2( _mm256_subs_epu8( t, s ), w );
+		__m256i down = scaleAvx2( _mm256_subs_epu8( s, t ), w );
+		_mm256_storeu_si256( (__m256i*)( dst + i ), _mm256_subs_epu8( _mm256_adds_epu8( s, up ), down ) );
+	}
+	lerpBytes( dst, start, target, i, len, weight );
+}
+
+AVX2_TARGET static void addSatAvx2( uint8_t* dst, const uint8_t* src, int len ) {
+	int i = 0;
+	for( ; i + 32 <= len; i += 32 ) {
+		__m256i d = _mm256_loadu_si256( (const __m256i*)( dst + i ) );
+		__m256i s = _mm256_loadu_si256( (const __m256i*)( src + i ) );
+		_mm256_storeu_si256( (__m256i*)( dst + i ), _mm256_adds_epu8( d, s ) );
+	}
+	addSatBytes( dst, src, i, len );
+}
+
+const fb_kernels_t fbKernelsAvx2 = { "avx2", clearAvx2, fillAvx2, scaleAvx2, lerpAvx2, addSatAvx2 };
+#endif
+
+//---------------------------------------------------------------------------------------
+// the implementation selected at compile time, see FB_KERNELS_NAME
+//---------------------------------------------------------------------------------------
+#if defined( __AVX2__ )
+#define FB_KERNEL( op ) op##Avx2
+#elif defined( __SSE2__ )
+#define FB_KERNEL( op ) op##Sse2
+#else
+#define FB_KERNEL( op ) op##Swar
+#endif
+
+//---------------------------------------------------------------------------------------
+// fbClear
+//
+// Sets all channels to 0
+//
+// -> buf: color buffer
+//    len: buffer length in bytes
+// <- --
+//---------------------------------------------------------------------------------------
+void fbClear( uint8_t* buf, int len ) { FB_KERNEL( clear )( buf, len ); }
+
+//---------------------------------------------------------------------------------------
+// fbFill
+//
+// Sets all pixels to one color
+//
+// -> buf: color buffer (r, g, b)
+//    len: buffer length in bytes
+//    color: fill color
+// <- --
+//---------------------------------------------------------------------------------------
+void fbFill( uint8_t* buf, int len, const palette_entry& color ) { FB_KERNEL( fill )( buf, len, color ); }
+
+//---------------------------------------------------------------------------------------
+// fbScale
+//
+// Scales all channels: dst = (src * weight) >> 8
+//
+// -> dst: output buffer, may be src
+//    src: colors to scale
+//    len: buffer length in bytes
+//    weight: [0...256]
+// <- --
+//---------------------------------------------------------------------------------------
+void fbScale( uint8_t* dst, const uint8_t* src, int len, uint16_t weight ) {
+	FB_KERNEL( scale )( dst, src, len, weight );
+}
+
+//---------------------------------------------------------------------------------------
+// fbLerp
+//
+// Interpolates between two color buffers: dst = start + (target - start) * weight,
+// the distance covered is rounded down
+//
+// -> dst: output buffer, may be start or target
+//    start: colors at weight 0
+//    target: colors at weight 256
+//    len: buffer length in bytes
+//    weight: [0...256]
+// <- --
+//---------------------------------------------------------------------------------------
+void fbLerp( uint8_t* dst, const uint8_t* start, const uint8_t* target, int len, uint16_t weight ) {
+	FB_KERNEL( lerp )( dst, start, target, len, weight );
+}
+
+//---------------------------------------------------------------------------------------
+// fbAddSat
+//
+// Adds two color buffers, channels are clamped to 255
+//
+// -> dst: first summand and output buffer
+//    src: second summand
+//    len: buffer length in bytes
+// <- --
+//---------------------------------------------------------------------------------------
+void fbAddSat( uint8_t* dst, const uint8_t* src, int len ) { FB_KERNEL( addSat )( dst, src, len ); }
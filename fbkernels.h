@@ -0,0 +1,63 @@
+// ESP8266 Wordclock
+// Copyright (C) 2016 Thoralt Franz, https://github.com/thoralt
+// also (C) 2021 by Stefan Rinke, https://github.com/sker65
+//
+//  See fbkernels.cpp for description.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#pragma once
+
+#include <stdint.h>
+
+#include "config.h"
+
+// operations on color buffers of len bytes, aligned at 32 bit, in place is allowed
+void fbClear( uint8_t* buf, int len );
+void fbFill( uint8_t* buf, int len, const palette_entry& color );
+void fbScale( uint8_t* dst, const uint8_t* src, int len, uint16_t weight );
+void fbLerp( uint8_t* dst, const uint8_t* start, const uint8_t* target, int len, uint16_t weight );
+void fbAddSat( uint8_t* dst, const uint8_t* src, int len );
+
+// one implementation of all operations, fb...() above call the one selected at compile
+// time (FB_KERNELS_NAME), the others are only used by the host benchmark
+typedef struct _fb_kernels_t {
+	const char* name;
+	void ( *clear )( uint8_t* buf, int len );
+	void ( *fill )( uint8_t* buf, int len, const palette_entry& color );
+	void ( *scale )( uint8_t* dst, const uint8_t* src, int len, uint16_t weight );
+	void ( *lerp )( uint8_t* dst, const uint8_t* start, const uint8_t* target, int len, uint16_t weight );
+	void ( *addSat )( uint8_t* dst, const uint8_t* src, int len );
+} fb_kernels_t;
+
+extern const fb_kernels_t fbKernelsSwar;
+#if defined( __SSE2__ )
+extern const fb_kernels_t fbKernelsSse2;
+#endif
+#if defined( __x86_64__ ) || defined( __i386__ )
+// only callable if the CPU supports AVX2, see __builtin_cpu_supports()
+extern const fb_kernels_t fbKernelsAvx2;
+#endif
+
+#if defined( __AVX2__ )
+#define FB_KERNELS_NAME "avx2"
+#elif defined( __SSE2__ )
+#define FB_KERNELS_NAME "sse2"
+#else
+#define FB_KERNELS_NAME "swar"
+#endif
+
+// SWAR helpers, four 8 bit lanes per 32 bit word
+uint32_t swarAddSat8( uint32_t a, uint32_t b );
+uint32_t swarSubSat8( uint32_t a, uint32_t b );
+uint32_t swarScale8( uint32_t x, uint16_t weight );
@@ -0,0 +1,97 @@
+// ESP8266 Wordclock
+// Copyright (C) 2016 Thoralt Franz, https://github.com/thoralt
+// also (C) 2021 by Stefan Rinke, https://github.com/sker65
+//
+//  Fire simulation on a heat buffer of FIRE_WIDTH * FIRE_HEIGHT cells. Every step
+//  puts random hot spots into the bottom row and lets the heat rise: each cell
+//  becomes the cooled average of the three cells below and the one two rows below.
+//
+//  The source cells come from a precomputed table in flash, the random numbers from
+//  a xorshift generator and the division by a multiplication. Steps are triggered by
+//  the elapsed time, so the flames keep their speed at any frame rate and nothing
+//  blocks the main loop.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#include <Arduino.h>
+
+#include "fire.h"
+
+static constexpr fire_neighbours_t PROGMEM __attribute__( ( aligned( 4 ) ) ) fireNeighbours =
+    generateFireNeighbours();
+
+//---------------------------------------------------------------------------------------
+// seedFire
+//
+// Sets the bottom row: every cell is a hot spot with probability 1/4, its
+// temperature is random
+//
+// -> heat: heat buffer
+//    rng: xorshift32 state
+// <- --
+//---------------------------------------------------------------------------------------
+void seedFire( uint8_t* heat, uint32_t& rng ) {
+	uint8_t* row = heat + FIRE_CELLS - FIRE_WIDTH;
+	for( int x = 0; x < FIRE_WIDTH; x++ ) {
+		// low two bits select hot spots, the high byte is the temperature
+		uint32_t r = xorshift32( rng );
+		row[x] = ( r & 3 ) == 0 ? r >> 24 : 0;
+	}
+}
+
+//---------------------------------------------------------------------------------------
+// diffuseFire
+//
+// Moves the heat one row up. Rows are processed top down in place, so every cell
+// reads the values of the previous step.
+//
+// -> heat: heat buffer
+// <- --
+//---------------------------------------------------------------------------------------
+void diffuseFire( uint8_t* heat ) {
+	for( int i = 0; i < FIRE_CELLS - FIRE_WIDTH; i++ ) {
+		uint32_t n = pgm_read_dword( &fireNeighbours.cells[i] );
+		uint32_t sum = heat[n & 0xFF] + heat[( n >> 8 ) & 0xFF] + heat[( n >> 16 ) & 0xFF] + heat[n >> 24];
+		heat[i] = ( sum * FIRE_COOLING_Q16 ) >> 16;
+	}
+}
+
+//---------------------------------------------------------------------------------------
+// advanceFire
+//
+// Runs the simulation steps due since the last step
+//
+// -> heat: heat buffer
+//    rng: xorshift32 state
+//    stepMillis: time of the last step, updated
+//    now: current time in milliseconds
+// <- number of steps executed, 0 if the heat buffer is unchanged
+//---------------------------------------------------------------------------------------
+int advanceFire( uint8_t* heat, uint32_t& rng, uint32_t& stepMillis, uint32_t now ) {
+	uint32_t due = ( now - stepMillis ) / FIRE_STEP_MS;
+	if( due == 0 )
+		return 0;
+
+	if( due > FIRE_MAX_STEPS ) {
+		due = FIRE_MAX_STEPS;
+		stepMillis = now;
+	} else {
+		stepMillis += due * FIRE_STEP_MS;
+	}
+
+	for( uint32_t i = 0; i < due; i++ ) {
+		seedFire( heat, rng );
+		diffuseFire( heat );
+	}
+	return due;
+}
@@ -0,0 +1,82 @@
+// ESP8266 Wordclock
+// Copyright (C) 2016 Thoralt Franz, https://github.com/thoralt
+// also (C) 2021 by Stefan Rinke, https://github.com/sker65
+//
+//  See fire.cpp for description.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#pragma once
+
+#include <stdint.h>
+
+// size of the heat buffer, must match LEDMatrix::width and LEDMatrix::height
+#define FIRE_WIDTH 11
+#define FIRE_HEIGHT 10
+#define FIRE_CELLS ( FIRE_WIDTH * FIRE_HEIGHT )
+// one simulation step per FIRE_STEP_MS, independent of the frame rate
+#define FIRE_STEP_MS 100
+// steps to catch up at most after a stall, the remaining time is dropped
+#define FIRE_MAX_STEPS 3
+// a cell takes the sum of its four source cells * 32 / 129, i. e. their average
+// cooled by 1/129 per step, as multiplication with 16.16 fixed point
+#define FIRE_COOLING_Q16 16257
+
+// indexes of the cells below left, below, below right and two below of every cell
+// except the bottom row, clamped at the edges, one byte each
+typedef struct _fire_neighbours_t {
+	uint32_t cells[FIRE_CELLS - FIRE_WIDTH];
+} fire_neighbours_t;
+
+//---------------------------------------------------------------------------------------
+// generateFireNeighbours
+//
+// Creates the neighbour table, only evaluated by the compiler
+//
+// -> --
+// <- table with the source cells of every cell
+//---------------------------------------------------------------------------------------
+constexpr fire_neighbours_t generateFireNeighbours() {
+	fire_neighbours_t t = {};
+	for( int y = 0; y < FIRE_HEIGHT - 1; y++ ) {
+		int y1 = y + 1;
+		int y2 = y + 2 < FIRE_HEIGHT ? y + 2 : FIRE_HEIGHT - 1;
+		for( int x = 0; x < FIRE_WIDTH; x++ ) {
+			int l = x > 0 ? x - 1 : 0;
+			int r = x < FIRE_WIDTH - 1 ? x + 1 : FIRE_WIDTH - 1;
+			t.cells[x + y * FIRE_WIDTH] = ( y1 * FIRE_WIDTH + l ) | ( ( y1 * FIRE_WIDTH + x ) << 8 ) |
+			                              ( ( y1 * FIRE_WIDTH + r ) << 16 ) | ( ( y2 * FIRE_WIDTH + x ) << 24 );
+		}
+	}
+	return t;
+}
+
+//---------------------------------------------------------------------------------------
+// xorshift32
+//
+// Small and fast pseudo random number generator (Marsaglia)
+//
+// -> state: generator state, must not be 0
+// <- next random number, also the new state
+//---------------------------------------------------------------------------------------
+static inline uint32_t xorshift32( uint32_t& state ) {
+	uint32_t x = state;
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	return state = x;
+}
+
+void seedFire( uint8_t* heat, uint32_t& rng );
+void diffuseFire( uint8_t* heat );
+int advanceFire( uint8_t* heat, uint32_t& rng, uint32_t& stepMillis, uint32_t now );
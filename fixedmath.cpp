@@ -0,0 +1,69 @@
+// ESP8266 Wordclock
+// Copyright (C) 2016 Thoralt Franz, https://github.com/thoralt
+// also (C) 2021 by Stefan Rinke, https://github.com/sker65
+//
+//  Integer math helpers shared by the effects: sin() and cos() from a table in
+//  flash with linear interpolation and an integer square root.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#include <Arduino.h>
+
+#include "fixedmath.h"
+
+static constexpr sine_table_t PROGMEM __attribute__( ( aligned( 4 ) ) ) sineTable = generateSineTable();
+
+//---------------------------------------------------------------------------------------
+// sin16
+//
+// -> angle: 65536 = 2 * pi
+// <- sin(angle) in Q15 [-32767...32767]
+//---------------------------------------------------------------------------------------
+int16_t sin16( uint16_t angle ) {
+	uint16_t i = angle >> 8;
+	int32_t a = (int16_t)pgm_read_word( &sineTable.values[i] );
+	int32_t b = (int16_t)pgm_read_word( &sineTable.values[i + 1] );
+	return a + ( ( ( b - a ) * ( angle & 0xFF ) ) >> 8 );
+}
+
+//---------------------------------------------------------------------------------------
+// cos16
+//
+// -> angle: 65536 = 2 * pi
+// <- cos(angle) in Q15 [-32767...32767]
+//---------------------------------------------------------------------------------------
+int16_t cos16( uint16_t angle ) { return sin16( angle + 16384 ); }
+
+//---------------------------------------------------------------------------------------
+// isqrt32
+//
+// Integer square root, bit by bit without branches in the loop
+//
+// -> x: radicand
+// <- floor(sqrt(x))
+//---------------------------------------------------------------------------------------
+uint16_t isqrt32( uint32_t x ) {
+	if( x == 0 )
+		return 0;
+	uint32_t result = 0;
+	// highest even power of two not above x
+	uint32_t bit = 1u << ( ( 31 - __builtin_clz( x ) ) & ~1 );
+	while( bit ) {
+		uint32_t trial = result + bit;
+		uint32_t take = -(uint32_t)( x >= trial );
+		x -= trial & take;
+		result = ( result >> 1 ) + ( bit & take );
+		bit >>= 2;
+	}
+	return result;
+}
@@ -0,0 +1,63 @@
+// ESP8266 Wordclock
+// Copyright (C) 2016 Thoralt Franz, https://github.com/thoralt
+// also (C) 2021 by Stefan Rinke, https://github.com/sker65
+//
+//  See fixedmath.cpp for description.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#pragma once
+
+#include <stdint.h>
+
+// angles are uint16_t, 65536 is one full turn
+#define SINE_TABLE_STEPS 256
+
+typedef struct _sine_table_t {
+	// one extra entry for the interpolation of the last step
+	int16_t values[SINE_TABLE_STEPS + 1];
+} sine_table_t;
+
+//---------------------------------------------------------------------------------------
+// generateSineTable
+//
+// Creates one full period of sin() in Q15, only evaluated by the compiler
+//
+// -> --
+// <- table with round(32767 * sin(2 * pi * i / SINE_TABLE_STEPS))
+//---------------------------------------------------------------------------------------
+constexpr sine_table_t generateSineTable() {
+	sine_table_t t = {};
+	for( int i = 0; i <= SINE_TABLE_STEPS; i++ ) {
+		// reduce to [-pi/2...pi/2] using sin(pi - x) = sin(x), then Taylor series
+		int q = i % SINE_TABLE_STEPS;
+		if( q > SINE_TABLE_STEPS * 3 / 4 )
+			q -= SINE_TABLE_STEPS;
+		else if( q > SINE_TABLE_STEPS / 4 )
+			q = SINE_TABLE_STEPS / 2 - q;
+		double x = q * 2.0 * 3.14159265358979323846 / SINE_TABLE_STEPS;
+		double term = x;
+		double sum = x;
+		for( int k = 1; k < 12; k++ ) {
+			term *= -x * x / ( ( 2 * k ) * ( 2 * k + 1 ) );
+			sum += term;
+		}
+		double v = 32767.0 * sum;
+		t.values[i] = (int16_t)( v < 0 ? v - 0.5 : v + 0.5 );
+	}
+	return t;
+}
+
+int16_t sin16( uint16_t angle );
+int16_t cos16( uint16_t angle );
+uint16_t isqrt32( uint32_t x );
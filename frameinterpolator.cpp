@@ -0,0 +1,74 @@
+// ESP8266 Wordclock
+// Copyright (C) 2016 Thoralt Franz, https://github.com/thoralt
+// also (C) 2021 by Stefan Rinke, https://github.com/sker65
+//
+//  Interpolation between simulation steps. Effects like fire, stars and heart
+//  declare a simulation period in effectTable[] (see effects.cpp), their render() is
+//  then only called once per period. The last two frames rendered are kept and every
+//  frame shown in between is blended from them with fbLerp(), so the LEDs update at
+//  the frame period of the mode with smooth motion while the simulation costs CPU
+//  only 10 to 25 times per second. The output runs one simulation step behind.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#include <string.h>
+
+#include "fbkernels.h"
+#include "frameinterpolator.h"
+#include "ledfunctions.h"
+
+//---------------------------------------------------------------------------------------
+// render
+//
+// Renders a frame of the effect into led.currentValues. With a simulation period (see
+// effect_info_t) the effect only renders when the next step is due, the frame is
+// blended from the last two steps otherwise. Another effect or a gap of two periods or
+// more (e. g. the effect was not shown for a while) restarts with a fresh step.
+//
+// -> effect: effect to render
+//    mode: display mode of the effect
+//    led: target
+//    frame: passed to Effect::render()
+// <- --
+//---------------------------------------------------------------------------------------
+void FrameInterpolator::render( Effect* effect, DisplayMode mode, LEDMatrix& led, const effect_frame_t& frame ) {
+	uint8_t simulationPeriod = getEffectInfo( mode ).simulationPeriod;
+	if( simulationPeriod == 0 ) {
+		effect->render( led, frame );
+		return;
+	}
+
+	uint32_t now = millis();
+	uint32_t elapsed = now - this->stepMillis;
+	if( effect != this->effect || mode != this->mode || elapsed >= 2u * simulationPeriod ) {
+		effect->render( led, frame );
+		memcpy( this->previous, led.currentValues, sizeof( this->previous ) );
+		memcpy( this->next, led.currentValues, sizeof( this->next ) );
+		this->effect = effect;
+		this->mode = mode;
+		this->stepMillis = now;
+		this->steps = 1;
+		return;
+	}
+
+	if( elapsed >= simulationPeriod ) {
+		memcpy( this->previous, this->next, sizeof( this->previous ) );
+		effect->render( led, frame );
+		memcpy( this->next, led.currentValues, sizeof( this->next ) );
+		this->stepMillis += simulationPeriod;
+		elapsed -= simulationPeriod;
+		this->steps++;
+	}
+	fbLerp( led.currentValues, this->previous, this->next, sizeof( this->previous ),
+	        ( elapsed << 8 ) / simulationPeriod );
+}
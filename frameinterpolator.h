@@ -0,0 +1,41 @@
+// ESP8266 Wordclock
+// Copyright (C) 2016 Thoralt Franz, https://github.com/thoralt
+// also (C) 2021 by Stefan Rinke, https://github.com/sker65
+//
+//  See frameinterpolator.cpp for description.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#pragma once
+
+#include <stdint.h>
+
+#include "config.h"
+#include "effect.h"
+
+class FrameInterpolator {
+public:
+	void render( Effect* effect, DisplayMode mode, LEDMatrix& led, const effect_frame_t& frame );
+	// number of simulation steps rendered since the effect was started
+	uint32_t getSteps() { return this->steps; }
+
+private:
+	// the last two simulation steps, the output runs one step behind the simulation
+	uint8_t previous[NUM_PIXELS * 3] __attribute__( ( aligned( 4 ) ) );
+	uint8_t next[NUM_PIXELS * 3] __attribute__( ( aligned( 4 ) ) );
+	// the effects of all modes are constructed at the same address of the arena
+	const Effect* effect = nullptr;
+	DisplayMode mode = DisplayMode::invalid;
+	uint32_t stepMillis = 0;
+	uint32_t steps = 0;
+};
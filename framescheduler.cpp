@@ -0,0 +1,109 @@
+// ESP8266 Wordclock
+// Copyright (C) 2016 Thoralt Franz, https://github.com/thoralt
+// also (C) 2021 by Stefan Rinke, https://github.com/sker65
+//
+//  Deadline based frame pacing for the main loop. Instead of sleeping a fixed time
+//  per loop(), the LEDs are rendered whenever the deadline of the next frame is
+//  reached, the time in between is left to OTA, HTTP and telnet handling. The frame
+//  period is given per call, so every display mode can run at its own rate.
+//
+//  A frame rendered one full period or more after its deadline counts as missed,
+//  the schedule is then restarted from the current time instead of rendering the
+//  missed frames in a burst.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#include "framescheduler.h"
+
+//---------------------------------------------------------------------------------------
+// global instance
+//---------------------------------------------------------------------------------------
+FrameSchedulerClass FrameScheduler = FrameSchedulerClass();
+
+//---------------------------------------------------------------------------------------
+// FrameSchedulerClass
+//
+// Constructor
+//
+// -> --
+// <- --
+//---------------------------------------------------------------------------------------
+FrameSchedulerClass::FrameSchedulerClass() {}
+
+//---------------------------------------------------------------------------------------
+// frameDue
+//
+// Checks if the next frame has to be rendered and schedules the following one. The
+// first call is always due.
+//
+// -> nowMicros: current time in microseconds, e. g. micros()
+//    periodMs: frame period of the current display mode in milliseconds
+// <- true: render a frame now
+//---------------------------------------------------------------------------------------
+bool FrameSchedulerClass::frameDue( uint32_t nowMicros, uint32_t periodMs ) {
+	uint32_t period = periodMs * 1000;
+
+	if( !this->started ) {
+		this->started = true;
+		this->nextDeadline = nowMicros;
+	}
+
+	// signed difference handles the wrap around of micros() after 71 minutes
+	int32_t lateness = (int32_t)( nowMicros - this->nextDeadline );
+	if( lateness < 0 ) {
+		// the period may have become shorter since the deadline was set
+		if( (uint32_t)-lateness <= period )
+			return false;
+		lateness = 0;
+		this->nextDeadline = nowMicros;
+	}
+
+	this->frames++;
+	this->jitterSumMicros += lateness;
+	if( (uint32_t)lateness > this->jitterMaxMicros )
+		this->jitterMaxMicros = lateness;
+
+	if( (uint32_t)lateness >= period ) {
+		// one or more frames were missed, restart the schedule from now
+		this->missedDeadlines++;
+		this->nextDeadline = nowMicros + period;
+	} else {
+		this->nextDeadline += period;
+	}
+	return true;
+}
+
+//---------------------------------------------------------------------------------------
+// jitterAvgMicros
+//
+// -> --
+// <- average lateness of the frames since the last reset() in microseconds
+//---------------------------------------------------------------------------------------
+uint32_t FrameSchedulerClass::jitterAvgMicros() {
+	return this->frames ? (uint32_t)( this->jitterSumMicros / this->frames ) : 0;
+}
+
+//---------------------------------------------------------------------------------------
+// reset
+//
+// Clears the statistics, the schedule itself continues
+//
+// -> --
+// <- --
+//---------------------------------------------------------------------------------------
+void FrameSchedulerClass::reset() {
+	this->frames = 0;
+	this->missedDeadlines = 0;
+	this->jitterMaxMicros = 0;
+	this->jitterSumMicros = 0;
+}
@@ -0,0 +1,41 @@
+// ESP8266 Wordclock
+// Copyright (C) 2016 Thoralt Franz, https://github.com/thoralt
+// also (C) 2021 by Stefan Rinke, https://github.com/sker65
+//
+//  See framescheduler.cpp for description.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#pragma once
+
+#include <stdint.h>
+
+class FrameSchedulerClass {
+public:
+	FrameSchedulerClass();
+	bool frameDue( uint32_t nowMicros, uint32_t periodMs );
+	void reset();
+
+	// statistics since the last reset(), lateness of a frame against its deadline
+	uint32_t frames = 0;
+	uint32_t missedDeadlines = 0;
+	uint32_t jitterMaxMicros = 0;
+	uint32_t jitterAvgMicros();
+
+private:
+	uint32_t nextDeadline = 0;
+	bool started = false;
+	uint64_t jitterSumMicros = 0;
+};
+
+extern FrameSchedulerClass FrameScheduler;
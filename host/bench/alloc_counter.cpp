@@ -0,0 +1,65 @@
+// ESP8266 Wordclock
+// Copyright (C) 2016 Thoralt Franz, https://github.com/thoralt
+// also (C) 2021 by Stefan Rinke, https://github.com/sker65
+//
+//  Counting replacement for the global operator new/delete, see alloc_counter.h.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#include "alloc_counter.h"
+
+#include <new>
+#include <stdlib.h>
+
+// every block carries its size in a header so frees can be accounted
+static const size_t HEADER_SIZE = 16;
+
+static AllocStats stats = { 0, 0, 0, 0, 0 };
+
+AllocStats allocStats() { return stats; }
+
+void allocReset() {
+	stats.allocations = 0;
+	stats.frees = 0;
+	stats.bytesAllocated = 0;
+	stats.peakLiveBytes = stats.liveBytes;
+}
+
+static void* countedAlloc( size_t size ) {
+	uint8_t* block = (uint8_t*)malloc( size + HEADER_SIZE );
+	if( !block )
+		throw std::bad_alloc();
+	*(size_t*)block = size;
+	stats.allocations++;
+	stats.bytesAllocated += size;
+	stats.liveBytes += size;
+	if( stats.liveBytes > stats.peakLiveBytes )
+		stats.peakLiveBytes = stats.liveBytes;
+	return block + HEADER_SIZE;
+}
+
+static void countedFree( void* p ) {
+	if( !p )
+		return;
+	uint8_t* block = (uint8_t*)p - HEADER_SIZE;
+	stats.frees++;
+	stats.liveBytes -= *(size_t*)block;
+	free( block );
+}
+
+void* operator new( size_t size ) { return countedAlloc( size ); }
+void* operator new[]( size_t size ) { return countedAlloc( size ); }
+void operator delete( void* p ) noexcept { countedFree( p ); }
+void operator delete[]( void* p ) noexcept { countedFree( p ); }
+void operator delete( void* p, size_t ) noexcept { countedFree( p ); }
+void operator delete[]( void* p, size_t ) noexcept { countedFree( p ); }
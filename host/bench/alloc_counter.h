@@ -0,0 +1,37 @@
+// ESP8266 Wordclock
+// Copyright (C) 2016 Thoralt Franz, https://github.com/thoralt
+// also (C) 2021 by Stefan Rinke, https://github.com/sker65
+//
+//  Heap instrumentation for host benchmarks. Linking alloc_counter.cpp replaces the
+//  global operator new/delete and counts allocations, live bytes and the peak of the
+//  live bytes, which is what the ESP8266 heap printout in loop() approximates.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+struct AllocStats {
+	uint64_t allocations;
+	uint64_t frees;
+	uint64_t bytesAllocated;
+	int64_t liveBytes;
+	int64_t peakLiveBytes;
+};
+
+AllocStats allocStats();
+
+// resets the counters, the peak is restarted at the current live byte count
+void allocReset();
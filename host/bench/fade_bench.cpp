@@ -0,0 +1,144 @@
+// ESP8266 Wordclock
+// Copyright (C) 2016 Thoralt Franz, https://github.com/thoralt
+// also (C) 2021 by Stefan Rinke, https://github.com/sker65
+//
+//  Host benchmark for the fade engine. Compares the former step based
+//  LEDMatrix::fade() (copied below) with fadeBuffer() on a full LED buffer, both per
+//  call and for a complete transition at different loop() rates.
+//
+//  usage: fade_bench [iterations]
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "config.h"
+#include "fadeengine.h"
+
+#define BUF_SIZE ( NUM_PIXELS * 3 )
+#define FADE_TIME 1000
+
+static uint8_t current[BUF_SIZE] __attribute__( ( aligned( 4 ) ) );
+static uint8_t start[BUF_SIZE] __attribute__( ( aligned( 4 ) ) );
+static uint8_t target[BUF_SIZE] __attribute__( ( aligned( 4 ) ) );
+
+// former implementation, one step every second call
+static void legacyFade( uint8_t* currentValues, const uint8_t* targetValues ) {
+	static int prescaler = 0;
+	if( ++prescaler < 2 )
+		return;
+	prescaler = 0;
+
+	int delta;
+	for( int i = 0; i < BUF_SIZE; i++ ) {
+		delta = targetValues[i] - currentValues[i];
+		if( delta > 64 )
+			currentValues[i] += 8;
+		else if( delta > 16 )
+			currentValues[i] += 4;
+		else if( delta > 0 )
+			currentValues[i]++;
+		else if( delta < -64 )
+			currentValues[i] -= 8;
+		else if( delta < -16 )
+			currentValues[i] -= 4;
+		else if( delta < 0 )
+			currentValues[i]--;
+	}
+}
+
+static void randomize( uint8_t* buf ) {
+	for( int i = 0; i < BUF_SIZE; i++ )
+		buf[i] = rand() & 0xFF;
+}
+
+// prevents the compiler from dropping the benchmarked loops
+static uint32_t checksum() {
+	uint32_t sum = 0;
+	for( int i = 0; i < BUF_SIZE; i++ )
+		sum += current[i];
+	return sum;
+}
+
+// milliseconds until the legacy fade reaches the target when loop() runs every periodMs
+static int legacyTransitionMs( int periodMs ) {
+	memcpy( current, start, BUF_SIZE );
+	int elapsed = 0;
+	while( memcmp( current, target, BUF_SIZE ) != 0 ) {
+		legacyFade( current, target );
+		elapsed += periodMs;
+	}
+	return elapsed;
+}
+
+// milliseconds until the new fade reaches the target when loop() runs every periodMs
+static int engineTransitionMs( int periodMs ) {
+	int elapsed = 0;
+	uint16_t weight;
+	do {
+		elapsed += periodMs;
+		weight = fadeWeight( FadeEasing::easeOut, elapsed, FADE_TIME );
+		fadeBuffer( current, start, target, BUF_SIZE, weight );
+	} while( weight < FADE_WEIGHT_MAX );
+	return elapsed;
+}
+
+int main( int argc, char** argv ) {
+	int iterations = argc > 1 ? atoi( argv[1] ) : 100000;
+	if( iterations <= 0 )
+		iterations = 100000;
+
+	srand( 1 );
+	randomize( start );
+	randomize( target );
+	uint32_t sum = 0;
+
+	// per call cost, the legacy version only works on every second call
+	memcpy( current, start, BUF_SIZE );
+	auto t0 = std::chrono::steady_clock::now();
+	for( int i = 0; i < iterations; i++ ) {
+		if( ( i & 63 ) == 0 )
+			memcpy( current, start, BUF_SIZE );
+		legacyFade( current, target );
+		sum += current[i % BUF_SIZE];
+	}
+	auto t1 = std::chrono::steady_clock::now();
+	for( int i = 0; i < iterations; i++ ) {
+		fadeBuffer( current, start, target, BUF_SIZE, fadeWeight( FadeEasing::easeOut, i & 1023, FADE_TIME ) );
+		sum += current[i % BUF_SIZE];
+	}
+	auto t2 = std::chrono::steady_clock::now();
+
+	double legacyNs = std::chrono::duration<double, std::nano>( t1 - t0 ).count() / iterations;
+	double engineNs = std::chrono::duration<double, std::nano>( t2 - t1 ).count() / iterations;
+
+	printf( "%d iterations, %d bytes per buffer\n\n", iterations, BUF_SIZE );
+	printf( "%-24s %12s %12s\n", "", "legacy", "engine" );
+	printf( "%-24s %12.1f %12.1f\n", "ns/call", legacyNs, engineNs );
+	printf( "%-24s %12.1f %12.1f\n", "ns/call (working calls)", legacyNs * 2, engineNs );
+
+	// wall clock duration of a full transition depending on the loop() rate
+	static const int periods[] = { 10, 20, 50, 100 };
+	for( int period : periods ) {
+		char label[32];
+		snprintf( label, sizeof( label ), "transition ms @ %d ms", period );
+		printf( "%-24s %12d %12d\n", label, legacyTransitionMs( period ), engineTransitionMs( period ) );
+	}
+
+	sum += checksum();
+	printf( "\nchecksum %u\n", sum );
+	return 0;
+}
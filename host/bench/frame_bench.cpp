@@ -0,0 +1,108 @@
+// ESP8266 Wordclock
+// Copyright (C) 2016 Thoralt Franz, https://github.com/thoralt
+// also (C) 2021 by Stefan Rinke, https://github.com/sker65
+//
+//  Host benchmark for the LED render core. Runs LEDMatrix::process() for every
+//  DisplayMode for a given number of frames and reports CPU time, heap traffic and
+//  blocking delays per frame. The clock advances by the frame period of the mode per
+//  frame like the frame scheduler in loop() does and is placed so that a 5 minute
+//  boundary (and thus a transition) falls into the middle of each run.
+//
+//  usage: frame_bench [frames]
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "alloc_counter.h"
+#include "host_hal.h"
+#include "ledfunctions.h"
+
+static const char* modeNames[] = { "plain",          "fade",           "flyingLettersUp", "flyingLettersDown",
+                                   "explode",        "random",         "matrix",          "heart",
+                                   "fire",           "plasma",         "stars",           "snake",
+                                   "moon",           "red",            "green",           "blue",
+                                   "yellowHourglass", "greenHourglass", "update",          "updateComplete",
+                                   "updateError",    "wifiManager" };
+
+// name of the time over each background, see Config.background
+static const char* backgroundNames[] = { "plain", "plain+matrix", "plain+fire", "plain+plasma", "plain+stars" };
+
+static void runMode( const char* name, DisplayMode mode, int frames ) {
+	// start half a run before 12:05:00 to hit a 5 minute boundary in the middle
+	int period = LEDMatrix::getFramePeriod( mode );
+	int64_t t = ( 12 * 3600 + 5 * 60 ) * 1000LL - (int64_t)frames * period / 2;
+	LED.setTime( ( t / 3600000 ) % 24, ( t / 60000 ) % 60, ( t / 1000 ) % 60, t % 1000 );
+
+	// the first frame is rendered by setMode(), account its heap usage as well
+	allocReset();
+	AllocStats before = allocStats();
+	hostResetDelayTotal();
+	uint32_t sent = LED.getFramesSent();
+	uint32_t skipped = LED.getFramesSkipped();
+	LED.setMode( mode );
+	std::chrono::nanoseconds elapsed( 0 );
+
+	for( int i = 0; i < frames; i++ ) {
+		hostAdvanceMicros( period * 1000 );
+		t += period;
+		Config.hourglassState = ( t / 100 ) % HOURGLASS_ANIMATION_FRAMES;
+		Config.updateProgress = i * 110 / frames;
+		LED.setTime( ( t / 3600000 ) % 24, ( t / 60000 ) % 60, ( t / 1000 ) % 60, t % 1000 );
+
+		auto start = std::chrono::steady_clock::now();
+		LED.process();
+		elapsed += std::chrono::steady_clock::now() - start;
+	}
+
+	AllocStats after = allocStats();
+	sent = LED.getFramesSent() - sent;
+	skipped = LED.getFramesSkipped() - skipped;
+	printf( "%-18s %9d %12.0f %12.2f %12.1f %12lld %12.2f %8.1f\n", name, period, (double)elapsed.count() / frames,
+	        (double)( after.allocations - before.allocations ) / frames,
+	        (double)( after.bytesAllocated - before.bytesAllocated ) / frames,
+	        (long long)( after.peakLiveBytes - before.liveBytes ), (double)hostDelayTotal() / frames,
+	        100.0 * sent / ( sent + skipped ) );
+}
+
+int main( int argc, char** argv ) {
+	int frames = argc > 1 ? atoi( argv[1] ) : 1000;
+	if( frames <= 0 )
+		frames = 1000;
+
+	LED.begin( 2 );
+	LED.setBrightness( 256 );
+	LED.setDate( 2021, 3, 28 );
+
+	printf( "%d frames per mode\n\n", frames );
+	printf( "%-18s %9s %12s %12s %12s %12s %12s %8s\n", "mode", "period ms", "ns/frame", "allocs/frame",
+	        "bytes/frame", "peak heap", "delay ms/fr", "sent %" );
+
+	for( int mode = 0; mode < (int)DisplayMode::invalid; mode++ )
+		runMode( modeNames[mode], (DisplayMode)mode, frames );
+
+	// the time composited over the background effects
+	for( int background = 1; background <= MAX_BACKGROUND; background++ ) {
+		Config.background = background;
+		runMode( backgroundNames[background], DisplayMode::plain, frames );
+	}
+	Config.background = 0;
+
+	// night brightness, the output is dithered
+	LED.setBrightness( 64 );
+	runMode( "plain dithered", DisplayMode::plain, frames );
+	runMode( "plasma dithered", DisplayMode::plasma, frames );
+	return 0;
+}
@@ -0,0 +1,177 @@
+// ESP8266 Wordclock
+// Copyright (C) 2016 Thoralt Franz, https://github.com/thoralt
+// also (C) 2021 by Stefan Rinke, https://github.com/sker65
+//
+//  Host benchmark for the framebuffer kernels. Checks every implementation available
+//  on this CPU (SWAR, SSE2, AVX2) against a plain byte wise reference for random
+//  buffers of different lengths and weights, then times each of them on a full LED
+//  buffer. Returns 1 if any implementation differs from the reference.
+//
+//  usage: kernel_bench [iterations]
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "config.h"
+#include "fbkernels.h"
+
+#define BUF_SIZE ( NUM_PIXELS * 3 )
+#define MAX_LEN 512
+
+static uint8_t a[MAX_LEN] __attribute__( ( aligned( 32 ) ) );
+static uint8_t b[MAX_LEN] __attribute__( ( aligned( 32 ) ) );
+static uint8_t expected[MAX_LEN] __attribute__( ( aligned( 32 ) ) );
+static uint8_t actual[MAX_LEN] __attribute__( ( aligned( 32 ) ) );
+
+static const int lengths[] = { 0, 1, 3, 4, 5, 15, 16, 17, 31, 32, 33, 47, 48, 49, 95, 96, 97, BUF_SIZE, MAX_LEN };
+static const uint16_t weights[] = { 0, 1, 2, 64, 127, 128, 129, 200, 255, 256 };
+
+static void randomize( uint8_t* buf, int len ) {
+	for( int i = 0; i < len; i++ ) {
+		// plenty of the saturating cases 0 and 255
+		int r = rand() & 0x1FF;
+		buf[i] = r < 0x40 ? 0 : r < 0x80 ? 255 : r & 0xFF;
+	}
+}
+
+// compares len bytes and the guard bytes behind them, which must stay untouched
+static bool same( const char* kernel, const char* op, int len, uint16_t weight ) {
+	if( memcmp( expected, actual, MAX_LEN ) == 0 )
+		return true;
+	printf( "MISMATCH %s %s len %d weight %d\n", kernel, op, len, weight );
+	return false;
+}
+
+static bool verify( const fb_kernels_t& k ) {
+	bool ok = true;
+	for( int len : lengths ) {
+		for( uint16_t weight : weights ) {
+			randomize( a, MAX_LEN );
+			randomize( b, MAX_LEN );
+			palette_entry color = { a[0], a[1], a[2] };
+
+			memcpy( expected, b, MAX_LEN );
+			memset( expected, 0, len );
+			memcpy( actual, b, MAX_LEN );
+			k.clear( actual, len );
+			ok &= same( k.name, "clear", len, weight );
+
+			memcpy( expected, b, MAX_LEN );
+			for( int i = 0; i < len; i++ )
+				expected[i] = ( &color.r )[i % 3];
+			memcpy( actual, b, MAX_LEN );
+			k.fill( actual, len, color );
+			ok &= same( k.name, "fill", len, weight );
+
+			memcpy( expected, b, MAX_LEN );
+			for( int i = 0; i < len; i++ )
+				expected[i] = ( a[i] * weight ) >> 8;
+			memcpy( actual, b, MAX_LEN );
+			k.scale( actual, a, len, weight );
+			ok &= same( k.name, "scale", len, weight );
+			// in place
+			memcpy( actual, b, MAX_LEN );
+			memcpy( actual, a, len );
+			k.scale( actual, actual, len, weight );
+			ok &= same( k.name, "scale in place", len, weight );
+
+			memcpy( expected, b, MAX_LEN );
+			for( int i = 0; i < len; i++ ) {
+				int distance = ( ( ( a[i] > b[i] ? a[i] - b[i] : b[i] - a[i] ) ) * weight ) >> 8;
+				expected[i] = b[i] <= a[i] ? b[i] + distance : b[i] - distance;
+			}
+			memcpy( actual, b, MAX_LEN );
+			k.lerp( actual, actual, a, len, weight );
+			ok &= same( k.name, "lerp", len, weight );
+
+			memcpy( expected, b, MAX_LEN );
+			for( int i = 0; i < len; i++ )
+				expected[i] = a[i] + b[i] > 255 ? 255 : a[i] + b[i];
+			memcpy( actual, b, MAX_LEN );
+			k.addSat( actual, a, len );
+			ok &= same( k.name, "addSat", len, weight );
+		}
+	}
+	return ok;
+}
+
+// nanoseconds per call of each operation on a full LED buffer
+static void measure( const fb_kernels_t& k, int iterations ) {
+	double ns[5];
+	uint32_t sum = 0;
+	palette_entry color = { 12, 34, 56 };
+	for( int op = 0; op < 5; op++ ) {
+		auto t0 = std::chrono::steady_clock::now();
+		for( int i = 0; i < iterations; i++ ) {
+			uint16_t weight = i & 0xFF;
+			switch( op ) {
+			case 0:
+				k.clear( actual, BUF_SIZE );
+				break;
+			case 1:
+				k.fill( actual, BUF_SIZE, color );
+				break;
+			case 2:
+				k.scale( actual, a, BUF_SIZE, weight );
+				break;
+			case 3:
+				k.lerp( actual, a, b, BUF_SIZE, weight );
+				break;
+			case 4:
+				k.addSat( actual, a, BUF_SIZE );
+				break;
+			}
+			sum += actual[i % BUF_SIZE];
+		}
+		auto t1 = std::chrono::steady_clock::now();
+		ns[op] = std::chrono::duration<double, std::nano>( t1 - t0 ).count() / iterations;
+	}
+	printf( "%-8s %10.1f %10.1f %10.1f %10.1f %10.1f   (checksum %u)\n", k.name, ns[0], ns[1], ns[2], ns[3], ns[4],
+	        sum );
+}
+
+int main( int argc, char** argv ) {
+	int iterations = argc > 1 ? atoi( argv[1] ) : 1000000;
+	if( iterations <= 0 )
+		iterations = 1000000;
+
+	const fb_kernels_t* kernels[3];
+	int count = 0;
+	kernels[count++] = &fbKernelsSwar;
+#if defined( __SSE2__ )
+	kernels[count++] = &fbKernelsSse2;
+#endif
+#if defined( __x86_64__ ) || defined( __i386__ )
+	if( __builtin_cpu_supports( "avx2" ) )
+		kernels[count++] = &fbKernelsAvx2;
+#endif
+
+	srand( 1 );
+	bool ok = true;
+	for( int i = 0; i < count; i++ )
+		ok &= verify( *kernels[i] );
+
+	printf( "%d iterations, %d bytes per buffer, fb...() use %s\n\n", iterations, BUF_SIZE, FB_KERNELS_NAME );
+	printf( "%-8s %10s %10s %10s %10s %10s   ns/call\n", "", "clear", "fill", "scale", "lerp", "addSat" );
+	randomize( a, MAX_LEN );
+	randomize( b, MAX_LEN );
+	for( int i = 0; i < count; i++ )
+		measure( *kernels[i], iterations );
+
+	printf( "\n%s\n", ok ? "all implementations identical" : "implementations differ" );
+	return ok ? 0 : 1;
+}
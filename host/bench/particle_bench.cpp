@@ -0,0 +1,174 @@
+// ESP8266 Wordclock
+// Copyright (C) 2016 Thoralt Franz, https://github.com/thoralt
+// also (C) 2021 by Stefan Rinke, https://github.com/sker65
+//
+//  Host benchmark for the particle kinematics and blending. Compares the former
+//  float Particle (copied below) with the 16.16 fixed point Particle, both limited
+//  to the foreground color and saturating, and with the ParticlePool, per particle
+//  and frame.
+//
+//  usage: particle_bench [frames]
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ledfunctions.h"
+
+#define BUF_SIZE ( NUM_PIXELS * 3 )
+// 16 directions from every pixel of a long time text
+#define NUM_PARTICLES ( 20 * PARTICLE_DIRECTIONS )
+
+// former implementation
+class FloatParticle {
+private:
+	float x, y, vx, vy, x0, y0;
+	int delay;
+
+	float move() {
+		if( this->delay ) {
+			this->delay--;
+			return 0;
+		}
+		this->x += this->vx;
+		this->y += this->vy;
+		float dx = this->x - this->x0;
+		float dy = this->y - this->y0;
+		float d = sqrt( dx * dx + dy * dy );
+		if( d > MAX_PARTICLE_DISTANCE )
+			this->alive = false;
+		return d;
+	}
+
+public:
+	bool alive;
+
+	void init( float x, float y, float vx, float vy, int delay ) {
+		this->x = this->x0 = x;
+		this->y = this->y0 = y;
+		this->vx = vx;
+		this->vy = vy;
+		this->delay = delay;
+		this->alive = true;
+	}
+
+	void render( uint8_t* target, palette_entry palette[] ) {
+		static const float gradient[MAX_PARTICLE_DISTANCE] = { 1, 0.75, 0.5, 0.25, 0.125, 0.06, 0.03, 0.01 };
+		int d = (int)this->move();
+		if( this->x < 0 || this->x >= LEDMatrix::width )
+			return;
+		if( this->y < 0 || this->y >= LEDMatrix::height )
+			return;
+		if( d >= MAX_PARTICLE_DISTANCE )
+			d = MAX_PARTICLE_DISTANCE - 1;
+
+		float pr = (float)palette[1].r;
+		float pg = (float)palette[1].g;
+		float pb = (float)palette[1].b;
+		int ofs = LEDMatrix::getOffset( this->x, this->y );
+		float r = (float)target[ofs + 0] + pr * gradient[d];
+		float g = (float)target[ofs + 1] + pg * gradient[d];
+		float b = (float)target[ofs + 2] + pb * gradient[d];
+		if( r > pr )
+			r = pr;
+		if( g > pg )
+			g = pg;
+		if( b > pb )
+			b = pb;
+		target[ofs + 0] = r;
+		target[ofs + 1] = g;
+		target[ofs + 2] = b;
+	}
+};
+
+static uint8_t target[BUF_SIZE];
+static palette_entry palette[3] = { { 0, 0, 0 }, { 255, 160, 40 }, { 0, 0, 0 } };
+static FloatParticle floatParticles[NUM_PARTICLES];
+static Particle* fixedParticles[NUM_PARTICLES];
+static ParticlePool pool;
+static uint32_t sum = 0;
+
+static int originX( int i ) { return ( i / PARTICLE_DIRECTIONS ) % LEDMatrix::width; }
+static int originY( int i ) { return ( i / PARTICLE_DIRECTIONS ) * 3 % LEDMatrix::height; }
+
+// restarts all particles, staggered so that some are always moving
+static void reset() {
+	particle_directions_t directions = generateParticleDirections();
+	pool.clear();
+	for( int i = 0; i < NUM_PARTICLES; i++ ) {
+		int dir = i % PARTICLE_DIRECTIONS;
+		int delay = ( i / PARTICLE_DIRECTIONS ) * 2;
+		float angle = dir * 2.0f * 3.141592654f / PARTICLE_DIRECTIONS;
+		floatParticles[i].init( originX( i ), originY( i ), 0.15f * sin( angle ), 0.15f * cos( angle ), delay );
+		fixedParticles[i]->init( originX( i ) << 16, originY( i ) << 16, directions.vx[dir], directions.vy[dir],
+		                         delay );
+		pool.add( originX( i ), originY( i ), dir, delay );
+	}
+}
+
+template <typename F> static double measure( int frames, F renderFrame ) {
+	reset();
+	auto t0 = std::chrono::steady_clock::now();
+	for( int f = 0; f < frames; f++ ) {
+		if( f % 100 == 0 )
+			reset();
+		memset( target, 0, BUF_SIZE );
+		renderFrame();
+		// prevents the compiler from dropping the benchmarked loops
+		sum += target[f % BUF_SIZE];
+	}
+	auto t1 = std::chrono::steady_clock::now();
+	return std::chrono::duration<double, std::nano>( t1 - t0 ).count() / frames / NUM_PARTICLES;
+}
+
+int main( int argc, char** argv ) {
+	int frames = argc > 1 ? atoi( argv[1] ) : 100000;
+	if( frames <= 0 )
+		frames = 100000;
+
+	for( int i = 0; i < NUM_PARTICLES; i++ )
+		fixedParticles[i] = new Particle( 0, 0, 0, 0, 0 );
+
+	double floatNs = measure( frames, [] {
+		for( FloatParticle& p : floatParticles )
+			if( p.alive )
+				p.render( target, palette );
+	} );
+	double fixedNs = measure( frames, [] {
+		for( Particle* p : fixedParticles )
+			if( p->alive )
+				p->render( target, palette );
+	} );
+	double addNs = measure( frames, [] {
+		for( Particle* p : fixedParticles )
+			if( p->alive )
+				p->renderAdd( target, palette[1] );
+	} );
+	double poolNs = measure( frames, [] { pool.render( target, palette[1] ); } );
+
+	printf( "%d frames, %d particles\n\n", frames, NUM_PARTICLES );
+	printf( "%-34s %12s\n", "", "ns/particle" );
+	printf( "%-34s %12.2f\n", "float Particle::render", floatNs );
+	printf( "%-34s %12.2f\n", "fixed Particle::render", fixedNs );
+	printf( "%-34s %12.2f\n", "fixed Particle::renderAdd", addNs );
+	printf( "%-34s %12.2f\n", "ParticlePool::render", poolNs );
+	printf( "\nchecksum %u\n", sum );
+
+	for( int i = 0; i < NUM_PARTICLES; i++ )
+		delete fixedParticles[i];
+	return 0;
+}
@@ -0,0 +1,149 @@
+// ESP8266 Wordclock
+// Copyright (C) 2016 Thoralt Franz, https://github.com/thoralt
+// also (C) 2021 by Stefan Rinke, https://github.com/sker65
+//
+//  Host (Linux) hardware abstraction. Implements the Arduino functions declared in
+//  host/include/Arduino.h on top of a virtual clock and a deterministic random
+//  number generator, so the LED render core can be built and benchmarked natively.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#include <Arduino.h>
+#include <EEPROM.h>
+#include <chrono>
+
+#include "host_hal.h"
+#include "ledfunctions.h"
+
+//---------------------------------------------------------------------------------------
+// global instances
+//---------------------------------------------------------------------------------------
+HardwareSerial Serial;
+EEPROMClass EEPROM;
+EspClass ESP;
+
+static uint64_t virtualMicros = 0;
+static uint64_t delayTotal = 0;
+static uint32_t randomState = 0x2545F491;
+static bool serialEnabled = false;
+
+//---------------------------------------------------------------------------------------
+// virtual clock
+//---------------------------------------------------------------------------------------
+void hostAdvanceMicros( uint64_t us ) { virtualMicros += us; }
+void hostSetMillis( uint64_t ms ) { virtualMicros = ms * 1000; }
+uint64_t hostMicros() { return virtualMicros; }
+uint64_t hostDelayTotal() { return delayTotal; }
+void hostResetDelayTotal() { delayTotal = 0; }
+void hostSerialEnable( bool enable ) { serialEnabled = enable; }
+
+//---------------------------------------------------------------------------------------
+// recording output
+//---------------------------------------------------------------------------------------
+RecordingOutput* hostRecorder() { return (RecordingOutput*)LED.getOutput(); }
+const uint8_t* recordedFrame() { return hostRecorder()->getFrame(); }
+
+unsigned long millis() { return (unsigned long)( virtualMicros / 1000 ); }
+unsigned long micros() { return (unsigned long)virtualMicros; }
+void yield() {}
+
+uint32_t EspClass::getCycleCount() {
+	return (uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+	           std::chrono::steady_clock::now().time_since_epoch() )
+	    .count();
+}
+
+//---------------------------------------------------------------------------------------
+// delay
+//
+// Does not sleep, advances the virtual clock and accounts the blocked time instead
+//
+// -> ms: time to wait in milliseconds
+// <- --
+//---------------------------------------------------------------------------------------
+void delay( unsigned long ms ) {
+	virtualMicros += (uint64_t)ms * 1000;
+	delayTotal += ms;
+}
+
+//---------------------------------------------------------------------------------------
+// random
+//
+// Deterministic xorshift32 generator, same sequence on every run
+//
+// -> min, max: range of the result [min...max-1]
+// <- random number
+//---------------------------------------------------------------------------------------
+static uint32_t nextRandom() {
+	uint32_t x = randomState;
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	randomState = x;
+	return x;
+}
+
+long random( long max ) {
+	if( max <= 0 )
+		return 0;
+	return nextRandom() % (uint32_t)max;
+}
+
+long random( long min, long max ) {
+	if( min >= max )
+		return min;
+	return min + random( max - min );
+}
+
+void randomSeed( unsigned long seed ) { randomState = seed ? (uint32_t)seed : 0x2545F491; }
+
+//---------------------------------------------------------------------------------------
+// pins
+//---------------------------------------------------------------------------------------
+void pinMode( uint8_t pin, uint8_t mode ) {
+	(void)pin;
+	(void)mode;
+}
+
+void digitalWrite( uint8_t pin, uint8_t val ) {
+	(void)pin;
+	(void)val;
+}
+
+int analogRead( uint8_t pin ) {
+	(void)pin;
+	return 1023;
+}
+
+//---------------------------------------------------------------------------------------
+// HardwareSerial
+//---------------------------------------------------------------------------------------
+int HardwareSerial::printf( const char* format, ... ) {
+	if( !serialEnabled )
+		return 0;
+	va_list args;
+	va_start( args, format );
+	int result = vprintf( format, args );
+	va_end( args );
+	return result;
+}
+
+size_t HardwareSerial::print( const char* s ) { return serialEnabled ? ::printf( "%s", s ) : 0; }
+size_t HardwareSerial::print( char c ) { return serialEnabled ? ::printf( "%c", c ) : 0; }
+size_t HardwareSerial::print( unsigned char n ) { return serialEnabled ? ::printf( "%u", n ) : 0; }
+size_t HardwareSerial::print( int n ) { return serialEnabled ? ::printf( "%d", n ) : 0; }
+size_t HardwareSerial::print( unsigned int n ) { return serialEnabled ? ::printf( "%u", n ) : 0; }
+size_t HardwareSerial::print( long n ) { return serialEnabled ? ::printf( "%ld", n ) : 0; }
+size_t HardwareSerial::print( unsigned long n ) { return serialEnabled ? ::printf( "%lu", n ) : 0; }
+size_t HardwareSerial::print( double n ) { return serialEnabled ? ::printf( "%.2f", n ) : 0; }
+size_t HardwareSerial::println() { return serialEnabled ? ::printf( "\r\n" ) : 0; }
@@ -0,0 +1,99 @@
+// ESP8266 Wordclock
+// Copyright (C) 2016 Thoralt Franz, https://github.com/thoralt
+// also (C) 2021 by Stefan Rinke, https://github.com/sker65
+//
+//  Host (Linux) replacement for the parts of the Arduino core used by the LED
+//  render core. Only compiled into the host build, see CMakeLists.txt and
+//  host/hal.cpp for the implementation.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#pragma once
+
+#include <math.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+
+#include <algorithm>
+
+// flash attributes have no meaning on the host, everything lives in RAM
+#define PROGMEM
+#define ICACHE_RAM_ATTR
+#define IRAM_ATTR
+#define pgm_read_byte( addr ) ( *(const uint8_t*)( addr ) )
+#define pgm_read_word( addr ) ( *(const uint16_t*)( addr ) )
+#define pgm_read_dword( addr ) ( *(const uint32_t*)( addr ) )
+
+#define LOW 0
+#define HIGH 1
+#define OUTPUT 1
+#define INPUT 0
+#define A0 17
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+long random( long max );
+long random( long min, long max );
+void randomSeed( unsigned long seed );
+void delay( unsigned long ms );
+unsigned long millis();
+unsigned long micros();
+void yield();
+void pinMode( uint8_t pin, uint8_t mode );
+void digitalWrite( uint8_t pin, uint8_t val );
+int analogRead( uint8_t pin );
+
+//---------------------------------------------------------------------------------------
+// HardwareSerial
+//
+// Minimal serial port replacement, output goes to stdout if enabled with
+// hostSerialEnable() (see host_hal.h), otherwise it is discarded.
+//---------------------------------------------------------------------------------------
+class HardwareSerial {
+public:
+	void begin( unsigned long baud ) { (void)baud; }
+	int printf( const char* format, ... ) __attribute__( ( format( printf, 2, 3 ) ) );
+	size_t print( const char* s );
+	size_t print( char c );
+	size_t print( unsigned char n );
+	size_t print( int n );
+	size_t print( unsigned int n );
+	size_t print( long n );
+	size_t print( unsigned long n );
+	size_t print( double n );
+	size_t println();
+	template <typename T> size_t println( T value ) { return this->print( value ) + this->println(); }
+	int available() { return 0; }
+	int read() { return -1; }
+};
+
+extern HardwareSerial Serial;
+
+//---------------------------------------------------------------------------------------
+// EspClass
+//
+// Only the cycle counter, it counts real time in nanoseconds (a 1 GHz CPU) on the host
+// independent of the virtual clock, so it measures the actual CPU cost of code.
+//---------------------------------------------------------------------------------------
+class EspClass {
+public:
+	uint32_t getCycleCount();
+};
+
+extern EspClass ESP;
@@ -0,0 +1,39 @@
+// ESP8266 Wordclock
+// Copyright (C) 2016 Thoralt Franz, https://github.com/thoralt
+// also (C) 2021 by Stefan Rinke, https://github.com/sker65
+//
+//  Host (Linux) replacement for the ESP8266 EEPROM emulation, backed by RAM.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+class EEPROMClass {
+public:
+	void begin( size_t size ) { (void)size; }
+	uint8_t read( int address ) { return ( address >= 0 && address < SIZE ) ? this->data[address] : 0; }
+	void write( int address, uint8_t value ) {
+		if( address >= 0 && address < SIZE )
+			this->data[address] = value;
+	}
+	bool commit() { return true; }
+
+private:
+	static const int SIZE = 4096;
+	uint8_t data[SIZE] = {};
+};
+
+extern EEPROMClass EEPROM;
@@ -0,0 +1,38 @@
+// ESP8266 Wordclock
+// Copyright (C) 2016 Thoralt Franz, https://github.com/thoralt
+// also (C) 2021 by Stefan Rinke, https://github.com/sker65
+//
+//  Host (Linux) replacement for the Arduino IPAddress class, just enough for
+//  config.h/config.cpp.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#pragma once
+
+#include <stdint.h>
+
+class IPAddress {
+public:
+	IPAddress() {}
+	IPAddress( uint8_t a, uint8_t b, uint8_t c, uint8_t d ) {
+		this->bytes[0] = a;
+		this->bytes[1] = b;
+		this->bytes[2] = c;
+		this->bytes[3] = d;
+	}
+	uint8_t operator[]( int index ) const { return this->bytes[index]; }
+	uint8_t& operator[]( int index ) { return this->bytes[index]; }
+
+private:
+	uint8_t bytes[4] = { 0, 0, 0, 0 };
+};
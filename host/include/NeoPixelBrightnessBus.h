@@ -0,0 +1,6 @@
+// ESP8266 Wordclock
+// Host (Linux) build: ledfunctions.h includes this NeoPixelBus header, the host
+// replacement in NeoPixelBus.h covers everything that is actually used.
+#pragma once
+
+#include <NeoPixelBus.h>
@@ -0,0 +1,156 @@
+// ESP8266 Wordclock
+// Copyright (C) 2016 Thoralt Franz, https://github.com/thoralt
+// also (C) 2021 by Stefan Rinke, https://github.com/sker65
+//
+//  Host (Linux) replacement for the subset of NeoPixelBus used by the LED module.
+//  Pixel storage, color features and dirty handling follow the original library,
+//  Show() does not drive any hardware but copies the pixel buffer to a "wire"
+//  buffer and counts the transfers so tests and benchmarks can inspect them.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#pragma once
+
+#include <Arduino.h>
+
+struct HsbColor {
+	HsbColor( float h, float s, float b ) : H( h ), S( s ), B( b ) {}
+	float H, S, B;
+};
+
+struct RgbColor {
+	RgbColor() : R( 0 ), G( 0 ), B( 0 ) {}
+	RgbColor( uint8_t r, uint8_t g, uint8_t b ) : R( r ), G( g ), B( b ) {}
+	RgbColor( const HsbColor& color ) {
+		float r, g, b;
+		float h = color.H;
+		float s = color.S;
+		float v = color.B;
+
+		if( s == 0.0f ) {
+			r = g = b = v;
+		} else {
+			if( h < 0.0f )
+				h += 1.0f;
+			else if( h >= 1.0f )
+				h -= 1.0f;
+			h *= 6.0f;
+			int i = (int)h;
+			float f = h - i;
+			float q = v * ( 1.0f - s * f );
+			float p = v * ( 1.0f - s );
+			float t = v * ( 1.0f - s * ( 1.0f - f ) );
+			switch( i ) {
+			case 0:
+				r = v, g = t, b = p;
+				break;
+			case 1:
+				r = q, g = v, b = p;
+				break;
+			case 2:
+				r = p, g = v, b = t;
+				break;
+			case 3:
+				r = p, g = q, b = v;
+				break;
+			case 4:
+				r = t, g = p, b = v;
+				break;
+			default:
+				r = v, g = p, b = q;
+				break;
+			}
+		}
+		R = (uint8_t)( r * 255.0f );
+		G = (uint8_t)( g * 255.0f );
+		B = (uint8_t)( b * 255.0f );
+	}
+	uint8_t R, G, B;
+};
+
+class NeoGrbFeature {
+public:
+	static const size_t PixelSize = 3;
+	static void applyPixelColor( uint8_t* pixels, uint16_t indexPixel, RgbColor color ) {
+		uint8_t* p = pixels + indexPixel * PixelSize;
+		*p++ = color.G;
+		*p++ = color.R;
+		*p = color.B;
+	}
+	static RgbColor retrievePixelColor( const uint8_t* pixels, uint16_t indexPixel ) {
+		const uint8_t* p = pixels + indexPixel * PixelSize;
+		return RgbColor( p[1], p[0], p[2] );
+	}
+};
+
+// output methods only exist as tags on the host
+class NeoEsp8266Dma800KbpsMethod {};
+class NeoEsp8266Uart1800KbpsMethod {};
+class NeoEsp8266BitBang800KbpsMethod {};
+
+template <typename T_COLOR_FEATURE, typename T_METHOD> class NeoPixelBus {
+public:
+	NeoPixelBus( uint16_t countPixels, uint8_t pin = 3 ) : countPixels( countPixels ) {
+		(void)pin;
+		this->pixels = new uint8_t[this->PixelsSize()]();
+		this->wire = new uint8_t[this->PixelsSize()]();
+	}
+	~NeoPixelBus() {
+		delete[] this->pixels;
+		delete[] this->wire;
+	}
+
+	void Begin() { this->Dirty(); }
+
+	void Show( bool maintainBufferConsistency = true ) {
+		(void)maintainBufferConsistency;
+		if( !this->IsDirty() )
+			return;
+		memcpy( this->wire, this->pixels, this->PixelsSize() );
+		this->showCount++;
+		this->ResetDirty();
+	}
+
+	bool CanShow() const { return true; }
+	bool IsDirty() const { return this->dirty; }
+	void Dirty() { this->dirty = true; }
+	void ResetDirty() { this->dirty = false; }
+	uint8_t* Pixels() { return this->pixels; }
+	size_t PixelsSize() const { return this->countPixels * T_COLOR_FEATURE::PixelSize; }
+	size_t PixelSize() const { return T_COLOR_FEATURE::PixelSize; }
+	uint16_t PixelCount() const { return this->countPixels; }
+
+	void SetPixelColor( uint16_t indexPixel, RgbColor color ) {
+		if( indexPixel < this->countPixels ) {
+			T_COLOR_FEATURE::applyPixelColor( this->pixels, indexPixel, color );
+			this->Dirty();
+		}
+	}
+
+	RgbColor GetPixelColor( uint16_t indexPixel ) const {
+		if( indexPixel < this->countPixels )
+			return T_COLOR_FEATURE::retrievePixelColor( this->pixels, indexPixel );
+		return RgbColor( 0, 0, 0 );
+	}
+
+	// host only: data of the last transfer and number of transfers
+	const uint8_t* Wire() const { return this->wire; }
+	uint32_t ShowCount() const { return this->showCount; }
+
+private:
+	uint16_t countPixels;
+	uint8_t* pixels;
+	uint8_t* wire;
+	bool dirty = false;
+	uint32_t showCount = 0;
+};
@@ -0,0 +1,42 @@
+// ESP8266 Wordclock
+// Copyright (C) 2016 Thoralt Franz, https://github.com/thoralt
+// also (C) 2021 by Stefan Rinke, https://github.com/sker65
+//
+//  Controls for the host (Linux) hardware abstraction. The host build runs on a
+//  virtual clock: millis()/micros() only advance when the caller advances them or
+//  when code under test calls delay(). This keeps benchmarks and tests
+//  deterministic and lets them account blocking delays separately from CPU time.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#pragma once
+
+#include <stdint.h>
+
+// virtual clock
+void hostAdvanceMicros( uint64_t us );
+void hostSetMillis( uint64_t ms );
+uint64_t hostMicros();
+
+// sum of all delay() calls since the last reset, in milliseconds
+uint64_t hostDelayTotal();
+void hostResetDelayTotal();
+
+// enables/disables Serial output to stdout (disabled by default)
+void hostSerialEnable( bool enable );
+
+// output of LED while Config.ledOutput is the recorder, and the last frame it sent
+// (LED_BUFFER_SIZE bytes in wire order)
+class RecordingOutput;
+RecordingOutput* hostRecorder();
+const uint8_t* recordedFrame();
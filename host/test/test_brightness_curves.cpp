@@ -0,0 +1,185 @@
+// ESP8266 Wordclock
+// Copyright (C) 2016 Thoralt Franz, https://github.com/thoralt
+// also (C) 2021 by Stefan Rinke, https://github.com/sker65
+//
+//  Host test for the compile time generated brightness correction curves. The
+//  reference tables below are the hand written uint32_t tables the firmware used
+//  before brightnesscurves.h, the generated curves must match them bit by bit.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#include <stdio.h>
+
+#include "brightnesscurves.h"
+#include "testing.h"
+
+// clang-format off
+static const uint8_t legacyCurvesR[256 * 2] = {
+	// LED type 1, 1:1 mapping (neutral)
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19,
+	20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36,
+	37, 38, 39, 40, 41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, 52, 53,
+	54, 55, 56, 57, 58, 59, 60, 61, 62, 63, 64, 65, 66, 67, 68, 69, 70,
+	71, 72, 73, 74, 75, 76, 77, 78, 79, 80, 81, 82, 83, 84, 85, 86, 87,
+	88, 89, 90, 91, 92, 93, 94, 95, 96, 97, 98, 99, 100, 101, 102, 103,
+	104, 105, 106, 107, 108, 109, 110, 111, 112, 113, 114, 115, 116,
+	117, 118, 119, 120, 121, 122, 123, 124, 125, 126, 127, 128, 129,
+	130, 131, 132, 133, 134, 135, 136, 137, 138, 139, 140, 141, 142,
+	143, 144, 145, 146, 147, 148, 149, 150, 151, 152, 153, 154, 155,
+	156, 157, 158, 159, 160, 161, 162, 163, 164, 165, 166, 167, 168,
+	169, 170, 171, 172, 173, 174, 175, 176, 177, 178, 179, 180, 181,
+	182, 183, 184, 185, 186, 187, 188, 189, 190, 191, 192, 193, 194,
+	195, 196, 197, 198, 199, 200, 201, 202, 203, 204, 205, 206, 207,
+	208, 209, 210, 211, 212, 213, 214, 215, 216, 217, 218, 219, 220,
+	221, 222, 223, 224, 225, 226, 227, 228, 229, 230, 231, 232, 233,
+	234, 235, 236, 237, 238, 239, 240, 241, 242, 243, 244, 245, 246,
+	247, 248, 249, 250, 251, 252, 253, 254, 255,
+
+	// LED type 2
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 3, 3, 5, 5, 5, 5, 5, 5, 7, 7, 7, 7,
+	7, 7, 9, 9, 9, 9, 11, 11, 11, 11, 13, 13, 13, 13, 15, 15, 15, 15,
+	17, 17, 17, 17, 19, 19, 21, 21, 23, 23, 25, 25, 27, 27, 29, 29, 31,
+	31, 33, 33, 35, 35, 37, 37, 39, 39, 41, 41, 43, 43, 45, 45, 47, 47,
+	49, 49, 50, 50, 53, 53, 53, 53, 55, 55, 57, 57, 59, 59, 61, 61, 63,
+	63, 65, 65, 67, 67, 69, 69, 71, 71, 73, 73, 75, 75, 77, 77, 79, 79,
+	81, 81, 83, 83, 83, 83, 85, 85, 87, 87, 89, 89, 91, 91, 93, 93, 95,
+	95, 97, 97, 99, 99, 101, 101, 103, 103, 105, 105, 107, 107, 109, 109,
+	111, 111, 113, 113, 115, 115, 115, 115, 117, 117, 119, 119, 121, 121,
+	123, 123, 125, 125, 127, 127, 130, 130, 132, 132, 134, 134, 136, 136,
+	138, 138, 140, 140, 142, 142, 144, 144, 144, 144, 146, 146, 148, 148,
+	150, 150, 152, 152, 153, 153, 155, 155, 156, 156, 158, 158, 160, 160,
+	162, 162, 164, 164, 166, 166, 168, 168, 170, 170, 172, 172, 174, 174,
+	176, 176, 178, 178, 180, 180, 182, 182, 184, 184, 184, 184, 186, 186,
+	188, 188, 190, 190, 192, 192, 194, 194, 196, 196, 198, 198, 200, 200,
+	202, 202, 204, 204, 206, 206, 208, 208, 210, 210, 212, 212, 214, 214,
+	216, 216, 218, 218
+};
+
+static const uint8_t legacyCurvesG[256 * 2] = {
+	// LED type 1, 1:1 mapping (neutral)
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19,
+	20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36,
+	37, 38, 39, 40, 41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, 52, 53,
+	54, 55, 56, 57, 58, 59, 60, 61, 62, 63, 64, 65, 66, 67, 68, 69, 70,
+	71, 72, 73, 74, 75, 76, 77, 78, 79, 80, 81, 82, 83, 84, 85, 86, 87,
+	88, 89, 90, 91, 92, 93, 94, 95, 96, 97, 98, 99, 100, 101, 102, 103,
+	104, 105, 106, 107, 108, 109, 110, 111, 112, 113, 114, 115, 116,
+	117, 118, 119, 120, 121, 122, 123, 124, 125, 126, 127, 128, 129,
+	130, 131, 132, 133, 134, 135, 136, 137, 138, 139, 140, 141, 142,
+	143, 144, 145, 146, 147, 148, 149, 150, 151, 152, 153, 154, 155,
+	156, 157, 158, 159, 160, 161, 162, 163, 164, 165, 166, 167, 168,
+	169, 170, 171, 172, 173, 174, 175, 176, 177, 178, 179, 180, 181,
+	182, 183, 184, 185, 186, 187, 188, 189, 190, 191, 192, 193, 194,
+	195, 196, 197, 198, 199, 200, 201, 202, 203, 204, 205, 206, 207,
+	208, 209, 210, 211, 212, 213, 214, 215, 216, 217, 218, 219, 220,
+	221, 222, 223, 224, 225, 226, 227, 228, 229, 230, 231, 232, 233,
+	234, 235, 236, 237, 238, 239, 240, 241, 242, 243, 244, 245, 246,
+	247, 248, 249, 250, 251, 252, 253, 254, 255,
+
+	// LED type 2
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 3, 3, 5, 5, 5, 5, 5, 5, 7, 7, 7, 7, 7,
+	7, 9, 9, 9, 9, 11, 11, 11, 11, 13, 13, 13, 13, 15, 15, 15, 15, 17,
+	17, 17, 17, 19, 19, 21, 21, 23, 23, 25, 25, 27, 27, 29, 29, 31, 31,
+	33, 33, 35, 35, 37, 37, 39, 39, 41, 41, 43, 43, 45, 45, 47, 47, 49,
+	49, 51, 51, 53, 53, 54, 54, 56, 56, 57, 57, 59, 59, 61, 61, 63, 63,
+	66, 66, 68, 68, 70, 70, 72, 72, 74, 74, 76, 76, 78, 78, 80, 80, 80,
+	80, 80, 80, 80, 80, 80, 80, 80, 80, 80, 80, 80, 80, 80, 80, 80, 80,
+	80, 80, 80, 80, 80, 80, 80, 80, 108, 108, 110, 110, 112, 112, 113,
+	113, 116, 116, 117, 117, 119, 119, 122, 122, 124, 124, 126, 126, 127,
+	127, 131, 131, 132, 132, 135, 135, 137, 137, 139, 139, 141, 141, 143,
+	143, 145, 145, 147, 147, 149, 149, 151, 151, 153, 153, 155, 155, 157,
+	157, 159, 159, 160, 160, 163, 163, 165, 165, 167, 167, 169, 169, 171,
+	171, 173, 173, 175, 175, 177, 177, 179, 179, 181, 181, 183, 183, 185,
+	185, 187, 187, 189, 189, 191, 191, 194, 194, 197, 197, 198, 198, 201,
+	201, 203, 203, 205, 205, 208, 208, 210, 210, 212, 212, 215, 215, 218,
+	218, 220, 220, 222, 222, 224, 224, 226, 226, 228, 228, 230, 230, 232,
+	232, 234, 234
+};
+
+static const uint8_t legacyCurvesB[256 * 2] = {
+	// LED type 1, 1:1 mapping (neutral)
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19,
+	20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36,
+	37, 38, 39, 40, 41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, 52, 53,
+	54, 55, 56, 57, 58, 59, 60, 61, 62, 63, 64, 65, 66, 67, 68, 69, 70,
+	71, 72, 73, 74, 75, 76, 77, 78, 79, 80, 81, 82, 83, 84, 85, 86, 87,
+	88, 89, 90, 91, 92, 93, 94, 95, 96, 97, 98, 99, 100, 101, 102, 103,
+	104, 105, 106, 107, 108, 109, 110, 111, 112, 113, 114, 115, 116,
+	117, 118, 119, 120, 121, 122, 123, 124, 125, 126, 127, 128, 129,
+	130, 131, 132, 133, 134, 135, 136, 137, 138, 139, 140, 141, 142,
+	143, 144, 145, 146, 147, 148, 149, 150, 151, 152, 153, 154, 155,
+	156, 157, 158, 159, 160, 161, 162, 163, 164, 165, 166, 167, 168,
+	169, 170, 171, 172, 173, 174, 175, 176, 177, 178, 179, 180, 181,
+	182, 183, 184, 185, 186, 187, 188, 189, 190, 191, 192, 193, 194,
+	195, 196, 197, 198, 199, 200, 201, 202, 203, 204, 205, 206, 207,
+	208, 209, 210, 211, 212, 213, 214, 215, 216, 217, 218, 219, 220,
+	221, 222, 223, 224, 225, 226, 227, 228, 229, 230, 231, 232, 233,
+	234, 235, 236, 237, 238, 239, 240, 241, 242, 243, 244, 245, 246,
+	247, 248, 249, 250, 251, 252, 253, 254, 255,
+
+	// LED type 2
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 3, 3, 5, 5, 5, 5, 5, 5, 7, 7, 7, 7, 9,
+	9, 9, 9, 9, 9, 11, 11, 11, 11, 13, 13, 13, 13, 15, 15, 15, 15, 17,
+	17, 19, 19, 20, 20, 21, 21, 23, 23, 25, 25, 27, 27, 29, 29, 31, 31,
+	33, 33, 35, 35, 37, 37, 39, 39, 41, 41, 42, 42, 43, 43, 45, 45, 47,
+	47, 49, 49, 51, 51, 53, 53, 55, 55, 57, 57, 59, 59, 61, 61, 63, 63,
+	64, 64, 66, 66, 68, 68, 72, 72, 72, 72, 74, 74, 76, 76, 78, 78, 80,
+	80, 82, 82, 84, 84, 86, 86, 88, 88, 90, 90, 91, 91, 93, 93, 94, 94,
+	96, 96, 98, 98, 100, 100, 102, 102, 104, 104, 106, 106, 108, 108,
+	110, 110, 112, 112, 114, 114, 116, 116, 118, 118, 119, 119, 121, 121,
+	123, 123, 124, 124, 127, 127, 129, 129, 131, 131, 133, 133, 135, 137,
+	137, 139, 139, 141, 141, 143, 143, 145, 145, 147, 147, 149, 149, 151,
+	151, 153, 153, 155, 155, 157, 157, 160, 160, 161, 161, 163, 163, 166,
+	166, 168, 168, 170, 170, 171, 171, 174, 174, 176, 176, 178, 178, 180,
+	180, 183, 183, 184, 184, 187, 187, 188, 188, 191, 191, 194, 194, 196,
+	196, 198, 198, 200, 200, 202, 202, 204, 204, 206, 206, 209, 209, 210,
+	210, 212, 212, 215, 215, 217, 217, 219, 219, 222, 222, 224, 224, 226,
+	226, 228, 228, 230
+};
+// clang-format on
+
+static const uint8_t* legacyCurves[3] = { legacyCurvesR, legacyCurvesG, legacyCurvesB };
+
+// the tables are generated by the compiler, a mistake in the constexpr code fails the build
+static constexpr curve_table_t<NUM_BRIGHTNESS_CURVES> curves = generateBrightnessCurves( ledCurveTypes );
+
+static void testLegacyTables() {
+	CHECK( NUM_BRIGHTNESS_CURVES == 2 );
+	for( int ch = 0; ch < 3; ch++ )
+		for( int i = 0; i < 256 * 2; i++ )
+			CHECK_EQUAL( legacyCurves[ch][i], curves.values[ch][i] );
+}
+
+static void testParametricCurve() {
+	// gamma 2.2 with white balance, as documented in brightnesscurves.h
+	static constexpr led_curve_params_t types[] = {
+	    { 12, 2.2, { 1.0, 0.85, 0.8 }, { NULL, NULL, NULL }, { 0, 0, 0 }, 1 } };
+	static constexpr curve_table_t<1> t = generateBrightnessCurves( types );
+
+	for( int ch = 0; ch < 3; ch++ ) {
+		CHECK_EQUAL( 0, t.values[ch][11] );
+		for( int i = 1; i < 256; i++ )
+			CHECK( t.values[ch][i] >= t.values[ch][i - 1] );
+	}
+	CHECK_EQUAL( 255, t.values[0][255] );
+	CHECK_EQUAL( 217, t.values[1][255] );
+	CHECK_EQUAL( 204, t.values[2][255] );
+	// 255 * (128 / 255) ^ 2.2 = 56.0
+	CHECK_EQUAL( 56, t.values[0][128] );
+}
+
+int main() {
+	testLegacyTables();
+	testParametricCurve();
+	return testResult();
+}
@@ -0,0 +1,143 @@
+// ESP8266 Wordclock
+// Copyright (C) 2016 Thoralt Franz, https://github.com/thoralt
+// also (C) 2021 by Stefan Rinke, https://github.com/sker65
+//
+//  Host test for the layer compositor: the blend modes at their limits, layer order,
+//  pixel ranges and masks, compositing in place and the time over a background effect
+//  through LEDMatrix.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#include <string.h>
+
+#include "host_hal.h"
+#include "ledfunctions.h"
+#include "testing.h"
+
+#define BUF_SIZE ( NUM_PIXELS * 3 )
+
+static int blendOne( int d, int s, int alpha, BlendMode mode ) {
+	uint8_t dst[3] = { (uint8_t)d, (uint8_t)d, (uint8_t)d };
+	uint8_t src[3] = { (uint8_t)s, (uint8_t)s, (uint8_t)s };
+	Compositor::blend( dst, src, alpha, mode );
+	CHECK( dst[0] == dst[1] && dst[1] == dst[2] );
+	return dst[0];
+}
+
+static void testBlend() {
+	for( int d = 0; d < 256; d += 15 ) {
+		for( int s = 0; s < 256; s += 15 ) {
+			// alpha 0 keeps the destination for every mode
+			CHECK_EQUAL( d, blendOne( d, s, 0, BlendMode::normal ) );
+			CHECK_EQUAL( d, blendOne( d, s, 0, BlendMode::add ) );
+			CHECK_EQUAL( d, blendOne( d, s, 0, BlendMode::multiply ) );
+			// alpha 255 applies the source completely
+			CHECK_EQUAL( s, blendOne( d, s, 255, BlendMode::normal ) );
+			CHECK_EQUAL( d + s > 255 ? 255 : d + s, blendOne( d, s, 255, BlendMode::add ) );
+			CHECK_EQUAL( ( d * s + 255 ) >> 8, blendOne( d, s, 255, BlendMode::multiply ) );
+		}
+	}
+	CHECK_EQUAL( 255, blendOne( 255, 255, 255, BlendMode::multiply ) );
+	CHECK_EQUAL( 128, blendOne( 0, 255, 128, BlendMode::normal ) );
+	CHECK_EQUAL( 126, blendOne( 255, 0, 128, BlendMode::normal ) );
+}
+
+static void testLayers() {
+	static uint8_t target[BUF_SIZE];
+	PackedBuffer<2> mask;
+	for( int i = 0; i < NUM_PIXELS; i++ )
+		mask.set( i, i % 3 );
+
+	Compositor layers;
+	CHECK( layers.add( { nullptr, { 100, 0, 0 }, nullptr, 0, 0, NUM_PIXELS, 255, BlendMode::normal } ) );
+	CHECK( layers.add( { nullptr, { 0, 50, 0 }, &mask, 1, 0, NUM_PIXELS, 255, BlendMode::add } ) );
+	CHECK( layers.add( { nullptr, { 0, 0, 200 }, &mask, 2, 10, 20, 255, BlendMode::normal } ) );
+	layers.render( target );
+	for( int i = 0; i < NUM_PIXELS; i++ ) {
+		const uint8_t* p = target + LEDMatrix::getPixelOffset( i );
+		if( mask.get( i ) == 2 && i >= 10 && i < 20 ) {
+			CHECK_EQUAL( 0, p[0] );
+			CHECK_EQUAL( 200, p[2] );
+		} else {
+			CHECK_EQUAL( 100, p[0] );
+			CHECK_EQUAL( mask.get( i ) == 1 ? 50 : 0, p[1] );
+			CHECK_EQUAL( 0, p[2] );
+		}
+	}
+
+	// the stack is limited
+	for( int l = 3; l < MAX_LAYERS; l++ )
+		CHECK( layers.add( { nullptr, { 0, 0, 0 }, nullptr, 0, 0, 0, 255, BlendMode::normal } ) );
+	CHECK( !layers.add( { nullptr, { 0, 0, 0 }, nullptr, 0, 0, 0, 255, BlendMode::normal } ) );
+
+	// a color layer may be composited onto itself
+	for( int i = 0; i < BUF_SIZE; i++ )
+		target[i] = i * 7;
+	layers.clear();
+	layers.add( { target, { 0, 0, 0 }, nullptr, 0, 0, NUM_PIXELS, 255, BlendMode::normal } );
+	layers.add( { nullptr, { 255, 255, 255 }, nullptr, 0, 0, NUM_PIXELS, 255, BlendMode::multiply } );
+	layers.render( target );
+	for( int i = 0; i < BUF_SIZE; i++ )
+		CHECK_EQUAL( (uint8_t)( i * 7 ), target[i] );
+}
+
+static void testTimeOverBackground() {
+	static uint8_t plain[BUF_SIZE];
+	PackedBuffer<2> time;
+	Config.fg = { 255, 255, 255 };
+	Config.bg = { 0, 0, 0 };
+	Config.s = { 0, 0, 0 };
+	Config.background = 0;
+	LED.setTime( 10, 27, 0, 0 );
+	LED.setMode( DisplayMode::plain );
+	memcpy( plain, LED.currentValues, BUF_SIZE );
+
+	// an invisible background leaves the plain time
+	Config.background = 3;
+	Config.backgroundLevel = 0;
+	hostAdvanceMicros( 10000 );
+	LED.process();
+	CHECK( memcmp( plain, LED.currentValues, BUF_SIZE ) == 0 );
+
+	// the words and corners keep their color on top of the plasma
+	Config.backgroundLevel = 255;
+	hostAdvanceMicros( 10000 );
+	LED.process();
+	LED.renderTime( time, 10, 27, 0, 0 );
+	int lit = 0;
+	for( int i = 0; i < NUM_PIXELS; i++ ) {
+		const uint8_t* p = LED.currentValues + LEDMatrix::getPixelOffset( i );
+		if( time.get( i ) == 1 ) {
+			CHECK_EQUAL( 255, p[0] );
+			CHECK_EQUAL( 255, p[1] );
+			CHECK_EQUAL( 255, p[2] );
+		} else if( p[0] | p[1] | p[2] ) {
+			lit++;
+		}
+	}
+	CHECK( lit > 0 );
+
+	// without background the time is plain again
+	Config.background = 0;
+	hostAdvanceMicros( 10000 );
+	LED.process();
+	CHECK( memcmp( plain, LED.currentValues, BUF_SIZE ) == 0 );
+}
+
+int main() {
+	LED.begin( 2 );
+	testBlend();
+	testLayers();
+	testTimeOverBackground();
+	return testResult();
+}
@@ -0,0 +1,99 @@
+// ESP8266 Wordclock
+// Copyright (C) 2016 Thoralt Franz, https://github.com/thoralt
+// also (C) 2021 by Stefan Rinke, https://github.com/sker65
+//
+//  Host test for the crossfade between display modes: the frame of the previous mode
+//  is shown first and blended into the new mode within Config.crossfadeTime, a mode
+//  change during a crossfade continues from the colors shown and crossfadeTime 0
+//  switches immediately.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#include <string.h>
+
+#include "host_hal.h"
+#include "ledfunctions.h"
+#include "testing.h"
+
+static void frames( int count ) {
+	for( int i = 0; i < count; i++ ) {
+		hostAdvanceMicros( 10000 );
+		LED.process();
+	}
+}
+
+static void testCrossfade() {
+	static uint8_t red[LED_BUFFER_SIZE], mid[LED_BUFFER_SIZE], blue[LED_BUFFER_SIZE], before[LED_BUFFER_SIZE];
+	Config.crossfadeTime = 1000;
+	Config.fadeEasing = (uint8_t)FadeEasing::linear;
+
+	LED.setMode( DisplayMode::red );
+	frames( 110 );
+	CHECK( !LED.isCrossfading() );
+	memcpy( red, recordedFrame(), LED_BUFFER_SIZE );
+
+	// the first frame still shows the previous mode
+	LED.setMode( DisplayMode::blue );
+	CHECK( LED.isCrossfading() );
+	CHECK( memcmp( red, recordedFrame(), LED_BUFFER_SIZE ) == 0 );
+
+	frames( 50 );
+	CHECK( LED.isCrossfading() );
+	memcpy( mid, recordedFrame(), LED_BUFFER_SIZE );
+	frames( 60 );
+	CHECK( !LED.isCrossfading() );
+	memcpy( blue, recordedFrame(), LED_BUFFER_SIZE );
+
+	int between = 0;
+	for( int i = 0; i < LED_BUFFER_SIZE; i++ ) {
+		int lo = red[i] < blue[i] ? red[i] : blue[i];
+		int hi = red[i] < blue[i] ? blue[i] : red[i];
+		CHECK( mid[i] >= lo && mid[i] <= hi );
+		if( mid[i] > lo && mid[i] < hi )
+			between++;
+	}
+	CHECK( between > 0 );
+
+	// a mode change during a crossfade starts from the colors shown
+	LED.setMode( DisplayMode::red );
+	frames( 30 );
+	memcpy( before, recordedFrame(), LED_BUFFER_SIZE );
+	LED.setMode( DisplayMode::green );
+	CHECK( memcmp( before, recordedFrame(), LED_BUFFER_SIZE ) == 0 );
+	frames( 110 );
+	CHECK( !LED.isCrossfading() );
+
+	// no crossfade without a mode change
+	LED.setMode( DisplayMode::green );
+	CHECK( !LED.isCrossfading() );
+}
+
+static void testImmediate() {
+	static uint8_t blue[LED_BUFFER_SIZE];
+	Config.crossfadeTime = 0;
+	LED.setMode( DisplayMode::blue );
+	memcpy( blue, recordedFrame(), LED_BUFFER_SIZE );
+	LED.setMode( DisplayMode::red );
+	CHECK( !LED.isCrossfading() );
+	LED.setMode( DisplayMode::blue );
+	CHECK( memcmp( blue, recordedFrame(), LED_BUFFER_SIZE ) == 0 );
+}
+
+int main() {
+	Config.ledOutput = (uint8_t)LedOutputMethod::recorder;
+	LED.begin( 2 );
+	LED.setBrightness( 256 );
+	testCrossfade();
+	testImmediate();
+	return testResult();
+}
@@ -0,0 +1,115 @@
+// ESP8266 Wordclock
+// Copyright (C) 2016 Thoralt Franz, https://github.com/thoralt
+// also (C) 2021 by Stefan Rinke, https://github.com/sker65
+//
+//  Host test for the temporal dithering in LEDMatrix::show(): below
+//  Config.ditherBrightness the output averaged over 2^DITHER_BITS frames is the scaled
+//  value with DITHER_BITS more resolution, refresh() keeps sending dithered frames at
+//  DITHER_FRAME_PERIOD and the output is plain and skipped as before otherwise.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#include <string.h>
+
+#include "host_hal.h"
+#include "ledfunctions.h"
+#include "testing.h"
+
+#define DITHER_FRAMES ( 1 << DITHER_BITS )
+
+// output of the brightness curves at full brightness without dithering
+static void curveOutput( uint8_t* curve ) {
+	Config.ditherBrightness = 0;
+	LED.setBrightness( 256 );
+	LED.show();
+	memcpy( curve, recordedFrame(), LED_BUFFER_SIZE );
+}
+
+static void testAverage() {
+	static uint8_t curve[LED_BUFFER_SIZE];
+	static int sum[LED_BUFFER_SIZE];
+	const int brightness = 77;
+	for( int i = 0; i < NUM_PIXELS * 3; i++ )
+		LED.currentValues[i] = i * 37;
+	curveOutput( curve );
+
+	Config.ditherBrightness = DEFAULT_DITHER_BRIGHTNESS;
+	LED.setBrightness( brightness );
+	CHECK( LED.isDithering() );
+	memset( sum, 0, sizeof( sum ) );
+	uint32_t sent = LED.getFramesSent();
+	LED.show();
+	for( int f = 0; f < DITHER_FRAMES; f++ ) {
+		for( int i = 0; i < LED_BUFFER_SIZE; i++ )
+			sum[i] += recordedFrame()[i];
+		// not before the dither frame period has passed
+		hostAdvanceMicros( DITHER_FRAME_PERIOD * 1000 - 1 );
+		LED.refresh();
+		CHECK_EQUAL( sent + f + 1, LED.getFramesSent() );
+		hostAdvanceMicros( 1 );
+		LED.refresh();
+	}
+	CHECK_EQUAL( sent + DITHER_FRAMES + 1, LED.getFramesSent() );
+
+	int dithered = 0;
+	for( int i = 0; i < LED_BUFFER_SIZE; i++ ) {
+		CHECK_EQUAL( ( curve[i] * brightness ) >> ( 8 - DITHER_BITS ), sum[i] );
+		if( sum[i] % DITHER_FRAMES )
+			dithered++;
+	}
+	CHECK( dithered > 0 );
+}
+
+static void testBright() {
+	static uint8_t curve[LED_BUFFER_SIZE];
+	for( int i = 0; i < NUM_PIXELS * 3; i++ )
+		LED.currentValues[i] = i * 37;
+	curveOutput( curve );
+
+	// at and above Config.ditherBrightness the output is not dithered
+	Config.ditherBrightness = DEFAULT_DITHER_BRIGHTNESS;
+	LED.setBrightness( DEFAULT_DITHER_BRIGHTNESS );
+	CHECK( !LED.isDithering() );
+	LED.show();
+	for( int i = 0; i < LED_BUFFER_SIZE; i++ )
+		CHECK_EQUAL( ( curve[i] * DEFAULT_DITHER_BRIGHTNESS ) >> 8, recordedFrame()[i] );
+	uint32_t sent = LED.getFramesSent();
+	hostAdvanceMicros( DITHER_FRAME_PERIOD * 1000 );
+	LED.refresh();
+	LED.show();
+	CHECK_EQUAL( sent, LED.getFramesSent() );
+}
+
+static void testNothingToDither() {
+	// a black frame has no fraction, it is sent once
+	memset( LED.currentValues, 0, sizeof( LED.currentValues ) );
+	Config.ditherBrightness = DEFAULT_DITHER_BRIGHTNESS;
+	LED.setBrightness( 50 );
+	LED.show();
+	uint32_t sent = LED.getFramesSent();
+	hostAdvanceMicros( DITHER_FRAME_PERIOD * 1000 );
+	LED.refresh();
+	LED.show();
+	CHECK_EQUAL( sent, LED.getFramesSent() );
+	for( int i = 0; i < LED_BUFFER_SIZE; i++ )
+		CHECK_EQUAL( 0, recordedFrame()[i] );
+}
+
+int main() {
+	Config.ledOutput = (uint8_t)LedOutputMethod::recorder;
+	LED.begin( 2 );
+	testAverage();
+	testBright();
+	testNothingToDither();
+	return testResult();
+}
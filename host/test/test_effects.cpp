@@ -0,0 +1,108 @@
+// ESP8266 Wordclock
+// Copyright (C) 2016 Thoralt Franz, https://github.com/thoralt
+// also (C) 2021 by Stefan Rinke, https://github.com/sker65
+//
+//  Host test for the effect registration and the effect arena: one entry per display
+//  mode, reuse of the active effect, replacement on mode changes, effects too large
+//  for an arena and the rendering of some effects through LEDMatrix.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#include <string.h>
+
+#include "host_hal.h"
+#include "ledfunctions.h"
+#include "testing.h"
+
+#define BUF_SIZE ( NUM_PIXELS * 3 )
+
+static void testRegistration() {
+	for( int m = 0; m <= (int)DisplayMode::invalid; m++ ) {
+		const effect_info_t& info = getEffectInfo( (DisplayMode)m );
+		CHECK( info.create != nullptr );
+		bool hourglass = m == (int)DisplayMode::yellowHourglass || m == (int)DisplayMode::greenHourglass;
+		CHECK_EQUAL( hourglass ? 100 : DEFAULT_FRAME_PERIOD, info.framePeriod );
+		bool transition = m == (int)DisplayMode::flyingLettersVerticalUp ||
+		                  m == (int)DisplayMode::flyingLettersVerticalDown || m == (int)DisplayMode::explode ||
+		                  m == (int)DisplayMode::snake;
+		CHECK_EQUAL( transition, info.hasTransition );
+		CHECK( info.size <= EFFECT_ARENA_SIZE );
+		if( info.isBackground )
+			CHECK( info.size <= BACKGROUND_ARENA_SIZE );
+	}
+	for( int b = 1; b <= MAX_BACKGROUND; b++ )
+		CHECK( getEffectInfo( TimeEffect::getBackgroundMode( b ) ).isBackground );
+	CHECK( TimeEffect::getBackgroundMode( 0 ) == DisplayMode::invalid );
+	CHECK( &getEffectInfo( (DisplayMode)100 ) == &getEffectInfo( DisplayMode::invalid ) );
+}
+
+static void testArena() {
+	static EffectArena<EFFECT_ARENA_SIZE> arena;
+	CHECK( arena.current() == nullptr );
+
+	Effect* stars = arena.select( DisplayMode::stars, LED );
+	CHECK( stars != nullptr );
+	CHECK( arena.select( DisplayMode::stars, LED ) == stars );
+	CHECK( arena.currentMode() == DisplayMode::stars );
+
+	// every mode takes the same memory
+	for( int m = 0; m <= (int)DisplayMode::invalid; m++ ) {
+		CHECK( arena.select( (DisplayMode)m, LED ) == stars );
+		CHECK( arena.currentMode() == (DisplayMode)m );
+	}
+
+	arena.release( LED );
+	CHECK( arena.current() == nullptr );
+	CHECK( arena.currentMode() == DisplayMode::invalid );
+
+	// effects larger than the slot are refused
+	static EffectArena<BACKGROUND_ARENA_SIZE> small;
+	CHECK( small.select( DisplayMode::explode, LED ) == nullptr );
+	CHECK( small.current() == nullptr );
+	CHECK( small.select( DisplayMode::matrix, LED ) != nullptr );
+	small.release( LED );
+}
+
+static void testRender() {
+	static uint8_t expected[BUF_SIZE];
+	Config.fg = { 255, 255, 255 };
+	Config.bg = { 0, 0, 0 };
+	Config.s = { 0, 0, 0 };
+	LED.setTime( 10, 25, 0, 0 );
+
+	// test colors
+	LED.setMode( DisplayMode::blue );
+	for( int i = 0; i < BUF_SIZE; i++ )
+		CHECK_EQUAL( i % 3 == 2 ? 32 : 0, LED.currentValues[i] );
+
+	// transitions end with the current time
+	LED.setMode( DisplayMode::plain );
+	memcpy( expected, LED.currentValues, BUF_SIZE );
+	for( DisplayMode m : { DisplayMode::flyingLettersVerticalUp, DisplayMode::flyingLettersVerticalDown,
+	                       DisplayMode::explode, DisplayMode::snake } ) {
+		LED.setMode( m );
+		for( int frame = 0; frame < 3000; frame++ ) {
+			hostAdvanceMicros( 10000 );
+			LED.process();
+		}
+		CHECK( memcmp( expected, LED.currentValues, BUF_SIZE ) == 0 );
+	}
+}
+
+int main() {
+	LED.begin( 2 );
+	testRegistration();
+	testArena();
+	testRender();
+	return testResult();
+}
@@ -0,0 +1,99 @@
+// ESP8266 Wordclock
+// Copyright (C) 2016 Thoralt Franz, https://github.com/thoralt
+// also (C) 2021 by Stefan Rinke, https://github.com/sker65
+//
+//  Host test for the fade engine: SWAR helpers against per byte reference code,
+//  fadeBuffer() against a scalar interpolation and the easing functions.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#include <stdlib.h>
+
+#include "fadeengine.h"
+#include "fbkernels.h"
+#include "testing.h"
+
+#define BUF_SIZE 342
+
+static uint8_t lane( uint32_t x, int i ) { return ( x >> ( i * 8 ) ) & 0xFF; }
+
+static void testSwarHelpers() {
+	// every combination of a and b in each lane, other lanes with edge values
+	for( int a = 0; a < 256; a++ ) {
+		for( int b = 0; b < 256; b++ ) {
+			uint32_t wa = 0xFF00FF00u | a | ( a << 16 );
+			uint32_t wb = 0x00FFFF00u | ( b << 16 ) | b;
+			uint32_t add = swarAddSat8( wa, wb );
+			uint32_t sub = swarSubSat8( wa, wb );
+			for( int i = 0; i < 4; i++ ) {
+				int la = lane( wa, i ), lb = lane( wb, i );
+				CHECK_EQUAL( la + lb > 255 ? 255 : la + lb, lane( add, i ) );
+				CHECK_EQUAL( la - lb < 0 ? 0 : la - lb, lane( sub, i ) );
+			}
+		}
+	}
+
+	for( int w = 0; w <= FADE_WEIGHT_MAX; w++ ) {
+		for( int x = 0; x < 256; x++ ) {
+			uint32_t wx = x * 0x01010101u ^ 0x00FF0000u;
+			uint32_t scaled = swarScale8( wx, w );
+			for( int i = 0; i < 4; i++ )
+				CHECK_EQUAL( ( lane( wx, i ) * w ) >> 8, lane( scaled, i ) );
+		}
+	}
+}
+
+static void testFadeBuffer() {
+	static uint8_t start[BUF_SIZE] __attribute__( ( aligned( 4 ) ) );
+	static uint8_t target[BUF_SIZE] __attribute__( ( aligned( 4 ) ) );
+	static uint8_t current[BUF_SIZE] __attribute__( ( aligned( 4 ) ) );
+
+	srand( 1 );
+	for( int i = 0; i < BUF_SIZE; i++ ) {
+		start[i] = rand() & 0xFF;
+		target[i] = rand() & 0xFF;
+	}
+	for( int w = 0; w <= FADE_WEIGHT_MAX; w++ ) {
+		fadeBuffer( current, start, target, BUF_SIZE, w );
+		for( int i = 0; i < BUF_SIZE; i++ ) {
+			int d = target[i] - start[i];
+			int expected = d >= 0 ? start[i] + ( ( d * w ) >> 8 ) : start[i] - ( ( -d * w ) >> 8 );
+			CHECK_EQUAL( expected, current[i] );
+		}
+	}
+}
+
+static void testFadeWeight() {
+	for( int e = 0; e < (int)FadeEasing::invalid; e++ ) {
+		FadeEasing easing = (FadeEasing)e;
+		CHECK_EQUAL( 0, fadeWeight( easing, 0, 1000 ) );
+		CHECK_EQUAL( FADE_WEIGHT_MAX, fadeWeight( easing, 1000, 1000 ) );
+		CHECK_EQUAL( FADE_WEIGHT_MAX, fadeWeight( easing, 5000, 1000 ) );
+		CHECK_EQUAL( FADE_WEIGHT_MAX, fadeWeight( easing, 0, 0 ) );
+		for( uint32_t t = 1; t <= 1000; t++ ) {
+			CHECK( fadeWeight( easing, t, 1000 ) >= fadeWeight( easing, t - 1, 1000 ) );
+			CHECK( fadeWeight( easing, t, 1000 ) <= FADE_WEIGHT_MAX );
+		}
+	}
+	CHECK_EQUAL( 128, fadeWeight( FadeEasing::linear, 500, 1000 ) );
+	CHECK_EQUAL( 128, fadeWeight( FadeEasing::easeInOut, 500, 1000 ) );
+	CHECK( fadeWeight( FadeEasing::easeIn, 500, 1000 ) < 128 );
+	CHECK( fadeWeight( FadeEasing::easeOut, 500, 1000 ) > 128 );
+}
+
+int main() {
+	testSwarHelpers();
+	testFadeBuffer();
+	testFadeWeight();
+	return testResult();
+}
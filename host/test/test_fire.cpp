@@ -0,0 +1,121 @@
+// ESP8266 Wordclock
+// Copyright (C) 2016 Thoralt Franz, https://github.com/thoralt
+// also (C) 2021 by Stefan Rinke, https://github.com/sker65
+//
+//  Host test for the fire simulation: the table driven diffusion against the former
+//  renderFire() kernel (copied below), the distribution of the hot spots and the
+//  time based stepping.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#include <stdlib.h>
+#include <string.h>
+
+#include "fire.h"
+#include "testing.h"
+
+#define WIDTH FIRE_WIDTH
+#define HEIGHT FIRE_HEIGHT
+
+// former diffusion with clamped neighbour indexes per pixel
+static void legacyDiffuse( uint8_t* fireBuf ) {
+	int y1, y2, l, r;
+	for( int y = 0; y < HEIGHT - 1; y++ ) {
+		y1 = y + 1;
+		if( y1 >= HEIGHT )
+			y1 = HEIGHT - 1;
+		y2 = y + 2;
+		if( y2 >= HEIGHT )
+			y2 = HEIGHT - 1;
+		for( int x = 0; x < WIDTH; x++ ) {
+			l = x - 1;
+			if( l < 0 )
+				l = 0;
+			r = x + 1;
+			if( r >= WIDTH )
+				r = WIDTH - 1;
+			fireBuf[x + y * WIDTH] = ( ( fireBuf[y1 * WIDTH + l] + fireBuf[y1 * WIDTH + x] + fireBuf[y1 * WIDTH + r] +
+			                             fireBuf[y2 * WIDTH + x] ) *
+			                           32 ) /
+			                         129;
+		}
+	}
+}
+
+static void testDiffusion() {
+	// the multiplication matches the division for every possible sum
+	for( uint32_t sum = 0; sum <= 4 * 255; sum++ )
+		CHECK_EQUAL( sum * 32 / 129, ( sum * FIRE_COOLING_Q16 ) >> 16 );
+
+	uint8_t expected[FIRE_CELLS], actual[FIRE_CELLS];
+	srand( 1 );
+	for( int run = 0; run < 1000; run++ ) {
+		for( int i = 0; i < FIRE_CELLS; i++ )
+			expected[i] = actual[i] = ( run & 1 ) ? 255 : rand() & 0xFF;
+		for( int step = 0; step < 5; step++ ) {
+			legacyDiffuse( expected );
+			diffuseFire( actual );
+			CHECK( memcmp( expected, actual, FIRE_CELLS ) == 0 );
+		}
+	}
+}
+
+static void testSeed() {
+	uint8_t heat[FIRE_CELLS];
+	uint32_t rng = 1;
+	int hot = 0, total = 0;
+	uint32_t sum = 0;
+	for( int i = 0; i < 10000; i++ ) {
+		seedFire( heat, rng );
+		for( int x = 0; x < WIDTH; x++ ) {
+			uint8_t v = heat[FIRE_CELLS - WIDTH + x];
+			hot += v != 0;
+			sum += v;
+			total++;
+		}
+	}
+	// about one hot spot in four with a mean temperature of about 128
+	CHECK( hot > total * 23 / 100 && hot < total * 26 / 100 );
+	CHECK( sum / hot > 120 && sum / hot < 136 );
+	CHECK( rng != 0 );
+}
+
+static void testStepping() {
+	uint8_t heat[FIRE_CELLS] = {};
+	uint32_t rng = 1;
+	uint32_t stepMillis = 0;
+
+	// frames every 10 ms: one step per FIRE_STEP_MS
+	int steps = 0;
+	for( uint32_t now = 0; now <= 1000; now += 10 )
+		steps += advanceFire( heat, rng, stepMillis, now );
+	CHECK_EQUAL( 1000 / FIRE_STEP_MS, steps );
+
+	// slow frames catch up with the steps in between
+	steps = 0;
+	for( uint32_t now = 1000 + 250; now <= 2000; now += 250 )
+		steps += advanceFire( heat, rng, stepMillis, now );
+	CHECK_EQUAL( 1000 / FIRE_STEP_MS, steps );
+
+	// a long stall does not run all missed steps
+	CHECK_EQUAL( FIRE_MAX_STEPS, advanceFire( heat, rng, stepMillis, 60000 ) );
+	CHECK_EQUAL( 0, advanceFire( heat, rng, stepMillis, 60000 + FIRE_STEP_MS - 1 ) );
+	CHECK_EQUAL( 1, advanceFire( heat, rng, stepMillis, 60000 + FIRE_STEP_MS ) );
+}
+
+int main() {
+	testDiffusion();
+	testSeed();
+	testStepping();
+	return testResult();
+}
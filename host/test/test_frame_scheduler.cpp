@@ -0,0 +1,89 @@
+// ESP8266 Wordclock
+// Copyright (C) 2016 Thoralt Franz, https://github.com/thoralt
+// also (C) 2021 by Stefan Rinke, https://github.com/sker65
+//
+//  Host test for the deadline based frame scheduler: regular pacing, late and
+//  missed frames, period changes and the wrap around of micros().
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#include "framescheduler.h"
+#include "testing.h"
+
+// calls frameDue() every stepMicros for durationMicros, returns the number of frames
+static int run( FrameSchedulerClass& fs, uint32_t start, uint32_t durationMicros, uint32_t stepMicros,
+                uint32_t periodMs ) {
+	int frames = 0;
+	for( uint32_t d = 0; d < durationMicros; d += stepMicros )
+		if( fs.frameDue( start + d, periodMs ) )
+			frames++;
+	return frames;
+}
+
+static void testPacing() {
+	FrameSchedulerClass fs;
+	// 1 s polled every 100 us at 10 ms per frame
+	CHECK_EQUAL( 100, run( fs, 0, 1000000, 100, 10 ) );
+	CHECK_EQUAL( 0, fs.missedDeadlines );
+	CHECK_EQUAL( 0, fs.jitterMaxMicros );
+
+	// polling every 300 us: frames are up to 200 us late but none is missed
+	fs.reset();
+	CHECK_EQUAL( 100, run( fs, 1000000, 1000000, 300, 10 ) );
+	CHECK_EQUAL( 0, fs.missedDeadlines );
+	CHECK( fs.jitterMaxMicros <= 300 );
+	CHECK( fs.jitterAvgMicros() > 0 );
+}
+
+static void testMissedDeadline() {
+	FrameSchedulerClass fs;
+	CHECK( fs.frameDue( 0, 10 ) );
+	CHECK( !fs.frameDue( 5000, 10 ) );
+	CHECK( fs.frameDue( 10000, 10 ) );
+
+	// loop() blocked for 35 ms: one late frame, no burst of the skipped ones
+	CHECK( fs.frameDue( 55000, 10 ) );
+	CHECK_EQUAL( 1, fs.missedDeadlines );
+	CHECK_EQUAL( 35000, fs.jitterMaxMicros );
+	CHECK( !fs.frameDue( 56000, 10 ) );
+	CHECK( fs.frameDue( 65000, 10 ) );
+	CHECK_EQUAL( 4, fs.frames );
+}
+
+static void testPeriodChange() {
+	FrameSchedulerClass fs;
+	CHECK( fs.frameDue( 0, 100 ) );
+	// switching to a 10 ms mode must not wait for the rest of the 100 ms slot
+	CHECK( fs.frameDue( 20000, 10 ) );
+	CHECK( fs.frameDue( 30000, 10 ) );
+	CHECK_EQUAL( 0, fs.missedDeadlines );
+	// and back to 100 ms
+	CHECK( fs.frameDue( 40000, 100 ) );
+	CHECK( !fs.frameDue( 120000, 100 ) );
+	CHECK( fs.frameDue( 140000, 100 ) );
+}
+
+static void testWrapAround() {
+	FrameSchedulerClass fs;
+	// micros() wraps after 2^32 us
+	CHECK_EQUAL( 10, run( fs, 0xFFFFFFFFu - 49999, 100000, 1000, 10 ) );
+	CHECK_EQUAL( 0, fs.missedDeadlines );
+}
+
+int main() {
+	testPacing();
+	testMissedDeadline();
+	testPeriodChange();
+	testWrapAround();
+	return testResult();
+}
@@ -0,0 +1,108 @@
+// ESP8266 Wordclock
+// Copyright (C) 2016 Thoralt Franz, https://github.com/thoralt
+// also (C) 2021 by Stefan Rinke, https://github.com/sker65
+//
+//  Golden frame test: renders every display mode, the time over each background and
+//  the dithered output for a fixed sequence of frames into the recording output and
+//  compares the digest over all frames sent with the recorded one. A change of the
+//  output of any mode fails here; if it is intended, print the new digests with
+//
+//    test_golden print
+//
+//  and update golden[] below.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#include <stdio.h>
+#include <string.h>
+
+#include "host_hal.h"
+#include "ledfunctions.h"
+#include "testing.h"
+
+#define FRAMES 300
+
+typedef struct _golden_t {
+	const char* name;
+	DisplayMode mode;
+	uint8_t background;
+	int brightness;
+	uint32_t digest;
+} golden_t;
+
+// clang-format off
+static const golden_t golden[] = {
+	{ "plain", DisplayMode::plain, 0, 256, 0x05C589DF },
+	{ "fade", DisplayMode::fade, 0, 256, 0xD3649947 },
+	{ "flyingLettersUp", DisplayMode::flyingLettersVerticalUp, 0, 256, 0x35479D3F },
+	{ "flyingLettersDown", DisplayMode::flyingLettersVerticalDown, 0, 256, 0xC6395C71 },
+	{ "explode", DisplayMode::explode, 0, 256, 0x70D340A0 },
+	{ "matrix", DisplayMode::matrix, 0, 256, 0xC3A7F5DA },
+	{ "heart", DisplayMode::heart, 0, 256, 0x6C424514 },
+	{ "fire", DisplayMode::fire, 0, 256, 0xF8593BB5 },
+	{ "plasma", DisplayMode::plasma, 0, 256, 0xA6E2B214 },
+	{ "stars", DisplayMode::stars, 0, 256, 0xE2D18B60 },
+	{ "snake", DisplayMode::snake, 0, 256, 0x1B98338E },
+	{ "moon", DisplayMode::moon, 0, 256, 0x05EE48A2 },
+	{ "yellowHourglass", DisplayMode::yellowHourglass, 0, 256, 0x9ACEED9B },
+	{ "update", DisplayMode::update, 0, 256, 0xC65393C0 },
+	{ "wifiManager", DisplayMode::wifiManager, 0, 256, 0x0ECEDA95 },
+	{ "plain+matrix", DisplayMode::plain, 1, 256, 0x4A189961 },
+	{ "plain+fire", DisplayMode::plain, 2, 256, 0x44075567 },
+	{ "plain+plasma", DisplayMode::plain, 3, 256, 0x9A919F76 },
+	{ "plain+stars", DisplayMode::plain, 4, 256, 0x1DF824FA },
+	{ "plain dithered", DisplayMode::plain, 0, 64, 0x6B0CEE48 },
+	{ "plasma dithered", DisplayMode::plasma, 0, 64, 0x502628C2 },
+};
+// clang-format on
+
+// runs a mode like loop() does, across a 5 minute boundary, see frame_bench
+static uint32_t render( const golden_t& g ) {
+	Config.background = g.background;
+	LED.setBrightness( g.brightness );
+	int period = LEDMatrix::getFramePeriod( g.mode );
+	int64_t t = ( 12 * 3600 + 5 * 60 ) * 1000LL - (int64_t)FRAMES * period / 2;
+	LED.setTime( ( t / 3600000 ) % 24, ( t / 60000 ) % 60, ( t / 1000 ) % 60, t % 1000 );
+
+	// a fresh recorder, the digest covers this mode only
+	Config.ledOutput = (uint8_t)LedOutputMethod::recorder;
+	LED.setOutput( LedOutputMethod::recorder );
+	LED.setMode( g.mode );
+	for( int i = 0; i < FRAMES; i++ ) {
+		hostAdvanceMicros( period * 1000 );
+		t += period;
+		Config.hourglassState = ( t / 100 ) % HOURGLASS_ANIMATION_FRAMES;
+		Config.updateProgress = i * 110 / FRAMES;
+		LED.setTime( ( t / 3600000 ) % 24, ( t / 60000 ) % 60, ( t / 1000 ) % 60, t % 1000 );
+		LED.process();
+		LED.refresh();
+	}
+	return hostRecorder()->getDigest();
+}
+
+int main( int argc, char** argv ) {
+	bool print = argc > 1 && strcmp( argv[1], "print" ) == 0;
+	Config.ledOutput = (uint8_t)LedOutputMethod::recorder;
+	LED.begin( 2 );
+	LED.setDate( 2021, 3, 28 );
+
+	for( const golden_t& g : golden ) {
+		uint32_t digest = render( g );
+		if( print )
+			printf( "%-18s 0x%08X\n", g.name, digest );
+		else if( digest != g.digest )
+			printf( "%s: digest 0x%08X, expected 0x%08X\n", g.name, digest, g.digest );
+		CHECK( print || digest == g.digest );
+	}
+	return testResult();
+}
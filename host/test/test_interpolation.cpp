@@ -0,0 +1,99 @@
+// ESP8266 Wordclock
+// Copyright (C) 2016 Thoralt Franz, https://github.com/thoralt
+// also (C) 2021 by Stefan Rinke, https://github.com/sker65
+//
+//  Host test for the frame interpolation of simulation effects: render() of an effect
+//  with a simulation period runs once per period, the frames in between are blended
+//  from the last two steps, another mode or a gap restarts with a fresh step and modes
+//  without a simulation period render every frame.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#include <string.h>
+
+#include "host_hal.h"
+#include "ledfunctions.h"
+#include "testing.h"
+
+// every step is 10 brighter than the one before
+class StepEffect : public Effect {
+public:
+	void render( LEDMatrix& led, const effect_frame_t& frame ) override {
+		this->renders++;
+		memset( led.currentValues, this->renders * 10, sizeof( led.currentValues ) );
+	}
+	int renders = 0;
+};
+
+static FrameInterpolator interpolator;
+static const effect_frame_t frame = {};
+
+static bool uniform( int value ) {
+	for( int i = 0; i < NUM_PIXELS * 3; i++ ) {
+		if( LED.currentValues[i] != value )
+			return false;
+	}
+	return true;
+}
+
+static void testSteps() {
+	StepEffect effect;
+	const int period = getEffectInfo( DisplayMode::fire ).simulationPeriod;
+	CHECK_EQUAL( FIRE_STEP_MS, period );
+
+	interpolator.render( &effect, DisplayMode::fire, LED, frame );
+	CHECK_EQUAL( 1, effect.renders );
+	CHECK( uniform( 10 ) );
+
+	// 10 ms frames for one second: one render per period, the frames blend the last two
+	for( int t = 10; t <= 1000; t += 10 ) {
+		hostAdvanceMicros( 10000 );
+		interpolator.render( &effect, DisplayMode::fire, LED, frame );
+		int step = t / period;
+		CHECK_EQUAL( 1 + step, effect.renders );
+		int weight = ( ( t % period ) << 8 ) / period;
+		CHECK( uniform( step == 0 ? 10 : step * 10 + ( ( 10 * weight ) >> 8 ) ) );
+	}
+	CHECK_EQUAL( 11u, interpolator.getSteps() );
+
+	// a gap of two periods restarts with the current state of the effect
+	hostAdvanceMicros( 2 * period * 1000 );
+	interpolator.render( &effect, DisplayMode::fire, LED, frame );
+	CHECK_EQUAL( 12, effect.renders );
+	CHECK( uniform( 12 * 10 ) );
+	CHECK_EQUAL( 1u, interpolator.getSteps() );
+
+	// the next mode starts fresh as well, although the effect has the same address
+	hostAdvanceMicros( 10000 );
+	interpolator.render( &effect, DisplayMode::heart, LED, frame );
+	CHECK_EQUAL( 13, effect.renders );
+	CHECK( uniform( 13 * 10 ) );
+}
+
+static void testUninterpolated() {
+	StepEffect effect;
+	CHECK_EQUAL( 0, getEffectInfo( DisplayMode::plain ).simulationPeriod );
+	for( int i = 1; i <= 5; i++ ) {
+		hostAdvanceMicros( 10000 );
+		interpolator.render( &effect, DisplayMode::plain, LED, frame );
+		CHECK_EQUAL( i, effect.renders );
+		CHECK( uniform( i * 10 ) );
+	}
+}
+
+int main() {
+	LED.begin( 2 );
+	testSteps();
+	testUninterpolated();
+	return testResult();
+}
@@ -0,0 +1,96 @@
+// ESP8266 Wordclock
+// Copyright (C) 2016 Thoralt Franz, https://github.com/thoralt
+// also (C) 2021 by Stefan Rinke, https://github.com/sker65
+//
+//  Host test for the 16 bit color pipeline (built with LED_PIPELINE_16BIT): half way
+//  through a fade or a crossfade every LED shows half of the light of both ends, also
+//  where the blended color would be below the black level of the curve.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#include <stdlib.h>
+#include <string.h>
+
+#include "host_hal.h"
+#include "ledfunctions.h"
+#include "testing.h"
+
+// every byte of mid is half way between a and b, allowing for the truncation
+static bool halfWay( const uint8_t* a, const uint8_t* mid, const uint8_t* b ) {
+	for( int i = 0; i < LED_BUFFER_SIZE; i++ ) {
+		if( abs( 2 * mid[i] - a[i] - b[i] ) > 2 )
+			return false;
+	}
+	return true;
+}
+
+static void testFade() {
+	static uint8_t black[LED_BUFFER_SIZE], mid[LED_BUFFER_SIZE], white[LED_BUFFER_SIZE];
+	// green fades to a value just above the black level
+	palette_entry palette[] = { { 0, 0, 0 }, { 255, 16, 255 }, { 0, 0, 0 } };
+	PackedBuffer<2> buf;
+	Config.fadeTime = 1000;
+
+	buf.fill( 0 );
+	LED.set( buf, palette, true );
+	LED.show();
+	memcpy( black, recordedFrame(), LED_BUFFER_SIZE );
+
+	buf.fill( 1 );
+	LED.set( buf, palette, false );
+	LED.fade();
+	hostAdvanceMicros( 500000 );
+	LED.fade();
+	LED.show();
+	memcpy( mid, recordedFrame(), LED_BUFFER_SIZE );
+	hostAdvanceMicros( 500000 );
+	LED.fade();
+	LED.show();
+	memcpy( white, recordedFrame(), LED_BUFFER_SIZE );
+
+	CHECK( memcmp( black, white, LED_BUFFER_SIZE ) != 0 );
+	CHECK( halfWay( black, mid, white ) );
+}
+
+static void testCrossfade() {
+	static uint8_t red[LED_BUFFER_SIZE], mid[LED_BUFFER_SIZE], blue[LED_BUFFER_SIZE];
+	Config.crossfadeTime = 1000;
+
+	LED.setMode( DisplayMode::red );
+	memcpy( red, recordedFrame(), LED_BUFFER_SIZE );
+	LED.setMode( DisplayMode::blue );
+	for( int i = 0; i < 50; i++ ) {
+		hostAdvanceMicros( 10000 );
+		LED.process();
+	}
+	memcpy( mid, recordedFrame(), LED_BUFFER_SIZE );
+	for( int i = 0; i < 60; i++ ) {
+		hostAdvanceMicros( 10000 );
+		LED.process();
+	}
+	CHECK( !LED.isCrossfading() );
+	memcpy( blue, recordedFrame(), LED_BUFFER_SIZE );
+
+	CHECK( halfWay( red, mid, blue ) );
+}
+
+int main() {
+	Config.ledOutput = (uint8_t)LedOutputMethod::recorder;
+	LED.begin( 2 );
+	LED.setBrightness( 256 );
+	Config.ditherBrightness = 0;
+	Config.fadeEasing = (uint8_t)FadeEasing::linear;
+	testFade();
+	testCrossfade();
+	return testResult();
+}
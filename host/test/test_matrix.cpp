@@ -0,0 +1,110 @@
+// ESP8266 Wordclock
+// Copyright (C) 2016 Thoralt Franz, https://github.com/thoralt
+// also (C) 2021 by Stefan Rinke, https://github.com/sker65
+//
+//  Host test for the matrix rain: compares the level buffer compositing with the
+//  former rendering, which sorted the trails and drew them over each other.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#include <algorithm>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ledfunctions.h"
+#include "testing.h"
+
+#define BUF_SIZE ( NUM_PIXELS * 3 )
+
+// former gradient and rendering
+static const palette_entry legacyGradient[MATRIX_GRADIENT_LENGTH] = {
+    { 255, 255, 255 }, { 128, 255, 128 }, { 64, 255, 64 }, { 0, 255, 0 }, { 0, 128, 0 }, { 0, 64, 0 },
+    { 0, 32, 0 },      { 0, 16, 0 },      { 0, 8, 0 },     { 0, 2, 0 },   { 0, 1, 0 },   { 0, 0, 0 } };
+
+struct Head {
+	int x, y;
+	bool operator<( const Head& other ) const { return other.y < this->y; }
+};
+
+static void legacyRender( uint8_t* buf, const Head& h ) {
+	if( h.x < 0 || h.x >= LEDMatrix::width )
+		return;
+	int currentY = h.y;
+	for( const palette_entry& p : legacyGradient ) {
+		if( currentY >= 0 && currentY < LEDMatrix::height ) {
+			int ofs = LEDMatrix::getOffset( h.x, currentY );
+			buf[ofs + 0] = p.r;
+			buf[ofs + 1] = p.g;
+			buf[ofs + 2] = p.b;
+		}
+		currentY--;
+	}
+}
+
+static void testCompositing() {
+	static uint8_t expected[BUF_SIZE], actual[BUF_SIZE];
+	uint8_t levels[NUM_PIXELS];
+	Head heads[MAX_MATRIX_OBJECTS];
+
+	randomSeed( 7 );
+	for( int frame = 0; frame < 2000; frame++ ) {
+		int count = 1 + random( MAX_MATRIX_OBJECTS );
+		for( int i = 0; i < count; i++ ) {
+			heads[i].x = random( LEDMatrix::width );
+			heads[i].y = random( LEDMatrix::height + 2 * MATRIX_GRADIENT_LENGTH ) - MATRIX_GRADIENT_LENGTH;
+		}
+
+		memset( expected, 0, BUF_SIZE );
+		std::sort( heads, heads + count );
+		for( int i = 0; i < count; i++ )
+			legacyRender( expected, heads[i] );
+
+		// any order gives the same result
+		memset( actual, 0, BUF_SIZE );
+		memset( levels, 0, sizeof( levels ) );
+		std::reverse( heads, heads + count );
+		for( int i = 0; i < count; i++ )
+			MatrixObject::compositeTrail( levels, heads[i].x, heads[i].y );
+		MatrixObject::resolve( levels, actual );
+
+		CHECK( memcmp( expected, actual, BUF_SIZE ) == 0 );
+	}
+}
+
+static void testClipping() {
+	static uint8_t buf[BUF_SIZE];
+	uint8_t levels[NUM_PIXELS];
+	memset( levels, 0, sizeof( levels ) );
+	MatrixObject::compositeTrail( levels, -1, 5 );
+	MatrixObject::compositeTrail( levels, LEDMatrix::width, 5 );
+	MatrixObject::compositeTrail( levels, 3, -1 );
+	MatrixObject::compositeTrail( levels, 3, LEDMatrix::height + MATRIX_GRADIENT_LENGTH - 1 );
+	for( uint8_t l : levels )
+		CHECK_EQUAL( 0, l );
+
+	// head below the screen, only the end of the trail is visible
+	MatrixObject::compositeTrail( levels, 3, LEDMatrix::height + 1 );
+	CHECK_EQUAL( MATRIX_GRADIENT_LENGTH - 2, levels[3 * LEDMatrix::height + LEDMatrix::height - 1] );
+	CHECK_EQUAL( 1, levels[3 * LEDMatrix::height + 0] );
+	memset( buf, 0, BUF_SIZE );
+	MatrixObject::resolve( levels, buf );
+	int ofs = LEDMatrix::getOffset( 3, LEDMatrix::height - 1 );
+	CHECK_EQUAL( 64, buf[ofs] );
+	CHECK_EQUAL( 255, buf[ofs + 1] );
+}
+
+int main() {
+	testCompositing();
+	testClipping();
+	return testResult();
+}
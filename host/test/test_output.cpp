@@ -0,0 +1,108 @@
+// ESP8266 Wordclock
+// Copyright (C) 2016 Thoralt Franz, https://github.com/thoralt
+// also (C) 2021 by Stefan Rinke, https://github.com/sker65
+//
+//  Host test for the LED output: with a recorder that needs time for each transfer,
+//  show() never starts a transfer while the previous one is running, a frame rendered
+//  in that time is sent by refresh() once the output is ready and the transfer time is
+//  measured. Config.ledOutput switches the backend at runtime.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#include <string.h>
+
+#include "host_hal.h"
+#include "ledfunctions.h"
+#include "testing.h"
+
+// 114 LEDs at 800 kHz and the reset time
+#define TRANSFER_MICROS 3500
+
+// loop() with frames every periodMicros and one refresh() in between
+static void run( int frames, uint32_t periodMicros ) {
+	for( int i = 0; i < frames; i++ ) {
+		hostAdvanceMicros( periodMicros / 2 );
+		LED.refresh();
+		hostAdvanceMicros( periodMicros - periodMicros / 2 );
+		LED.process();
+		LED.refresh();
+	}
+}
+
+static void testOverlap() {
+	// plasma changes every frame, the frames come faster than the strip sends them
+	LED.setMode( DisplayMode::plasma );
+	uint32_t shows = hostRecorder()->getShowCount();
+	uint32_t deferred = LED.getFramesDeferred();
+	run( 100, 2000 );
+	CHECK_EQUAL( 0u, hostRecorder()->getBlockedShows() );
+	CHECK( LED.getFramesDeferred() - deferred >= 50 );
+	// at most one transfer per TRANSFER_MICROS, polled every 1 ms
+	CHECK( hostRecorder()->getShowCount() - shows <= 100 * 2000 / TRANSFER_MICROS + 1 );
+	CHECK( hostRecorder()->getShowCount() - shows >= 100 * 2000 / ( TRANSFER_MICROS + 1000 ) );
+	CHECK( LED.getTransferMicros() >= TRANSFER_MICROS );
+	CHECK( LED.getTransferMicros() < TRANSFER_MICROS + 1000 );
+
+	// the last frame rendered is sent as soon as the strip is ready
+	hostAdvanceMicros( TRANSFER_MICROS );
+	LED.refresh();
+	CHECK( memcmp( hostRecorder()->getFrame(), hostRecorder()->getPixels(), LED_BUFFER_SIZE ) == 0 );
+	CHECK_EQUAL( 0u, hostRecorder()->getBlockedShows() );
+}
+
+static void testInTime() {
+	// at the regular frame period every frame is sent right away
+	hostAdvanceMicros( TRANSFER_MICROS );
+	LED.refresh();
+	uint32_t shows = hostRecorder()->getShowCount();
+	uint32_t sent = LED.getFramesSent();
+	uint32_t deferred = LED.getFramesDeferred();
+	run( 50, DEFAULT_FRAME_PERIOD * 1000 );
+	CHECK_EQUAL( deferred, LED.getFramesDeferred() );
+	CHECK_EQUAL( 50u, hostRecorder()->getShowCount() - shows );
+	CHECK_EQUAL( 50u, LED.getFramesSent() - sent );
+	CHECK( memcmp( hostRecorder()->getFrame(), hostRecorder()->getPixels(), LED_BUFFER_SIZE ) == 0 );
+	CHECK_EQUAL( 0u, hostRecorder()->getBlockedShows() );
+}
+
+static void testSwitch() {
+	// the NeoPixelBus methods are only tags on the host, but are created and named
+	static const char* names[] = { "dma", "uart", "bitbang", "recorder" };
+	for( int method = 0; method <= (int)LedOutputMethod::recorder; method++ ) {
+		Config.ledOutput = method;
+		hostAdvanceMicros( DEFAULT_FRAME_PERIOD * 1000 );
+		LED.process();
+		CHECK( strcmp( names[method], LED.getOutput()->getName() ) == 0 );
+		// the first frame of a new output is always sent
+		CHECK_EQUAL( 1u, LED.getOutput()->getShowCount() );
+	}
+
+	// the recorder is not saved, the LEDs of a device would stay dark after a reboot
+	Config.save();
+	Config.load();
+	CHECK_EQUAL( DEFAULT_LED_OUTPUT, Config.ledOutput );
+	CHECK_EQUAL( 0, Config.crossfadeTime );
+}
+
+int main() {
+	Config.ledOutput = (uint8_t)LedOutputMethod::recorder;
+	LED.begin( 2 );
+	LED.setBrightness( 256 );
+	Config.ditherBrightness = 0;
+	Config.crossfadeTime = 0;
+	hostRecorder()->setTransferMicros( TRANSFER_MICROS );
+	testOverlap();
+	testInTime();
+	testSwitch();
+	return testResult();
+}
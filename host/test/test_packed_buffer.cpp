@@ -0,0 +1,107 @@
+// ESP8266 Wordclock
+// Copyright (C) 2016 Thoralt Franz, https://github.com/thoralt
+// also (C) 2021 by Stefan Rinke, https://github.com/sker65
+//
+//  Host test for the packed frame buffers: single pixels, filled and copied ranges
+//  across word boundaries and led mask words against a byte per pixel reference, and
+//  LEDMatrix::set() expanding a packed buffer to the same colors as a byte buffer.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#include <stdlib.h>
+#include <string.h>
+
+#include "host_hal.h"
+#include "ledfunctions.h"
+#include "testing.h"
+
+template <int BITS> static bool equals( const PackedBuffer<BITS>& packed, const uint8_t* reference ) {
+	for( int i = 0; i < NUM_PIXELS; i++ ) {
+		if( packed.get( i ) != reference[i] )
+			return false;
+	}
+	return true;
+}
+
+template <int BITS> static void testOperations() {
+	const int maxIndex = PackedBuffer<BITS>::MAX_INDEX;
+	uint8_t reference[NUM_PIXELS], other[NUM_PIXELS];
+	PackedBuffer<BITS> packed, source;
+	srand( BITS );
+
+	packed.fill( maxIndex );
+	memset( reference, maxIndex, NUM_PIXELS );
+	CHECK( equals( packed, reference ) );
+
+	for( int i = 0; i < NUM_PIXELS; i++ ) {
+		reference[i] = rand() % ( maxIndex + 1 );
+		packed.set( i, reference[i] );
+		other[i] = rand() % ( maxIndex + 1 );
+		source.set( i, other[i] );
+	}
+	CHECK( equals( packed, reference ) );
+
+	for( int n = 0; n < 500; n++ ) {
+		int first = rand() % ( NUM_PIXELS + 1 );
+		int last = first + rand() % ( NUM_PIXELS + 1 - first );
+		uint8_t index = rand() % ( maxIndex + 1 );
+		if( n & 1 ) {
+			packed.fill( index, first, last );
+			memset( reference + first, index, last - first );
+		} else {
+			packed.copy( source, first, last );
+			memcpy( reference + first, other + first, last - first );
+		}
+		CHECK( equals( packed, reference ) );
+	}
+
+	for( int w = 0; w < ( NUM_PIXELS + 31 ) / 32; w++ ) {
+		uint32_t bits = rand() ^ ( (uint32_t)rand() << 16 );
+		packed.setBits( w, bits, 1 );
+		for( int b = 0; b < 32 && w * 32 + b < NUM_PIXELS; b++ ) {
+			if( bits & ( 1u << b ) )
+				reference[w * 32 + b] = 1;
+		}
+	}
+	CHECK( equals( packed, reference ) );
+}
+
+template <int BITS> static void testSet() {
+	static uint8_t expected[NUM_PIXELS * 3];
+	uint8_t reference[NUM_PIXELS];
+	PackedBuffer<BITS> packed;
+	palette_entry palette[PackedBuffer<BITS>::MAX_INDEX + 1];
+	for( int c = 0; c <= PackedBuffer<BITS>::MAX_INDEX; c++ )
+		palette[c] = { (uint8_t)( c * 17 ), (uint8_t)( 255 - c ), (uint8_t)( c << 4 ) };
+	for( int i = 0; i < NUM_PIXELS; i++ ) {
+		reference[i] = ( i * 7 ) % ( PackedBuffer<BITS>::MAX_INDEX + 1 );
+		packed.set( i, reference[i] );
+	}
+
+	LED.set( reference, palette, true );
+	memcpy( expected, LED.currentValues, sizeof( expected ) );
+	memset( LED.currentValues, 0, sizeof( expected ) );
+	LED.set( packed, palette, true );
+	CHECK( memcmp( expected, LED.currentValues, sizeof( expected ) ) == 0 );
+}
+
+int main() {
+	LED.begin( 2 );
+	CHECK_EQUAL( 8, (int)sizeof( PackedBuffer<2> ) / 4 );
+	CHECK_EQUAL( 15, (int)sizeof( PackedBuffer<4> ) / 4 );
+	testOperations<2>();
+	testOperations<4>();
+	testSet<2>();
+	testSet<4>();
+	return testResult();
+}
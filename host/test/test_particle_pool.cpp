@@ -0,0 +1,113 @@
+// ESP8266 Wordclock
+// Copyright (C) 2016 Thoralt Franz, https://github.com/thoralt
+// also (C) 2021 by Stefan Rinke, https://github.com/sker65
+//
+//  Host test for the particle pool of the explode transition: capacity, lifetime
+//  and removal of the particles, the direction table and the rendering against the
+//  Particle class.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ledfunctions.h"
+#include "testing.h"
+
+#define BUF_SIZE ( NUM_PIXELS * 3 )
+
+static ParticlePool pool;
+
+static void testCapacity() {
+	pool.clear();
+	for( int i = 0; i < MAX_EXPLODING_PIXELS; i++ )
+		CHECK_EQUAL( PARTICLE_DIRECTIONS, pool.addExplosion( i % LEDMatrix::width, i / LEDMatrix::width, 0 ) );
+	CHECK_EQUAL( PARTICLE_POOL_SIZE, pool.count() );
+	CHECK_EQUAL( 0, pool.addExplosion( 0, 0, 0 ) );
+	CHECK( !pool.add( 0, 0, 0, 0 ) );
+	pool.clear();
+	CHECK_EQUAL( 0, pool.count() );
+}
+
+static void testLifetime() {
+	static uint8_t target[BUF_SIZE];
+	palette_entry color = { 255, 128, 0 };
+
+	// particles move after their delay and die after MAX_PARTICLE_DISTANCE pixels
+	pool.clear();
+	pool.addExplosion( 5, 5, 10 );
+	pool.addExplosion( 2, 3, 20 );
+	int frames = 0;
+	int firstDead = -1;
+	while( pool.count() > 0 && frames < 1000 ) {
+		pool.render( target, color );
+		frames++;
+		if( firstDead < 0 && pool.count() < 2 * PARTICLE_DIRECTIONS )
+			firstDead = frames;
+	}
+	int movingFrames = MAX_PARTICLE_DISTANCE * 65536 / PARTICLE_SPEED_Q16 + 1;
+	CHECK_EQUAL( 10 + movingFrames, firstDead );
+	CHECK_EQUAL( 20 + movingFrames, frames );
+}
+
+static void testDirections() {
+	particle_directions_t t = generateParticleDirections();
+	for( int i = 0; i < PARTICLE_DIRECTIONS; i++ ) {
+		double angle = i * 2.0 * M_PI / PARTICLE_DIRECTIONS;
+		CHECK( fabs( t.vx[i] - PARTICLE_SPEED_Q16 * sin( angle ) ) <= 2.0 );
+		CHECK( fabs( t.vy[i] - PARTICLE_SPEED_Q16 * cos( angle ) ) <= 2.0 );
+	}
+}
+
+static void testRender() {
+	// same explosion with single particles and the pool
+	static uint8_t expected[BUF_SIZE], actual[BUF_SIZE];
+	palette_entry palette[3] = { { 0, 0, 0 }, { 200, 255, 40 }, { 0, 0, 0 } };
+	particle_directions_t directions = generateParticleDirections();
+	std::vector<Particle*> particles;
+	pool.clear();
+	for( int i = 0; i < PARTICLE_DIRECTIONS; i++ ) {
+		particles.push_back( new Particle( 4 << 16, 6 << 16, directions.vx[i], directions.vy[i], 3 ) );
+		pool.add( 4, 6, i, 3 );
+	}
+
+	int differentFrames = 0;
+	for( int frame = 0; frame < 100; frame++ ) {
+		memset( expected, 0x20, BUF_SIZE );
+		memset( actual, 0x20, BUF_SIZE );
+		for( Particle* p : particles )
+			if( p->alive )
+				p->render( expected, palette );
+		pool.render( actual, palette[1] );
+		differentFrames += memcmp( expected, actual, BUF_SIZE ) != 0;
+		for( int i = 0; i < BUF_SIZE; i++ )
+			CHECK( actual[i] <= std::max( 0x20, ( i % 3 ) == 0 ? 200 : ( i % 3 ) == 1 ? 255 : 40 ) );
+	}
+	// the pool derives the distance from the frames moved, the particles from their
+	// rounded position, both may fall on different sides of a gradient step
+	CHECK( differentFrames <= 5 );
+	CHECK_EQUAL( 0, pool.count() );
+	for( Particle* p : particles ) {
+		CHECK( !p->alive );
+		delete p;
+	}
+}
+
+int main() {
+	testCapacity();
+	testLifetime();
+	testDirections();
+	testRender();
+	return testResult();
+}
@@ -0,0 +1,146 @@
+// ESP8266 Wordclock
+// Copyright (C) 2016 Thoralt Franz, https://github.com/thoralt
+// also (C) 2021 by Stefan Rinke, https://github.com/sker65
+//
+//  Host test for the fixed point plasma: sine table and integer square root against
+//  libm, and whole frames against the former floating point renderPlasma() (copied
+//  below) with a PSNR threshold. The palette of the plasma is cyclic, so the error of
+//  a pixel is the shorter distance between both palette indexes.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#include <algorithm>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "plasma.h"
+#include "testing.h"
+
+#define WIDTH 11
+#define HEIGHT 10
+#define MIN_PSNR 40.0
+
+// former implementation with the time passed in instead of advanced per call
+static void legacyPlasma( uint8_t* buf, double _time ) {
+	int color;
+	double cx, cy, xx, yy;
+
+	for( int y = 0; y < HEIGHT; y++ ) {
+		yy = (double)y / (double)HEIGHT / 3.0;
+		for( int x = 0; x < WIDTH; x++ ) {
+			xx = (double)x / (double)WIDTH / 3.0;
+			cx = xx + 0.5 * sin( _time / 5.0 );
+			cy = (double)y / (double)HEIGHT / 3.0 + 0.5 * sin( _time / 3.0 );
+			color = ( sin( sqrt( 100 * ( cx * cx + cy * cy ) + 1 + _time ) +
+			               6.0 * ( xx * sin( _time / 2 ) + yy * cos( _time / 3 ) + _time / 4.0 ) ) +
+			          1.0 ) *
+			        128.0;
+			buf[x + y * WIDTH] = color;
+		}
+	}
+}
+
+static void testSine() {
+	int maxError = 0;
+	for( int a = 0; a < 65536; a++ ) {
+		int expected = lround( 32767.0 * sin( a * 2.0 * M_PI / 65536.0 ) );
+		maxError = std::max( maxError, abs( sin16( a ) - expected ) );
+		CHECK_EQUAL( sin16( a + 16384 ), cos16( a ) );
+	}
+	printf( "sin16 max error %d / 32767\n", maxError );
+	CHECK( maxError <= 20 );
+}
+
+static void testSquareRoot() {
+	for( uint32_t x = 0; x < 1000000; x++ )
+		CHECK_EQUAL( (uint32_t)sqrt( (double)x ), isqrt32( x ) );
+	for( uint32_t x = 0xFFFFFFFFu; x > 0xFFFFFFFFu - 1000000; x-- )
+		CHECK_EQUAL( (uint32_t)sqrt( (double)x ), isqrt32( x ) );
+}
+
+// squared error summed over a frame, distance on the cyclic palette
+static double frameError( uint32_t time ) {
+	uint8_t expected[WIDTH * HEIGHT], actual[WIDTH * HEIGHT];
+	legacyPlasma( expected, time / 65536.0 );
+	renderPlasmaFrame( actual, WIDTH, HEIGHT, time );
+
+	double sum = 0;
+	for( int i = 0; i < WIDTH * HEIGHT; i++ ) {
+		int d = abs( expected[i] - actual[i] );
+		d = std::min( d, 256 - d );
+		sum += d * d;
+	}
+	return sum;
+}
+
+static double psnr( double squaredError, int pixels ) {
+	if( squaredError == 0 )
+		return 99.0;
+	return 10.0 * log10( 255.0 * 255.0 / ( squaredError / pixels ) );
+}
+
+static void testFrames() {
+	// the first minutes at 100 % speed in frames of 10 ms and random times up to the wrap
+	double sum = 0, worst = 99.0;
+	int frames = 0;
+	uint32_t time = 0;
+	for( int i = 0; i < 20000; i++ ) {
+		double e = frameError( time );
+		sum += e;
+		worst = std::min( worst, psnr( e, WIDTH * HEIGHT ) );
+		frames++;
+		time = advancePlasmaTime( time, 10, 100 );
+	}
+	srand( 1 );
+	for( int i = 0; i < 20000; i++ ) {
+		uint32_t t = ( ( (uint32_t)rand() << 16 ) ^ rand() ) % PLASMA_TIME_WRAP;
+		double e = frameError( t );
+		sum += e;
+		worst = std::min( worst, psnr( e, WIDTH * HEIGHT ) );
+		frames++;
+	}
+
+	double total = psnr( sum, frames * WIDTH * HEIGHT );
+	printf( "plasma PSNR %.1f dB over %d frames, worst frame %.1f dB\n", total, frames, worst );
+	CHECK( total >= MIN_PSNR );
+	CHECK( worst >= MIN_PSNR - 10.0 );
+}
+
+static void testTime() {
+	// 1 s at 100 % is 5 units, independent of the frame rate except for the rounding
+	// of each step to 1 / 65536 unit
+	uint32_t a = 0, b = 0;
+	for( int i = 0; i < 100; i++ )
+		a = advancePlasmaTime( a, 10, 100 );
+	for( int i = 0; i < 25; i++ )
+		b = advancePlasmaTime( b, 40, 100 );
+	CHECK( abs( (int)a - (int)b ) <= 100 );
+	CHECK( abs( (int)a - 5 * 65536 ) <= 100 );
+
+	// speed scales linearly, long gaps are limited
+	CHECK( advancePlasmaTime( 0, 10, 200 ) - 2 * advancePlasmaTime( 0, 10, 100 ) <= 1 );
+	CHECK_EQUAL( advancePlasmaTime( 0, PLASMA_MAX_STEP_MS, 100 ), advancePlasmaTime( 0, 60000, 100 ) );
+
+	// wraps around without leaving the valid range
+	uint32_t t = advancePlasmaTime( PLASMA_TIME_WRAP - 1, PLASMA_MAX_STEP_MS, 250 );
+	CHECK( t < PLASMA_TIME_WRAP );
+}
+
+int main() {
+	testSine();
+	testSquareRoot();
+	testFrames();
+	testTime();
+	return testResult();
+}
@@ -0,0 +1,163 @@
+// ESP8266 Wordclock
+// Copyright (C) 2016 Thoralt Franz, https://github.com/thoralt
+// also (C) 2021 by Stefan Rinke, https://github.com/sker65
+//
+//  Host test for the power limiter: the estimate follows the current model, a frame
+//  above Config.powerLimit is scaled down as a whole to the budget at once, and
+//  recovers smoothly within POWER_RELEASE_MS after the limit was lifted, even if the
+//  colors do not change.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#include <string.h>
+
+#include "host_hal.h"
+#include "ledfunctions.h"
+#include "testing.h"
+
+static void testEstimate() {
+	static uint8_t pixels[LED_BUFFER_SIZE] __attribute__( ( aligned( 4 ) ) );
+	memset( pixels, 0, sizeof( pixels ) );
+	CHECK_EQUAL( NUM_PIXELS * POWER_IDLE_MA, PowerLimiter::estimate( pixels, LED_BUFFER_SIZE, 3 ) );
+	memset( pixels, 255, sizeof( pixels ) );
+	CHECK_EQUAL( NUM_PIXELS * ( POWER_IDLE_MA + 3 * POWER_CHANNEL_MA ),
+	             PowerLimiter::estimate( pixels, LED_BUFFER_SIZE, 3 ) );
+	// one channel of every LED at half
+	memset( pixels, 0, sizeof( pixels ) );
+	for( int i = 0; i < LED_BUFFER_SIZE; i += 3 )
+		pixels[i] = 255;
+	pixels[LED_BUFFER_SIZE - 1] = 255;
+	CHECK_EQUAL( NUM_PIXELS * ( POWER_IDLE_MA + POWER_CHANNEL_MA ) + POWER_CHANNEL_MA,
+	             PowerLimiter::estimate( pixels, LED_BUFFER_SIZE, 3 ) );
+}
+
+static void testLimit() {
+	static uint8_t full[LED_BUFFER_SIZE];
+	PowerLimiter& limiter = LED.getPowerLimiter();
+	for( int i = 0; i < NUM_PIXELS * 3; i++ )
+		LED.currentValues[i] = i % 3 == 0 ? 255 : i % 3 == 1 ? 180 : 0;
+
+	// no limit by default, the estimate is still reported
+	LED.show();
+	memcpy( full, recordedFrame(), LED_BUFFER_SIZE );
+	uint32_t milliamps = PowerLimiter::estimate( full, LED_BUFFER_SIZE, 3 );
+	CHECK_EQUAL( milliamps, limiter.getMilliamps() );
+	CHECK_EQUAL( milliamps, limiter.getLimitedMilliamps() );
+	CHECK_EQUAL( POWER_SCALE_MAX, limiter.getScale() );
+	CHECK_EQUAL( 0u, limiter.getFramesLimited() );
+
+	// the same colors with a budget are sent again, scaled down at once
+	const uint16_t budget = 1000;
+	CHECK( milliamps > 2 * budget );
+	Config.powerLimit = budget;
+	hostAdvanceMicros( DEFAULT_FRAME_PERIOD * 1000 );
+	uint32_t sent = LED.getFramesSent();
+	LED.show();
+	CHECK_EQUAL( sent + 1, LED.getFramesSent() );
+	uint16_t scale = limiter.getScale();
+	CHECK( scale < POWER_SCALE_MAX / 2 );
+	CHECK_EQUAL( milliamps, limiter.getMilliamps() );
+	CHECK( limiter.getLimitedMilliamps() <= budget );
+	CHECK( limiter.getLimitedMilliamps() > budget - budget / 50 );
+	CHECK( PowerLimiter::estimate( recordedFrame(), LED_BUFFER_SIZE, 3 ) <= limiter.getLimitedMilliamps() );
+	// every channel scaled by the same factor, the colors are kept
+	for( int i = 0; i < LED_BUFFER_SIZE; i++ )
+		CHECK_EQUAL( ( full[i] * scale ) >> 8, recordedFrame()[i] );
+	CHECK_EQUAL( 1u, limiter.getFramesLimited() );
+
+	// a steady limited frame is skipped like any other
+	hostAdvanceMicros( DEFAULT_FRAME_PERIOD * 1000 );
+	uint32_t skipped = LED.getFramesSkipped();
+	LED.show();
+	CHECK_EQUAL( skipped + 1, LED.getFramesSkipped() );
+}
+
+static void testRelease() {
+	PowerLimiter& limiter = LED.getPowerLimiter();
+	uint16_t scale = limiter.getScale();
+	Config.powerLimit = 0;
+	uint32_t sent = LED.getFramesSent();
+	int frames = 0;
+	while( limiter.getScale() < POWER_SCALE_MAX && frames < 1000 ) {
+		hostAdvanceMicros( DEFAULT_FRAME_PERIOD * 1000 );
+		LED.show();
+		CHECK( limiter.getScale() > scale );
+		// the first frame comes two periods after the last one shown
+		int periods = frames ? 1 : 2;
+		CHECK( limiter.getScale() - scale <= POWER_SCALE_MAX * DEFAULT_FRAME_PERIOD * periods / POWER_RELEASE_MS );
+		scale = limiter.getScale();
+		frames++;
+	}
+	// the colors did not change, every step was sent anyway
+	CHECK_EQUAL( sent + frames, LED.getFramesSent() );
+	CHECK( frames >= POWER_RELEASE_MS / 2 / DEFAULT_FRAME_PERIOD );
+	CHECK( frames <= POWER_RELEASE_MS / DEFAULT_FRAME_PERIOD );
+	CHECK_EQUAL( limiter.getMilliamps(), PowerLimiter::estimate( recordedFrame(), LED_BUFFER_SIZE, 3 ) );
+
+	hostAdvanceMicros( DEFAULT_FRAME_PERIOD * 1000 );
+	uint32_t skipped = LED.getFramesSkipped();
+	LED.show();
+	CHECK_EQUAL( skipped + 1, LED.getFramesSkipped() );
+}
+
+static void testBelowIdle() {
+	PowerLimiter& limiter = LED.getPowerLimiter();
+	for( int i = 0; i < NUM_PIXELS * 3; i++ )
+		LED.currentValues[i] = 255;
+
+	// a budget below the idle current does not turn the display black, it is raised to
+	// the smallest budget allowed
+	Config.powerLimit = NUM_PIXELS * POWER_IDLE_MA - 14;
+	hostAdvanceMicros( DEFAULT_FRAME_PERIOD * 1000 );
+	LED.show();
+	CHECK( limiter.getScale() > 0 );
+	CHECK( limiter.getLimitedMilliamps() <= MIN_POWER_LIMIT );
+	CHECK( PowerLimiter::estimate( recordedFrame(), LED_BUFFER_SIZE, 3 ) > NUM_PIXELS * POWER_IDLE_MA );
+
+	// and is not accepted from the EEPROM
+	Config.save();
+	Config.load();
+	CHECK_EQUAL( DEFAULT_POWER_LIMIT, Config.powerLimit );
+	Config.powerLimit = MIN_POWER_LIMIT;
+	Config.save();
+	Config.load();
+	CHECK_EQUAL( MIN_POWER_LIMIT, Config.powerLimit );
+	Config.powerLimit = 0;
+}
+
+static void testBlack() {
+	// nothing to scale, a budget below the idle current of the black frame must not
+	// divide by zero
+	memset( LED.currentValues, 0, sizeof( LED.currentValues ) );
+	Config.powerLimit = 1;
+	uint16_t scale = LED.getPowerLimiter().getScale();
+	hostAdvanceMicros( DEFAULT_FRAME_PERIOD * 1000 );
+	LED.show();
+	CHECK_EQUAL( NUM_PIXELS * POWER_IDLE_MA, LED.getPowerLimiter().getMilliamps() );
+	CHECK( LED.getPowerLimiter().getScale() > scale );
+	Config.powerLimit = 0;
+}
+
+int main() {
+	Config.ledOutput = (uint8_t)LedOutputMethod::recorder;
+	LED.begin( 2 );
+	LED.setBrightness( 256 );
+	Config.ditherBrightness = 0;
+	Config.crossfadeTime = 0;
+	testEstimate();
+	testLimit();
+	testRelease();
+	testBelowIdle();
+	testBlack();
+	return testResult();
+}
@@ -0,0 +1,90 @@
+// ESP8266 Wordclock
+// Copyright (C) 2016 Thoralt Franz, https://github.com/thoralt
+// also (C) 2021 by Stefan Rinke, https://github.com/sker65
+//
+//  Host test for the time words: renders a few times in every layout through
+//  LEDMatrix::process() and compares the lit LEDs with the expected words.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#include <initializer_list>
+#include <stdio.h>
+
+#include "ledfunctions.h"
+#include "testing.h"
+
+// checks that exactly "ES IST" and the given LEDs are lit, the corner LEDs can not be
+// addressed by coordinates and are left out
+static void checkLit( int layout, int minuteType, int h, int m, std::initializer_list<int> leds ) {
+	bool expected[NUM_PIXELS] = { false };
+	for( int i : { 0, 1, 3, 4, 5 } )
+		expected[i] = true;
+	for( int i : leds )
+		expected[i] = true;
+
+	for( int i = 0; i < LEDMatrix::width * LEDMatrix::height; i++ ) {
+		bool lit = LED.currentValues[LEDMatrix::getOffset( i % LEDMatrix::width, i / LEDMatrix::width )] != 0;
+		if( lit != expected[i] ) {
+			printf( "layout %d, type %d, %02d:%02d: LED %d\n", layout + 1, minuteType, h, m, i );
+			CHECK( lit == expected[i] );
+		}
+	}
+}
+
+// renders the given time and checks the LEDs lit
+static void checkTime( int layout, int minuteType, int h, int m, std::initializer_list<int> leds ) {
+	Config.tmpl = layout;
+	Config.minuteType = minuteType;
+	LED.setTime( h, m, 0, 0 );
+	LED.process();
+	checkLit( layout, minuteType, h, m, leds );
+}
+
+// the first frame after boot of a transition mode starts from the previous time, which
+// is not known yet (-1): nothing but "ES IST" is rendered for it
+static void checkNoPreviousTime() {
+	Config.tmpl = 0;
+	Config.minuteType = 0;
+	LED.setTime( 10, 20, 0, 0 );
+	// renders the first frame
+	LED.setMode( DisplayMode::explode );
+	checkLit( 0, 0, -1, -1, {} );
+}
+
+int main() {
+	LED.begin( 2 );
+	Config.fg = { 255, 255, 255 };
+	Config.bg = { 0, 0, 0 };
+	Config.s = { 0, 0, 0 };
+	Config.showItIs = true;
+	checkNoPreviousTime();
+	LED.setMode( DisplayMode::plain );
+
+	// layout 1
+	checkTime( 0, 0, 1, 0, { 44, 45, 46, 106, 107, 108 } );                          // EIN UHR
+	checkTime( 0, 0, 13, 5, { 44, 45, 46, 47, 7, 8, 9, 10, 34, 35, 36, 37 } );       // FÜNF NACH EINS
+	checkTime( 0, 0, 9, 45, { 15, 16, 17, 18, 19, 20, 21, 30, 31, 32, 92, 93, 94, 95 } ); // VIERTEL VOR ZEHN
+	checkTime( 0, 1, 23, 58, { 7, 8, 9, 10, 30, 31, 32, 100, 101, 102, 103, 104 } );    // FÜNF VOR ZWÖLF
+	checkTime( 0, 0, 0, 0, { 100, 101, 102, 103, 104, 106, 107, 108 } );             // ZWÖLF UHR
+
+	// layout 2
+	checkTime( 1, 1, 10, 45, { 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 49, 50, 51 } ); // DREI VIERTEL ELF
+	checkTime( 1, 0, 10, 45, { 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 49, 50, 51 } );     // VIERTEL VOR ELF
+	checkTime( 1, 1, 4, 21, { 11, 12, 13, 14, 33, 34, 35, 44, 45, 46, 47, 51, 52, 53, 54 } ); // ZEHN VOR HALB FÜNF
+
+	// layout 3
+	checkTime( 2, 0, 7, 30, { 44, 45, 46, 47, 89, 90, 91, 92 } );                    // HALB ACHT
+	checkTime( 2, 1, 6, 15, { 26, 27, 28, 29, 30, 31, 32, 60, 61, 62, 63, 64, 65 } ); // VIERTEL SIEBEN
+
+	return testResult();
+}
@@ -0,0 +1,96 @@
+// ESP8266 Wordclock
+// Copyright (C) 2016 Thoralt Franz, https://github.com/thoralt
+// also (C) 2021 by Stefan Rinke, https://github.com/sker65
+//
+//  Host test for the occupancy grid of the stars screen saver: the exclusion shape
+//  against a brute force distance check and the placement until the grid is full.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#include <stdlib.h>
+
+#include "ledfunctions.h"
+#include "testing.h"
+
+#define NUM_CELLS ( STAR_GRID_WIDTH * STAR_GRID_HEIGHT )
+
+static bool keepsDistance( const StarGrid& grid, int x, int y ) {
+	for( int oy = 0; oy < STAR_GRID_HEIGHT; oy++ )
+		for( int ox = 0; ox < STAR_GRID_WIDTH; ox++ )
+			if( grid.isOccupied( ox, oy ) &&
+			    ( ox - x ) * ( ox - x ) + ( oy - y ) * ( oy - y ) < StarGrid::minimumDistanceSquared )
+				return false;
+	return true;
+}
+
+static void testFreeCells() {
+	StarGrid grid;
+	randomSeed( 3 );
+	for( int round = 0; round < 200; round++ ) {
+		grid.clear();
+		int stars = random( 12 );
+		for( int i = 0; i < stars; i++ ) {
+			int x, y;
+			grid.place( x, y );
+		}
+
+		uint16_t free[STAR_GRID_HEIGHT];
+		int count = grid.freeCells( free );
+		int expected = 0;
+		for( int y = 0; y < STAR_GRID_HEIGHT; y++ ) {
+			CHECK_EQUAL( 0, free[y] >> STAR_GRID_WIDTH );
+			for( int x = 0; x < STAR_GRID_WIDTH; x++ ) {
+				bool ok = keepsDistance( grid, x, y );
+				CHECK_EQUAL( ok, ( free[y] >> x ) & 1 );
+				expected += ok;
+			}
+		}
+		CHECK_EQUAL( expected, count );
+	}
+}
+
+static void testPlaceUntilFull() {
+	StarGrid grid;
+	uint16_t free[STAR_GRID_HEIGHT];
+	int spaced = 0;
+	randomSeed( 5 );
+	for( int i = 0; i < NUM_CELLS; i++ ) {
+		int count = grid.freeCells( free );
+		StarGrid before = grid;
+		int x = -1, y = -1;
+		CHECK( grid.place( x, y ) );
+		CHECK( x >= 0 && x < STAR_GRID_WIDTH && y >= 0 && y < STAR_GRID_HEIGHT );
+		CHECK( !before.isOccupied( x, y ) );
+		CHECK( grid.isOccupied( x, y ) );
+		// keeps the distance as long as possible, then fills the remaining cells
+		if( count > 0 ) {
+			CHECK( ( free[y] >> x ) & 1 );
+			spaced++;
+		}
+	}
+	// the densest spacing covers a fifth of the grid
+	CHECK( spaced >= 12 && spaced <= NUM_CELLS / 5 + 2 );
+
+	int x, y;
+	CHECK( !grid.place( x, y ) );
+	grid.release( 4, 7 );
+	CHECK( grid.place( x, y ) );
+	CHECK_EQUAL( 4, x );
+	CHECK_EQUAL( 7, y );
+}
+
+int main() {
+	testFreeCells();
+	testPlaceUntilFull();
+	return testResult();
+}
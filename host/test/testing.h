@@ -0,0 +1,50 @@
+// ESP8266 Wordclock
+// Copyright (C) 2016 Thoralt Franz, https://github.com/thoralt
+// also (C) 2021 by Stefan Rinke, https://github.com/sker65
+//
+//  Minimal check macros for the host tests. A failed check prints its location and
+//  the test keeps running, main() returns testResult() for ctest.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#pragma once
+
+#include <stdio.h>
+
+static int testFailures = 0;
+
+#define CHECK( cond )                                                                     \
+	do {                                                                                  \
+		if( !( cond ) ) {                                                                 \
+			if( testFailures++ < 20 )                                                     \
+				printf( "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond );         \
+		}                                                                                 \
+	} while( 0 )
+
+#define CHECK_EQUAL( expected, actual )                                                   \
+	do {                                                                                  \
+		long long e_ = ( expected ), a_ = ( actual );                                     \
+		if( e_ != a_ ) {                                                                  \
+			if( testFailures++ < 20 )                                                     \
+				printf( "%s:%d: %s: expected %lld, got %lld\n", __FILE__, __LINE__, #actual, \
+				        e_, a_ );                                                         \
+		}                                                                                 \
+	} while( 0 )
+
+static inline int testResult() {
+	if( testFailures )
+		printf( "%d check(s) failed\n", testFailures );
+	else
+		printf( "all checks passed\n" );
+	return testFailures ? 1 : 0;
+}
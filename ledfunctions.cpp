@@ -4,8 +4,8 @@
 //
 //  This module implements functions to manage the WS2812B LEDs. Two buffers contain
 //  color information with current state and fade target state and are updated by
-//  either simple set operations or integrated screensavers (matrix, stars, heart).
-//  Also contains part of the data and logic for the hourglass animation.
+//  the effect of the current display mode (see effects.cpp) through the helpers for
+//  the time, background and palette.
 //
 // This program is free software: you can redistribute it and/or modify
 // it under the terms of the GNU General Public License as published by
@@ -29,20 +29,16 @@
 //---------------------------------------------------------------------------------------
 LEDMatrix LED = LEDMatrix();
 
-uint8_t fireBuf[NUM_PIXELS] __attribute__( ( aligned( 4 ) ) );
-uint8_t plasmaBuf[NUM_PIXELS] __attribute__( ( aligned( 4 ) ) );
-
 //---------------------------------------------------------------------------------------
-// variables in PROGMEM (mapping table, images)
+// variables in PROGMEM (mapping table, time masks)
 //---------------------------------------------------------------------------------------
-#include "hourglass_animation.h"
 
 // This defines the LED output for different minutes
 // param0 controls whether the hour has to be incremented for the given minutes
 // param1 is the matching minimum minute count (inclusive)
 // param2 is the matching maximum minute count (inclusive)
 // clang-format off
-const std::vector<leds_template_t> LEDMatrix::minutesTemplate[3][2] =
+static constexpr leds_template_t minutesTemplate[NUM_LAYOUTS][NUM_MINUTE_TYPES][NUM_MINUTE_SLOTS] =
 {
 	{
 		// layout 1
@@ -155,7 +151,7 @@ const std::vector<leds_template_t> LEDMatrix::minutesTemplate[3][2] =
 //     = 2: matches hour in param1 and param2 whenever minute is >= 5
 // param1: hour to match
 // param2: alternative hour to match
-const std::vector<leds_template_t> LEDMatrix::hoursTemplate[3] =
+static constexpr leds_template_t hoursTemplate[NUM_LAYOUTS][NUM_HOUR_TEMPLATES] =
 {
 	{
 		{ 0,  0, 12,{ 100, 101, 102, 103, 104 } }, // ZWÖLF
@@ -204,6 +200,12 @@ const std::vector<leds_template_t> LEDMatrix::hoursTemplate[3] =
 	} 
 };
 
+// the templates above compiled into LED masks, only this index ends up in flash
+static constexpr time_masks_t PROGMEM __attribute__( ( aligned( 4 ) ) ) timeMasks =
+    generateTimeMasks( minutesTemplate, hoursTemplate );
+static_assert( maxTimeLeds( timeMasks ) + 5 <= MAX_EXPLODING_PIXELS, "particle pool too small" );
+static_assert( maxTimeLeds( timeMasks ) + 5 <= MAX_FLYING_LETTERS, "too many flying letters" );
+
 
 
 // this mapping table maps the linear memory buffer structure used throughout the
@@ -247,131 +249,18 @@ const uint32_t PROGMEM  __attribute__ ((aligned (4))) LEDMatrix::brightnessCurve
 	0, 1, 1, 1, 1, 1, 1, 1, 1, 0, 1,
 	0, 1, 0, 1*/
 };
-
-const uint32_t PROGMEM LEDMatrix::brightnessCurvesR[256 * NUM_BRIGHTNESS_CURVES] __attribute__ ((aligned (4))) = {
-	// LED type 1, 1:1 mapping (neutral)
-	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19,
-	20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36,
-	37, 38, 39, 40, 41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, 52, 53,
-	54, 55, 56, 57, 58, 59, 60, 61, 62, 63, 64, 65, 66, 67, 68, 69, 70,
-	71, 72, 73, 74, 75, 76, 77, 78, 79, 80, 81, 82, 83, 84, 85, 86, 87,
-	88, 89, 90, 91, 92, 93, 94, 95, 96, 97, 98, 99, 100, 101, 102, 103,
-	104, 105, 106, 107, 108, 109, 110, 111, 112, 113, 114, 115, 116,
-	117, 118, 119, 120, 121, 122, 123, 124, 125, 126, 127, 128, 129,
-	130, 131, 132, 133, 134, 135, 136, 137, 138, 139, 140, 141, 142,
-	143, 144, 145, 146, 147, 148, 149, 150, 151, 152, 153, 154, 155,
-	156, 157, 158, 159, 160, 161, 162, 163, 164, 165, 166, 167, 168,
-	169, 170, 171, 172, 173, 174, 175, 176, 177, 178, 179, 180, 181,
-	182, 183, 184, 185, 186, 187, 188, 189, 190, 191, 192, 193, 194,
-	195, 196, 197, 198, 199, 200, 201, 202, 203, 204, 205, 206, 207,
-	208, 209, 210, 211, 212, 213, 214, 215, 216, 217, 218, 219, 220,
-	221, 222, 223, 224, 225, 226, 227, 228, 229, 230, 231, 232, 233,
-	234, 235, 236, 237, 238, 239, 240, 241, 242, 243, 244, 245, 246,
-	247, 248, 249, 250, 251, 252, 253, 254, 255,
-
-	// LED type 2
-	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 3, 3, 5, 5, 5, 5, 5, 5, 7, 7, 7, 7,
-	7, 7, 9, 9, 9, 9, 11, 11, 11, 11, 13, 13, 13, 13, 15, 15, 15, 15,
-	17, 17, 17, 17, 19, 19, 21, 21, 23, 23, 25, 25, 27, 27, 29, 29, 31,
-	31, 33, 33, 35, 35, 37, 37, 39, 39, 41, 41, 43, 43, 45, 45, 47, 47,
-	49, 49, 50, 50, 53, 53, 53, 53, 55, 55, 57, 57, 59, 59, 61, 61, 63,
-	63, 65, 65, 67, 67, 69, 69, 71, 71, 73, 73, 75, 75, 77, 77, 79, 79,
-	81, 81, 83, 83, 83, 83, 85, 85, 87, 87, 89, 89, 91, 91, 93, 93, 95,
-	95, 97, 97, 99, 99, 101, 101, 103, 103, 105, 105, 107, 107, 109, 109,
-	111, 111, 113, 113, 115, 115, 115, 115, 117, 117, 119, 119, 121, 121,
-	123, 123, 125, 125, 127, 127, 130, 130, 132, 132, 134, 134, 136, 136,
-	138, 138, 140, 140, 142, 142, 144, 144, 144, 144, 146, 146, 148, 148,
-	150, 150, 152, 152, 153, 153, 155, 155, 156, 156, 158, 158, 160, 160,
-	162, 162, 164, 164, 166, 166, 168, 168, 170, 170, 172, 172, 174, 174,
-	176, 176, 178, 178, 180, 180, 182, 182, 184, 184, 184, 184, 186, 186,
-	188, 188, 190, 190, 192, 192, 194, 194, 196, 196, 198, 198, 200, 200,
-	202, 202, 204, 204, 206, 206, 208, 208, 210, 210, 212, 212, 214, 214,
-	216, 216, 218, 218
-};
-
-const uint32_t PROGMEM LEDMatrix::brightnessCurvesG[256 * NUM_BRIGHTNESS_CURVES] __attribute__ ((aligned (4))) = {
-	// LED type 1, 1:1 mapping (neutral)
-	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19,
-	20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36,
-	37, 38, 39, 40, 41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, 52, 53,
-	54, 55, 56, 57, 58, 59, 60, 61, 62, 63, 64, 65, 66, 67, 68, 69, 70,
-	71, 72, 73, 74, 75, 76, 77, 78, 79, 80, 81, 82, 83, 84, 85, 86, 87,
-	88, 89, 90, 91, 92, 93, 94, 95, 96, 97, 98, 99, 100, 101, 102, 103,
-	104, 105, 106, 107, 108, 109, 110, 111, 112, 113, 114, 115, 116,
-	117, 118, 119, 120, 121, 122, 123, 124, 125, 126, 127, 128, 129,
-	130, 131, 132, 133, 134, 135, 136, 137, 138, 139, 140, 141, 142,
-	143, 144, 145, 146, 147, 148, 149, 150, 151, 152, 153, 154, 155,
-	156, 157, 158, 159, 160, 161, 162, 163, 164, 165, 166, 167, 168,
-	169, 170, 171, 172, 173, 174, 175, 176, 177, 178, 179, 180, 181,
-	182, 183, 184, 185, 186, 187, 188, 189, 190, 191, 192, 193, 194,
-	195, 196, 197, 198, 199, 200, 201, 202, 203, 204, 205, 206, 207,
-	208, 209, 210, 211, 212, 213, 214, 215, 216, 217, 218, 219, 220,
-	221, 222, 223, 224, 225, 226, 227, 228, 229, 230, 231, 232, 233,
-	234, 235, 236, 237, 238, 239, 240, 241, 242, 243, 244, 245, 246,
-	247, 248, 249, 250, 251, 252, 253, 254, 255,
-
-	// LED type 2
-	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 3, 3, 5, 5, 5, 5, 5, 5, 7, 7, 7, 7, 7,
-	7, 9, 9, 9, 9, 11, 11, 11, 11, 13, 13, 13, 13, 15, 15, 15, 15, 17,
-	17, 17, 17, 19, 19, 21, 21, 23, 23, 25, 25, 27, 27, 29, 29, 31, 31,
-	33, 33, 35, 35, 37, 37, 39, 39, 41, 41, 43, 43, 45, 45, 47, 47, 49,
-	49, 51, 51, 53, 53, 54, 54, 56, 56, 57, 57, 59, 59, 61, 61, 63, 63,
-	66, 66, 68, 68, 70, 70, 72, 72, 74, 74, 76, 76, 78, 78, 80, 80, 80,
-	80, 80, 80, 80, 80, 80, 80, 80, 80, 80, 80, 80, 80, 80, 80, 80, 80,
-	80, 80, 80, 80, 80, 80, 80, 80, 108, 108, 110, 110, 112, 112, 113,
-	113, 116, 116, 117, 117, 119, 119, 122, 122, 124, 124, 126, 126, 127,
-	127, 131, 131, 132, 132, 135, 135, 137, 137, 139, 139, 141, 141, 143,
-	143, 145, 145, 147, 147, 149, 149, 151, 151, 153, 153, 155, 155, 157,
-	157, 159, 159, 160, 160, 163, 163, 165, 165, 167, 167, 169, 169, 171,
-	171, 173, 173, 175, 175, 177, 177, 179, 179, 181, 181, 183, 183, 185,
-	185, 187, 187, 189, 189, 191, 191, 194, 194, 197, 197, 198, 198, 201,
-	201, 203, 203, 205, 205, 208, 208, 210, 210, 212, 212, 215, 215, 218,
-	218, 220, 220, 222, 222, 224, 224, 226, 226, 228, 228, 230, 230, 232,
-	232, 234, 234
-};
-
-const uint32_t PROGMEM LEDMatrix::brightnessCurvesB[256 * NUM_BRIGHTNESS_CURVES] __attribute__ ((aligned (4))) = {
-	// LED type 1, 1:1 mapping (neutral)
-	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19,
-	20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36,
-	37, 38, 39, 40, 41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, 52, 53,
-	54, 55, 56, 57, 58, 59, 60, 61, 62, 63, 64, 65, 66, 67, 68, 69, 70,
-	71, 72, 73, 74, 75, 76, 77, 78, 79, 80, 81, 82, 83, 84, 85, 86, 87,
-	88, 89, 90, 91, 92, 93, 94, 95, 96, 97, 98, 99, 100, 101, 102, 103,
-	104, 105, 106, 107, 108, 109, 110, 111, 112, 113, 114, 115, 116,
-	117, 118, 119, 120, 121, 122, 123, 124, 125, 126, 127, 128, 129,
-	130, 131, 132, 133, 134, 135, 136, 137, 138, 139, 140, 141, 142,
-	143, 144, 145, 146, 147, 148, 149, 150, 151, 152, 153, 154, 155,
-	156, 157, 158, 159, 160, 161, 162, 163, 164, 165, 166, 167, 168,
-	169, 170, 171, 172, 173, 174, 175, 176, 177, 178, 179, 180, 181,
-	182, 183, 184, 185, 186, 187, 188, 189, 190, 191, 192, 193, 194,
-	195, 196, 197, 198, 199, 200, 201, 202, 203, 204, 205, 206, 207,
-	208, 209, 210, 211, 212, 213, 214, 215, 216, 217, 218, 219, 220,
-	221, 222, 223, 224, 225, 226, 227, 228, 229, 230, 231, 232, 233,
-	234, 235, 236, 237, 238, 239, 240, 241, 242, 243, 244, 245, 246,
-	247, 248, 249, 250, 251, 252, 253, 254, 255,
-
-	// LED type 2
-	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 3, 3, 5, 5, 5, 5, 5, 5, 7, 7, 7, 7, 9,
-	9, 9, 9, 9, 9, 11, 11, 11, 11, 13, 13, 13, 13, 15, 15, 15, 15, 17,
-	17, 19, 19, 20, 20, 21, 21, 23, 23, 25, 25, 27, 27, 29, 29, 31, 31,
-	33, 33, 35, 35, 37, 37, 39, 39, 41, 41, 42, 42, 43, 43, 45, 45, 47,
-	47, 49, 49, 51, 51, 53, 53, 55, 55, 57, 57, 59, 59, 61, 61, 63, 63,
-	64, 64, 66, 66, 68, 68, 72, 72, 72, 72, 74, 74, 76, 76, 78, 78, 80,
-	80, 82, 82, 84, 84, 86, 86, 88, 88, 90, 90, 91, 91, 93, 93, 94, 94,
-	96, 96, 98, 98, 100, 100, 102, 102, 104, 104, 106, 106, 108, 108,
-	110, 110, 112, 112, 114, 114, 116, 116, 118, 118, 119, 119, 121, 121,
-	123, 123, 124, 124, 127, 127, 129, 129, 131, 131, 133, 133, 135, 137,
-	137, 139, 139, 141, 141, 143, 143, 145, 145, 147, 147, 149, 149, 151,
-	151, 153, 153, 155, 155, 157, 157, 160, 160, 161, 161, 163, 163, 166,
-	166, 168, 168, 170, 170, 171, 171, 174, 174, 176, 176, 178, 178, 180,
-	180, 183, 183, 184, 184, 187, 187, 188, 188, 191, 191, 194, 194, 196,
-	196, 198, 198, 200, 200, 202, 202, 204, 204, 206, 206, 209, 209, 210,
-	210, 212, 212, 215, 215, 217, 217, 219, 219, 222, 222, 224, 224, 226,
-	226, 228, 228, 230
-};
 // clang-format on
 
+// brightness correction curves for all LED types, generated at compile time from
+// ledCurveTypes[] (see brightnesscurves.h), must be read with pgm_read_byte()
+#ifdef LED_PIPELINE_16BIT
+static constexpr curve_table_t<NUM_BRIGHTNESS_CURVES, uint16_t> PROGMEM __attribute__( ( aligned( 4 ) ) )
+    brightnessCurves = generateBrightnessCurves16( ledCurveTypes );
+#else
+static constexpr curve_table_t<NUM_BRIGHTNESS_CURVES> PROGMEM __attribute__( ( aligned( 4 ) ) ) brightnessCurves =
+    generateBrightnessCurves( ledCurveTypes );
+#endif
+
 //---------------------------------------------------------------------------------------
 // getters, setters, data flow
 //---------------------------------------------------------------------------------------
@@ -397,18 +286,15 @@ LEDMatrix::~LEDMatrix() {
 // <- --
 //---------------------------------------------------------------------------------------
 LEDMatrix::LEDMatrix() {
-	// initialize matrix objects with random coordinates
-	for( int i = 0; i < NUM_MATRIX_OBJECTS; i++ ) {
-		this->matrix.push_back( MatrixObject() );
-	}
-
-	// initialize star objects with default coordinates
-	for( int i = 0; i < NUM_STARS; i++ )
-		this->stars.push_back( StarObject() );
+	// assign brightness curves to physical LED positions, prepare lookup tables
+	for( int i = 0; i < NUM_PIXELS; i++ )
+		this->outputCurve[LEDMatrix::mapping[i]] = LEDMatrix::brightnessCurveSelect[i];
+	this->updateBrightnessLut();
 
-	// set random coordinates with minimum distance to other star objects
-	for( StarObject& s : this->stars )
-		s.randomize( this->stars );
+	// start the dithering of neighboring bytes at different phases, so an area of one
+	// color does not toggle in the same frame
+	for( unsigned i = 0; i < sizeof( this->ditherError ); i++ )
+		this->ditherError[i] = (uint8_t)( i * 0x47 ) & DITHER_MASK;
 }
 
 //---------------------------------------------------------------------------------------
@@ -421,9 +307,31 @@ LEDMatrix::LEDMatrix() {
 //---------------------------------------------------------------------------------------
 void LEDMatrix::begin( int pin ) {
 	// this->pixels = new Adafruit_NeoPixel(NUM_PIXELS, pin, NEO_GRB + NEO_KHZ800);
-	this->strip = new NeoPixelBus<NeoGrbFeature, NeoEsp8266Dma800KbpsMethod>( NUM_PIXELS );
-	this->strip->Begin();
+	this->pin = pin;
+	this->setOutput( (LedOutputMethod)Config.ledOutput );
+
+	// let the color feature place the channel numbers to verify the byte order
+	uint8_t order[LedColorFeature::PixelSize];
+	LedColorFeature::applyPixelColor( order, 0, RgbColor( 0, 1, 2 ) );
+	if( order[0] != WIRE_ORDER_0 || order[1] != WIRE_ORDER_1 || order[2] != WIRE_ORDER_2 )
+		Serial.println( "LEDMatrix::begin: WIRE_ORDER does not match LedColorFeature" );
 }
+//---------------------------------------------------------------------------------------
+// setOutput
+//
+// Replaces the output backend, process() calls this when Config.ledOutput changes
+//
+// -> method: new backend
+// <- --
+//---------------------------------------------------------------------------------------
+void LEDMatrix::setOutput( LedOutputMethod method ) {
+	delete this->output;
+	this->output = createLedOutput( method, this->pin );
+	this->outputMethod = method;
+	this->showPending = false;
+	this->lastFrameDigestValid = false;
+}
+
 const DisplayMode LEDMatrix::randomModes[] = { DisplayMode::fade, DisplayMode::flyingLettersVerticalUp,
                                                DisplayMode::flyingLettersVerticalDown, DisplayMode::explode,
                                                DisplayMode::snake };
@@ -459,6 +367,9 @@ void LEDMatrix::process() {
 	if( Config.debugMode )
 		return;
 
+	if( (LedOutputMethod)Config.ledOutput != this->outputMethod )
+		this->setOutput( (LedOutputMethod)Config.ledOutput );
+
 	// check time values against boundaries
 	if( this->h > 23 || this->h < 0 )
 		this->h = 0;
@@ -477,8 +388,6 @@ void LEDMatrix::process() {
 			displayOn = true;
 	}
 
-	palette_entry palette[3];
-	this->preparePalette( palette );
 	bool displayTimeChanged = this->displayTimeChanged();
 
 	int lm = this->lastM;
@@ -491,7 +400,7 @@ void LEDMatrix::process() {
 	if( this->randomMode != DisplayMode::plain && displayTimeChanged ) {
 		this->randomMode = randomModes[random( NUM_RANDOM_MODES )];
 		this->mode = this->randomMode;
-		Serial.printf( "random: mode changed to=%i\r\n", this->mode );
+		Serial.printf( "random: mode changed to=%i\r\n", (int)this->mode );
 	}
 
 	if( this->rainbowTicker > 0 ) {
@@ -509,93 +418,62 @@ void LEDMatrix::process() {
 		Serial.printf( "rainbow=%i, r=%i, g=%i b=%i\r\n", this->rainbowIndex, col.R, col.G, col.B );
 	}
 
-	uint32_t buf[NUM_PIXELS >> 2 + 1]; // use u32 just to ensure it is aligned
-
-	// Serial.printf("mode=%i\r\n", this->mode);
-	switch( this->mode ) {
-	case DisplayMode::wifiManager:
-		this->renderWifiManager();
-		break;
-	case DisplayMode::yellowHourglass:
-		this->renderHourglass( Config.hourglassState, false );
-		break;
-	case DisplayMode::greenHourglass:
-		this->renderHourglass( Config.hourglassState, true );
-		break;
-	case DisplayMode::update:
-		this->renderUpdate();
-		break;
-	case DisplayMode::updateComplete:
-		this->renderUpdateComplete();
-		break;
-	case DisplayMode::updateError:
-		this->renderUpdateError();
-		break;
-	case DisplayMode::red:
-		this->renderRed();
-		break;
-	case DisplayMode::green:
-		this->renderGreen();
-		break;
-	case DisplayMode::blue:
-		this->renderBlue();
-		break;
-	case DisplayMode::fire:
-		this->renderFire();
-		break;
-	case DisplayMode::plasma:
-		this->renderPlasma();
-		break;
-	case DisplayMode::flyingLettersVerticalUp:
-	case DisplayMode::flyingLettersVerticalDown:
-		this->renderFlyingLetters( displayTimeChanged );
-		break;
-	case DisplayMode::explode:
-		this->renderExplosion( displayTimeChanged, lh, lm );
-		break;
-	case DisplayMode::snake:
-		this->renderSnake( displayTimeChanged, lh, lm );
-		break;
-	case DisplayMode::moon:
-		this->renderMoon();
-		break;
-	case DisplayMode::matrix:
-		this->renderMatrix();
-		break;
-	case DisplayMode::heart:
-		this->renderHeart();
-		break;
-	case DisplayMode::stars:
-		this->renderStars();
-		break;
-	case DisplayMode::fade:
-		this->renderTime( (uint8_t*)buf, this->h, this->m, this->s, this->ms );
-		this->set( (uint8_t*)buf, palette, false );
-		this->fade();
-		break;
-
-	case DisplayMode::random:
-	case DisplayMode::plain:
-	default:
-		this->renderTime( (uint8_t*)buf, this->h, this->m, this->s, this->ms );
-		this->set( (uint8_t*)buf, palette, true );
-		break;
-	}
+	// render the frame with the effect of the current mode
+	uint32_t frameStartMicros = micros();
+	this->fadeShownWeight = FADE_WEIGHT_MAX;
+	effect_frame_t frame = { this->h,   this->m,   this->s,   this->ms, this->year, this->month,
+		                     this->day, displayTimeChanged, lh, lm };
+	this->renderEffect( this->effects.select( this->mode, *this ), this->mode, frame );
+
+	if( this->crossfadeWeight < FADE_WEIGHT_MAX )
+		this->crossfadeWeight = fadeWeight( (FadeEasing)Config.fadeEasing, millis() - this->crossfadeStartMillis,
+		                                    Config.crossfadeTime );
 
 	// transfer this->currentValues to LEDs
-	this->show();
+	this->show( frameStartMicros, true );
 }
 
 //---------------------------------------------------------------------------------------
 // setBrightness
 //
 // Sets the brightness for the WS2812 values. Will be multiplied with each color
-// component when sending data to WS2812.
+// component when sending data to WS2812. The lookup tables are only rebuilt if the
+// value actually changes.
 //
 // -> brightness: [0...256]
 // <- --
 //---------------------------------------------------------------------------------------
-void LEDMatrix::setBrightness( int brightness ) { this->brightness = brightness; }
+void LEDMatrix::setBrightness( int brightness ) {
+	if( brightness == this->brightness )
+		return;
+	this->brightness = brightness;
+	this->updateBrightnessLut();
+}
+
+//---------------------------------------------------------------------------------------
+// updateBrightnessLut
+//
+// Folds the brightness correction curves and the current global brightness into
+// one lookup table per curve and color channel, so show() needs exactly one table
+// read per color component. The tables keep the 8 bit fraction for dithering.
+//
+// -> --
+// <- --
+//---------------------------------------------------------------------------------------
+void LEDMatrix::updateBrightnessLut() {
+	for( int c = 0; c < NUM_BRIGHTNESS_CURVES; c++ ) {
+		for( int v = 0; v < 256; v++ ) {
+			for( int ch = 0; ch < 3; ch++ )
+#ifdef LED_PIPELINE_16BIT
+				this->brightnessLut[c][ch][v] =
+				    ( pgm_read_word( &brightnessCurves.values[ch][( c << 8 ) + v] ) * this->brightness ) >> 8;
+#else
+				this->brightnessLut[c][ch][v] =
+				    pgm_read_byte( &brightnessCurves.values[ch][( c << 8 ) + v] ) * this->brightness;
+#endif
+		}
+	}
+}
 
 //---------------------------------------------------------------------------------------
 // setTime
@@ -613,10 +491,17 @@ void LEDMatrix::setTime( int h, int m, int s, int ms ) {
 	this->ms = ms;
 }
 
-bool LEDMatrix::modeHasTransition( DisplayMode m ) {
-	return m == DisplayMode::snake || m == DisplayMode::flyingLettersVerticalDown ||
-	       m == DisplayMode::flyingLettersVerticalUp || m == DisplayMode::explode;
-}
+//---------------------------------------------------------------------------------------
+// getFramePeriod
+//
+// Returns the time between two calls of process() a display mode is designed for,
+// registered with its effect (see effects.cpp), used by the frame scheduler in loop()
+//
+// -> m: display mode
+// <- frame period in milliseconds
+//---------------------------------------------------------------------------------------
+int LEDMatrix::getFramePeriod( DisplayMode m ) { return getEffectInfo( m ).framePeriod; }
+
 //---------------------------------------------------------------------------------------
 // setMode
 //
@@ -637,13 +522,46 @@ void LEDMatrix::setMode( DisplayMode newMode ) {
 	}
 	this->mode = newMode;
 
-	if( newMode != previousMode && modeHasTransition( newMode ) ) {
+	if( newMode != previousMode )
+		this->startCrossfade();
+	if( newMode != previousMode && getEffectInfo( newMode ).hasTransition ) {
 		this->forceTransition = true;
 	}
 
 	this->process();
 }
 
+// color of a channel during a crossfade, rounded like fbLerp() in startCrossfade()
+static inline uint8_t crossfadeChannel( uint8_t start, uint8_t target, int weight ) {
+	return target >= start ? start + ( ( ( target - start ) * weight ) >> 8 )
+	                       : start - ( ( ( start - target ) * weight ) >> 8 );
+}
+
+//---------------------------------------------------------------------------------------
+// startCrossfade
+//
+// Freezes the frame shown right now (blended, if a crossfade is still running), the
+// effect of the previous mode is not rendered any more. show() fades from this frame
+// to the frames of the new mode.
+//
+// -> --
+// <- --
+//---------------------------------------------------------------------------------------
+void LEDMatrix::startCrossfade() {
+	if( Config.crossfadeTime == 0 ) {
+		this->crossfadeWeight = FADE_WEIGHT_MAX;
+		return;
+	}
+	if( this->crossfadeWeight < FADE_WEIGHT_MAX ) {
+		fbLerp( this->crossfadeStartValues, this->crossfadeStartValues, this->currentValues,
+		        sizeof( this->crossfadeStartValues ), this->crossfadeWeight );
+	} else {
+		memcpy( this->crossfadeStartValues, this->currentValues, sizeof( this->crossfadeStartValues ) );
+	}
+	this->crossfadeStartMillis = millis();
+	this->crossfadeWeight = 0;
+}
+
 //---------------------------------------------------------------------------------------
 // set
 //
@@ -663,7 +581,7 @@ void LEDMatrix::set( const uint8_t* buf, palette_entry palette[] ) { this->set(
 // set
 //
 // Sets the internal LED buffer to new values based on an indexed source buffer and an
-// associated palette.
+// associated palette. Without immediately, fade() takes care of the transition.
 //
 // Attention: If buf is PROGMEM, make sure it is aligned at 32 bit and its size is
 // a multiple of 4 bytes!
@@ -675,9 +593,46 @@ void LEDMatrix::set( const uint8_t* buf, palette_entry palette[] ) { this->set(
 //---------------------------------------------------------------------------------------
 void LEDMatrix::set( const uint8_t* buf, palette_entry palette[], bool immediately ) {
 	this->setBuffer( this->targetValues, buf, palette );
+	this->updateTarget( immediately );
+}
+
+//---------------------------------------------------------------------------------------
+// set
+//
+// Same as above for a packed buffer
+//
+// -> buf: packed indexed source buffer
+//	  palette: color definition for source buffer
+//	  immediately: if true, display buffer immediately; fade to new colors if false
+// <- --
+//---------------------------------------------------------------------------------------
+template <int BITS> void LEDMatrix::set( const PackedBuffer<BITS>& buf, palette_entry palette[], bool immediately ) {
+	this->setBuffer( this->targetValues, buf, palette );
+	this->updateTarget( immediately );
+}
+template void LEDMatrix::set( const PackedBuffer<2>& buf, palette_entry palette[], bool immediately );
+template void LEDMatrix::set( const PackedBuffer<4>& buf, palette_entry palette[], bool immediately );
 
+//---------------------------------------------------------------------------------------
+// updateTarget
+//
+// Shows the new this->targetValues immediately or lets fade() take care of the
+// transition
+//
+// -> immediately: if true, display the target immediately
+// <- --
+//---------------------------------------------------------------------------------------
+void LEDMatrix::updateTarget( bool immediately ) {
 	if( immediately ) {
-		this->setBuffer( this->currentValues, buf, palette );
+		memcpy( this->currentValues, this->targetValues, sizeof( this->currentValues ) );
+		this->fadeActive = false;
+	} else {
+		// restart a running fade from the current colors if the target has changed
+		uint32_t digest = LEDMatrix::bufferDigest( this->targetValues, 0 );
+		if( digest != this->targetDigest ) {
+			this->targetDigest = digest;
+			this->fadeActive = false;
+		}
 	}
 }
 
@@ -686,7 +641,7 @@ void LEDMatrix::set( const uint8_t* buf, palette_entry palette[], bool immediate
 //
 // Fills a buffer (e. g. this->targetValues) with color data based on indexed source
 // pixels and a palette. Pays attention to 32 bit boundaries, so use with PROGMEM is
-// safe.
+// safe. Brightness correction curves are applied later in show().
 //
 // -> target: color buffer, e. g. this->targetValues or this->currentValues
 //    source: buffer with color indexes
@@ -694,7 +649,7 @@ void LEDMatrix::set( const uint8_t* buf, palette_entry palette[], bool immediate
 // <- --
 //---------------------------------------------------------------------------------------
 void LEDMatrix::setBuffer( uint8_t* target, const uint8_t* source, palette_entry palette[] ) {
-	uint32_t mappedPos, curveOffset;
+	uint32_t mappedPos;
 	uint8_t palette_index;
 
 	// cast source to 32 bit pointer to ensure 32 bit aligned access
@@ -705,7 +660,7 @@ void LEDMatrix::setBuffer( uint8_t* target, const uint8_t* source, palette_entry
 	uint8_t* currentBytes = (uint8_t*)&currentDWord;
 	// this counts bytes from 0...3
 	uint32_t byteCounter = 0;
-	if( ( (uint32_t)source & 3 ) == 0 ) { // 4 byte aligned
+	if( ( (uintptr_t)source & 3 ) == 0 ) { // 4 byte aligned
 		for( int i = 0; i < NUM_PIXELS; i++ ) {
 			// get next 4 bytes
 			if( byteCounter == 0 )
@@ -714,12 +669,11 @@ void LEDMatrix::setBuffer( uint8_t* target, const uint8_t* source, palette_entry
 			palette_index = currentBytes[byteCounter];
 			// palette_index = source[i];
 			mappedPos = LEDMatrix::mapping[i] * 3;
-			curveOffset = LEDMatrix::brightnessCurveSelect[i] << 8;
 
-			// select color value using palette and brightness correction curves
-			target[mappedPos + 0] = brightnessCurvesR[curveOffset + palette[palette_index].r];
-			target[mappedPos + 1] = brightnessCurvesG[curveOffset + palette[palette_index].g];
-			target[mappedPos + 2] = brightnessCurvesB[curveOffset + palette[palette_index].b];
+			// select color value using palette
+			target[mappedPos + 0] = palette[palette_index].r;
+			target[mappedPos + 1] = palette[palette_index].g;
+			target[mappedPos + 2] = palette[palette_index].b;
 
 			byteCounter = ( byteCounter + 1 ) & 0x03;
 		}
@@ -727,12 +681,38 @@ void LEDMatrix::setBuffer( uint8_t* target, const uint8_t* source, palette_entry
 		for( int i = 0; i < NUM_PIXELS; i++ ) {
 			palette_index = source[i];
 			mappedPos = LEDMatrix::mapping[i] * 3;
-			curveOffset = LEDMatrix::brightnessCurveSelect[i] << 8;
 
-			// select color value using palette and brightness correction curves
-			target[mappedPos + 0] = brightnessCurvesR[curveOffset + palette[palette_index].r];
-			target[mappedPos + 1] = brightnessCurvesG[curveOffset + palette[palette_index].g];
-			target[mappedPos + 2] = brightnessCurvesB[curveOffset + palette[palette_index].b];
+			// select color value using palette
+			target[mappedPos + 0] = palette[palette_index].r;
+			target[mappedPos + 1] = palette[palette_index].g;
+			target[mappedPos + 2] = palette[palette_index].b;
+		}
+	}
+}
+
+//---------------------------------------------------------------------------------------
+// setBuffer
+//
+// Same as above for a packed buffer, the indexes are taken from each word in turn
+//
+// -> target: color buffer, e. g. this->targetValues or this->currentValues
+//    source: packed buffer with color indexes
+//	  palette: colors for indexed source buffer
+// <- --
+//---------------------------------------------------------------------------------------
+template <int BITS>
+void LEDMatrix::setBuffer( uint8_t* target, const PackedBuffer<BITS>& source, palette_entry palette[] ) {
+	const int perWord = PackedBuffer<BITS>::PIXELS_PER_WORD;
+	for( int w = 0; w < PackedBuffer<BITS>::WORDS; w++ ) {
+		uint32_t word = source.words[w];
+		int last = w * perWord + perWord < NUM_PIXELS ? w * perWord + perWord : NUM_PIXELS;
+		for( int i = w * perWord; i < last; i++ ) {
+			const palette_entry& color = palette[word & PackedBuffer<BITS>::MAX_INDEX];
+			word >>= BITS;
+			uint32_t mappedPos = LEDMatrix::mapping[i] * 3;
+			target[mappedPos + 0] = color.r;
+			target[mappedPos + 1] = color.g;
+			target[mappedPos + 2] = color.b;
 		}
 	}
 }
@@ -740,57 +720,251 @@ void LEDMatrix::setBuffer( uint8_t* target, const uint8_t* source, palette_entry
 //---------------------------------------------------------------------------------------
 // fade
 //
-// Fade one step of the color values from this->currentValues[i] to
-// this->targetValues[i]. Uses non-linear fade speed depending on distance to target
-// value.
+// Fades this->currentValues towards this->targetValues based on elapsed time. A new
+// fade starts from the colors currently shown whenever the target changes (see set())
+// or differs from the current colors, it takes Config.fadeTime milliseconds and is
+// shaped by Config.fadeEasing.
 //
 // -> --
 // <- --
 //---------------------------------------------------------------------------------------
 void LEDMatrix::fade() {
-	static int prescaler = 0;
-	if( ++prescaler < 2 )
-		return;
-	prescaler = 0;
-
-	int delta;
-	for( int i = 0; i < NUM_PIXELS * 3; i++ ) {
-		delta = this->targetValues[i] - this->currentValues[i];
-		if( delta > 64 )
-			this->currentValues[i] += 8;
-		else if( delta > 16 )
-			this->currentValues[i] += 4;
-		else if( delta > 0 )
-			this->currentValues[i]++;
-		else if( delta < -64 )
-			this->currentValues[i] -= 8;
-		else if( delta < -16 )
-			this->currentValues[i] -= 4;
-		else if( delta < 0 )
-			this->currentValues[i]--;
+	uint32_t now = millis();
+
+	if( !this->fadeActive ) {
+		if( memcmp( this->currentValues, this->targetValues, sizeof( this->currentValues ) ) == 0 )
+			return;
+		memcpy( this->fadeStartValues, this->currentValues, sizeof( this->currentValues ) );
+		this->fadeStartMillis = now;
+		this->fadeActive = true;
+	}
+
+	uint16_t weight = fadeWeight( (FadeEasing)Config.fadeEasing, now - this->fadeStartMillis, Config.fadeTime );
+	fadeBuffer( this->currentValues, this->fadeStartValues, this->targetValues, sizeof( this->currentValues ),
+	            weight );
+	this->fadeShownWeight = weight;
+	if( weight == FADE_WEIGHT_MAX )
+		this->fadeActive = false;
+}
+
+//---------------------------------------------------------------------------------------
+// bufferDigest
+//
+// Calculates a cheap 32 bit digest (FNV-1a over 32 bit words) of a color buffer, used
+// to detect frames identical to the last one sent and changes of the fade target.
+//
+// -> buf: color buffer with NUM_PIXELS * 3 bytes, aligned at 32 bit
+//    seed: additional value to include, e. g. the brightness
+// <- digest of the buffer
+//---------------------------------------------------------------------------------------
+uint32_t LEDMatrix::bufferDigest( const uint8_t* buf, uint32_t seed ) {
+	const uint32_t* words = (const uint32_t*)buf;
+	uint32_t digest = 2166136261u ^ seed;
+
+	for( unsigned int i = 0; i < NUM_PIXELS * 3 / 4; i++ )
+		digest = ( digest ^ words[i] ) * 16777619u;
+
+	// remaining bytes if the buffer size is not a multiple of 4
+	for( unsigned int i = NUM_PIXELS * 3 & ~3u; i < NUM_PIXELS * 3; i++ )
+		digest = ( digest ^ buf[i] ) * 16777619u;
+
+	return digest;
+}
+
+//---------------------------------------------------------------------------------------
+// writePixels
+//
+// Writes this->currentValues into the strip buffer through the brightness tables,
+// blended with the frozen frame while CROSSFADE. With DITHER the upper DITHER_BITS of
+// each fraction are added to the error of the byte and the overflow rounds the output
+// up, so the average over consecutive frames is the exact scaled value (first order
+// temporal error diffusion).
+// The 16 bit pipeline (LED_PIPELINE_16BIT) blends after the lookup instead, in linear
+// light, the fade shown in this frame as well as the crossfade.
+//
+// -> out: pixel buffer of the strip
+// <- true if a fraction was dithered, the next frames differ from this one
+//---------------------------------------------------------------------------------------
+#ifdef LED_PIPELINE_16BIT
+// linear light between a and b, the same for fades and crossfades
+static inline uint16_t blendLight( uint16_t a, uint16_t b, int weight ) {
+	return a + ( ( ( (int32_t)b - a ) * weight ) >> 8 );
+}
+
+template <bool CROSSFADE, bool DITHER> bool LEDMatrix::writePixels( uint8_t* out ) {
+	static constexpr uint8_t wireOrder[3] = { WIRE_ORDER_0, WIRE_ORDER_1, WIRE_ORDER_2 };
+	// a fade rendered into currentValues is blended again from its 8 bit ends
+	bool fading = this->fadeShownWeight < FADE_WEIGHT_MAX;
+	const uint8_t* data = fading ? this->targetValues : this->currentValues;
+	const uint8_t* from = this->fadeStartValues;
+	const uint8_t* start = this->crossfadeStartValues;
+	uint8_t* error = this->ditherError;
+	int fw = this->fadeShownWeight;
+	int cw = this->crossfadeWeight;
+	uint16_t fractions = 0;
+	for( int i = 0; i < NUM_PIXELS; i++ ) {
+		uint16_t( *lut )[256] = this->brightnessLut[this->outputCurve[i]];
+		for( int b = 0; b < 3; b++ ) {
+			int ch = wireOrder[b];
+			uint16_t light = lut[ch][data[ch]];
+			if( fading )
+				light = blendLight( lut[ch][from[ch]], light, fw );
+			if( CROSSFADE )
+				light = blendLight( lut[ch][start[ch]], light, cw );
+			if( DITHER ) {
+				uint16_t sum = error[b] + ( light & DITHER_MASK );
+				out[b] = ( light >> 8 ) + ( sum >> 8 );
+				error[b] = (uint8_t)sum;
+				fractions |= light & DITHER_MASK;
+			} else {
+				out[b] = light >> 8;
+			}
+		}
+		data += 3;
+		from += 3;
+		start += 3;
+		error += LedColorFeature::PixelSize;
+		out += LedColorFeature::PixelSize;
+	}
+	return fractions != 0;
+}
+#else
+template <bool CROSSFADE, bool DITHER> bool LEDMatrix::writePixels( uint8_t* out ) {
+	static constexpr uint8_t wireOrder[3] = { WIRE_ORDER_0, WIRE_ORDER_1, WIRE_ORDER_2 };
+	const uint8_t* data = this->currentValues;
+	const uint8_t* start = this->crossfadeStartValues;
+	uint8_t* error = this->ditherError;
+	int w = this->crossfadeWeight;
+	uint16_t fractions = 0;
+	for( int i = 0; i < NUM_PIXELS; i++ ) {
+		uint16_t( *lut )[256] = this->brightnessLut[this->outputCurve[i]];
+		for( int b = 0; b < 3; b++ ) {
+			int ch = wireOrder[b];
+			uint16_t scaled = lut[ch][CROSSFADE ? crossfadeChannel( start[ch], data[ch], w ) : data[ch]];
+			if( DITHER ) {
+				uint16_t sum = error[b] + ( scaled & DITHER_MASK );
+				out[b] = ( scaled >> 8 ) + ( sum >> 8 );
+				error[b] = (uint8_t)sum;
+				fractions |= scaled & DITHER_MASK;
+			} else {
+				out[b] = scaled >> 8;
+			}
+		}
+		data += 3;
+		start += 3;
+		error += LedColorFeature::PixelSize;
+		out += LedColorFeature::PixelSize;
 	}
+	return fractions != 0;
 }
+#endif
 
 //---------------------------------------------------------------------------------------
 // show
 //
-// Internal method, copies this->currentValues to WS2812 object while applying brightness
+// Internal method, writes this->currentValues directly into the pixel buffer of the
+// WS2812 object while applying brightness correction curves and brightness using the
+// tables prepared by updateBrightnessLut(). this->currentValues is already in physical
+// LED order, the bytes of each pixel are reordered for the strip (WIRE_ORDER, GRB) in
+// the same pass and the buffer is marked dirty once.
+// Frames identical to the last transmitted frame (same digest over color values and
+// brightness) are skipped completely to save CPU time and interrupt load, unless the
+// frame is dithered.
+// During a crossfade (see startCrossfade()) the frozen frame of the previous mode is
+// blended in the same pass.
+// Below Config.ditherBrightness most of the 256 color values collapse into a few
+// output steps, the fraction lost by the scaling is dithered over the next frames
+// then, see writePixels() and refresh().
+// Frames estimated above Config.powerLimit are scaled down in the pixel buffer, see
+// PowerLimiter.
+// The pixel buffer is not the one the DMA transfers from, so the frame is written
+// while the previous one may still be clocked out, flush() starts its transfer.
+//
+// -> frameStartMicros: time the rendering of the frame started
+//    rendered: the frame was rendered by process(), only then the render time is
+//              measured, not for dither steps and frames set by others
+// <- --
+//---------------------------------------------------------------------------------------
+void LEDMatrix::show( uint32_t frameStartMicros, bool rendered ) {
+	// the frozen frame does not change during a crossfade, the weight does
+	uint32_t seed = (uint32_t)this->brightness;
+	if( this->crossfadeWeight < FADE_WEIGHT_MAX )
+		seed |= ( this->crossfadeWeight + 1u ) << 9;
+#ifdef LED_PIPELINE_16BIT
+	// the 8 bit fade may stay the same while the weight moves on
+	if( this->fadeShownWeight < FADE_WEIGHT_MAX )
+		seed |= ( this->fadeShownWeight + 1u ) << 18;
+#endif
+	uint32_t digest = LEDMatrix::bufferDigest( this->currentValues, seed );
+	// the power budget may change while the colors stay the same
+	digest = ( digest ^ Config.powerLimit ) * 16777619u;
+	bool pending = this->ditherPending || this->powerPending;
+	if( this->lastFrameDigestValid && digest == this->lastFrameDigest && !pending ) {
+		this->framesSkipped++;
+		return;
+	}
+	this->lastFrameDigest = digest;
+	this->lastFrameDigestValid = true;
+
+	uint8_t* out = this->output->getPixels();
+	bool dither = this->isDithering();
+	uint32_t cycles = ESP.getCycleCount();
+	if( this->crossfadeWeight < FADE_WEIGHT_MAX )
+		this->ditherPending = dither ? this->writePixels<true, true>( out ) : this->writePixels<true, false>( out );
+	else
+		this->ditherPending = dither ? this->writePixels<false, true>( out ) : this->writePixels<false, false>( out );
+	this->convertCycles = ESP.getCycleCount() - cycles;
+	if( this->convertCycles > this->convertMaxCycles )
+		this->convertMaxCycles = this->convertCycles;
+	this->powerPending =
+	    this->powerLimiter.apply( out, LED_BUFFER_SIZE, LedColorFeature::PixelSize, Config.powerLimit, millis() );
+	this->lastShowMicros = micros();
+	if( rendered ) {
+		this->renderMicros = this->lastShowMicros - frameStartMicros;
+		if( this->renderMicros > this->renderMaxMicros )
+			this->renderMaxMicros = this->renderMicros;
+	}
+	this->showPending = true;
+	if( !this->output->canShow() )
+		this->framesDeferred++;
+	this->flush();
+}
+
+//---------------------------------------------------------------------------------------
+// flush
+//
+// Starts the transfer of the frame written by show() as soon as the output has sent
+// the previous one, instead of waiting for it in Show(). Called from show() and
+// refresh(), also lets the output measure the transfer time.
 //
 // -> --
 // <- --
 //---------------------------------------------------------------------------------------
-void LEDMatrix::show() {
-	uint8_t* data = this->currentValues;
-	int ofs = 0;
+void LEDMatrix::flush() {
+	this->output->poll();
+	if( !this->showPending || !this->output->canShow() )
+		return;
 
-	// copy current color values to LED object and display it
-	for( int i = 0; i < NUM_PIXELS; i++ ) {
-		this->strip->SetPixelColor( i, RgbColor( ( (int)data[ofs + 0] * this->brightness ) >> 8,
-		                                         ( (int)data[ofs + 1] * this->brightness ) >> 8,
-		                                         ( (int)data[ofs + 2] * this->brightness ) >> 8 ) );
-		ofs += 3;
-	}
-	this->strip->Show();
+	this->output->show();
+	this->showPending = false;
+	this->framesSent++;
+}
+
+//---------------------------------------------------------------------------------------
+// refresh
+//
+// Sends a frame still waiting for the transfer of the previous one (see flush()), and
+// the last frame again with the next dither step once DITHER_FRAME_PERIOD has passed
+// since it was written. Called from loop() between the frames of the display mode, so
+// neither depends on the frame period of the mode.
+//
+// -> --
+// <- --
+//---------------------------------------------------------------------------------------
+void LEDMatrix::refresh() {
+	this->flush();
+	if( this->ditherPending && micros() - this->lastShowMicros >= DITHER_FRAME_PERIOD * 1000u )
+		this->show();
 }
 
 //---------------------------------------------------------------------------------------
@@ -822,7 +996,7 @@ int LEDMatrix::getOffset( int x, int y ) {
 //    buf: destination buffer
 // <- --
 //---------------------------------------------------------------------------------------
-void LEDMatrix::fillBackground( int seconds, int milliseconds, uint8_t* buf ) {
+template <int BITS> void LEDMatrix::fillBackground( int seconds, int milliseconds, PackedBuffer<BITS>& buf ) {
 	int pos = ( ( ( seconds * 1000 + milliseconds ) * 110 ) / 60000 ) + 1;
 	if( pos != lastFillPos ) {
 		lastFillPos = pos;
@@ -835,21 +1009,24 @@ void LEDMatrix::fillBackground( int seconds, int milliseconds, uint8_t* buf ) {
 		}
 	}
 	// if( Config.fillMode == 0 || Config.fillMode == 1)
-	for( int i = 0; i < NUM_PIXELS; i++ )
-		buf[i] = ( i < pos ) ? ( fillInvers ? 0 : 2 ) : ( fillInvers ? 2 : 0 );
+	buf.fill( fillInvers ? 2 : 0 );
+	buf.fill( fillInvers ? 0 : 2, 0, pos );
 	// if( Config.fillMode == 2 )
 	// 	for (int i = 0; i < NUM_PIXELS; i++) buf[i] = (i == pos) ? (fillInvers?0:2) : (fillInvers?2:0);
 }
+template void LEDMatrix::fillBackground( int seconds, int milliseconds, PackedBuffer<2>& buf );
+template void LEDMatrix::fillBackground( int seconds, int milliseconds, PackedBuffer<4>& buf );
 
 //---------------------------------------------------------------------------------------
 // rendering methods
 //---------------------------------------------------------------------------------------
 
-void LEDMatrix::renderCorner( uint8_t* target, int m ) {
+template <int BITS> void LEDMatrix::renderCorner( PackedBuffer<BITS>& target, int m ) {
 	// minutes 1...4 for the corners
-	for( int i = 0; i <= ( ( m % 5 ) - 1 ); i++ )
-		target[height * width + i] = 1;
+	target.fill( 1, height * width, height * width + m % 5 );
 }
+template void LEDMatrix::renderCorner( PackedBuffer<2>& target, int m );
+template void LEDMatrix::renderCorner( PackedBuffer<4>& target, int m );
 
 //---------------------------------------------------------------------------------------
 // renderTime
@@ -861,53 +1038,37 @@ void LEDMatrix::renderCorner( uint8_t* target, int m ) {
 //            filled with palette indexes representing the time
 // <- --
 //---------------------------------------------------------------------------------------
-void LEDMatrix::renderTime( uint8_t* target, int h, int m, int s, int ms ) {
+template <int BITS> void LEDMatrix::renderTime( PackedBuffer<BITS>& target, int h, int m, int s, int ms ) {
 	this->fillBackground( s, ms, target );
 
 	if( Config.showItIs ) {
 		// set static LEDs
-		target[0] = 1; // E
-		target[1] = 1; // S
-
-		target[3] = 1; // I
-		target[4] = 1; // S
-		target[5] = 1; // T
+		target.fill( 1, 0, 2 ); // ES
+		target.fill( 1, 3, 6 ); // IST
 	}
 	this->renderCorner( target, m );
+	// no previous time yet (first transition after boot), no words match
+	if( h < 0 || m < 0 )
+		return;
 
-	// iterate over minutes_template
+	// look up the precompiled masks for the minute words and the hour word
 	int mt = Config.minuteType;
 	if( mt > 1 || mt < 0 )
 		mt = 0;
-	int adjust_hour = 0;
-	for( leds_template_t t : LEDMatrix::minutesTemplate[Config.tmpl][mt] ) {
-		// test if this template matches the current minute
-		if( m >= t.param1 && m <= t.param2 ) {
-			// set all LEDs defined in this template
-			for( int i : t.LEDs )
-				target[i] = 1;
-			adjust_hour = t.param0;
-			break;
-		}
-	}
+	int layout = Config.tmpl;
+	if( layout >= NUM_LAYOUTS || layout < 0 )
+		layout = 0;
+	int slot = m / 5;
 
 	// adjust hour display if necessary (e. g. 09:45 = quarter to *TEN* instead of NINE)
-	h += adjust_hour;
-	if( h > 23 )
-		h -= 24;
-
-	// iterate over hours template
-	for( leds_template_t t : LEDMatrix::hoursTemplate[Config.tmpl] ) {
-		// test if this template matches the current hour
-		if( ( t.param1 == h || t.param2 == h ) && ( ( t.param0 == 1 && m < 5 ) ||  // special case full hour
-		                                            ( t.param0 == 2 && m >= 5 ) || // special case hour + minutes
-		                                            ( t.param0 == 0 ) ) )          // normal case
-		{
-			// set all LEDs defined in this template
-			for( int i : t.LEDs )
-				target[i] = 1;
-			break;
-		}
+	h = ( h + pgm_read_byte( &timeMasks.hourAdjust[layout][mt][slot] ) ) % 12;
+
+	const led_mask_t* minuteMask = &timeMasks.minutes[layout][mt][slot];
+	const led_mask_t* hourMask = &timeMasks.hours[layout][m >= 5 ? 1 : 0][h];
+	for( int w = 0; w < LED_MASK_WORDS; w++ ) {
+		uint32_t bits = pgm_read_dword( &minuteMask->words[w] ) | pgm_read_dword( &hourMask->words[w] );
+		// set all LEDs of the mask
+		target.setBits( w, bits, 1 );
 	}
 
 	// DEBUG
@@ -917,958 +1078,20 @@ void LEDMatrix::renderTime( uint8_t* target, int h, int m, int s, int ms ) {
 		Serial.printf( "h=%i, m=%i, s=%i\r\n", this->h, this->m, this->s );
 		for( int y = 0; y < 10; y++ ) {
 			for( int x = 0; x < 11; x++ ) {
-				Serial.print( target[y * 11 + x] );
+				Serial.print( target.get( y * 11 + x ) );
 				Serial.print( ' ' );
 			}
 			Serial.println( ' ' );
 		}
 	}
 }
-
-//---------------------------------------------------------------------------------------
-// renderHourglass
-//
-// Immediately displays an animation step of the hourglass animation.
-// ATTENTION: Animation frames must start at 32 bit boundary each!
-//
-// -> animationStep: Number of current frame [0...HOURGLASS_ANIMATION_FRAMES]
-//    green: Flag to switch the palette color 3 to green instead of yellow (used in the
-//           second half of the hourglass animation to indicate the short wait-for-OTA
-//           window)
-// <- --
-//---------------------------------------------------------------------------------------
-void LEDMatrix::renderHourglass( uint8_t animationStep, bool green ) {
-	// colors in palette: black, white, yellow
-	palette_entry p[] = { { 0, 0, 0 }, { 255, 255, 255 }, { 255, 255, 0 }, { 255, 255, 0 } };
-
-	// delete red component in palette entry 3 to make this color green
-	if( green )
-		p[3].r = 0;
-
-	if( animationStep >= HOURGLASS_ANIMATION_FRAMES )
-		animationStep = 0;
-	this->set( hourglass_animation[animationStep], p, true );
-}
-
-//---------------------------------------------------------------------------------------
-// renderMatrix
-//
-// Renders one frame of the matrix animation and displays it immediately
-//
-// -> --
-// <- --
-//---------------------------------------------------------------------------------------
-void LEDMatrix::renderMatrix() {
-	// clear buffer
-	memset( this->currentValues, 0, sizeof( this->currentValues ) );
-
-	// sort by y coordinate for correct overlapping
-	std::sort( matrix.begin(), matrix.end() );
-
-	// iterate over all matrix objects, move and render them
-	for( MatrixObject& m : this->matrix )
-		m.render( this->currentValues );
-}
-// clang-format off
-const uint32_t LEDMatrix::moonphases[8][10] = {
-	  {
-				  0b0000111000000000,
-				  0b0011000110000000,
-				  0b0100000001000000,
-				  0b0100000001000000,
-				  0b1000000000100000,
-				  0b1000000000100000,
-				  0b0100000001000000,
-				  0b0100000001000000,
-				  0b0011000110000000,
-				  0b0000111000000000
-	  },
-		{
-				  0b0000111000000000,
-				  0b0000001110000000,
-				  0b0000000111000000,
-				  0b0000000111000000,
-				  0b0000000111100000,
-				  0b0000000111100000,
-				  0b0000000111000000,
-				  0b0000000111000000,
-				  0b0000001110000000,
-				  0b0000111000000000
-	  },
-		{
-				  0b0000011000000000,
-				  0b0000011110000000,
-				  0b0000011111000000,
-				  0b0000011111000000,
-				  0b0000011111100000,
-				  0b0000011111100000,
-				  0b0000011111000000,
-				  0b0000011111000000,
-				  0b0000011110000000,
-				  0b0000011000000000
-	  },
-		{
-				  0b0000111000000000,
-				  0b0001111110000000,
-				  0b0001111111000000,
-				  0b0001111111000000,
-				  0b0001111111100000,
-				  0b0001111111100000,
-				  0b0001111111000000,
-				  0b0001111111000000,
-				  0b0001111110000000,
-				  0b0000111000000000
-	  },
-		{
-				  0b0000111000000000,
-				  0b0011111110000000,
-				  0b0111111111000000,
-				  0b0111111111000000,
-				  0b1111111111100000,
-				  0b1111111111100000,
-				  0b0111111111000000,
-				  0b0111111111000000,
-				  0b0011111110000000,
-				  0b0000111000000000
-	  },
-		{
-				  0b0000111000000000,
-				  0b0011111100000000,
-				  0b0111111100000000,
-				  0b0111111100000000,
-				  0b1111111100000000,
-				  0b1111111100000000,
-				  0b0111111100000000,
-				  0b0111111100000000,
-				  0b0011111100000000,
-				  0b0000111000000000
-	  },
-		{
-				  0b0000110000000000,
-				  0b0011110000000000,
-				  0b0111110000000000,
-				  0b0111110000000000,
-				  0b1111110000000000,
-				  0b1111110000000000,
-				  0b0111110000000000,
-				  0b0111110000000000,
-				  0b0011110000000000,
-				  0b0000110000000000
-	  },
-		{
-				  0b0000111000000000,
-				  0b0011100000000000,
-				  0b0111000000000000,
-				  0b0111000000000000,
-				  0b1111000000000000,
-				  0b1111000000000000,
-				  0b0111000000000000,
-				  0b0111000000000000,
-				  0b0011100000000000,
-				  0b0000111000000000
-				
-		}
-};
-// clang-format on
-
-int LEDMatrix::getMoonphase( int y, int m, int d ) {
-	int b, c, e;
-	double jd;
-	if( m < 3 ) {
-		y--;
-		m += 12;
-	}
-	++m;
-	c = 365.25 * y;
-	e = 30.6 * m;
-	jd = c + e + d - 694039.09; // jd is total days elapsed
-	jd /= 29.53;                // divide by the moon cycle (29.53 days)
-	b = jd;                     // int(jd) -> b, take integer part of jd
-	jd -= b;                    // subtract integer part to leave fractional part of original jd
-	b = jd * 8 + 0.5;           // scale fraction from 0-8 and round by adding 0.5
-	b = b & 7;                  // 0 and 8 are the same so turn 8 into 0
-	return b;
-}
-
-void LEDMatrix::renderMoon() {
-	palette_entry palette[3];
-	this->preparePalette( palette );
-	palette[1] = { 255, 255, 255 };
-	int phase = getMoonphase( year, month, day );
-	// Serial.printf("render moon: %i, %i, %i -> phase=%i\r\n", year, month, day, phase);
-	this->fillBackground( this->s, this->ms, animationBuf );
-
-	for( int i = 0; i < height; i++ ) {
-		uint32_t pattern = moonphases[phase][i];
-		for( int j = 0; j < width; j++ ) {
-			if( pattern & ( 1 << ( 15 - j ) ) )
-				animationBuf[i * width + j] = 1;
-		}
-		/*if( this->m != this->lastM ) {
-		  Serial.printf("moon: %i %i %i %i %i %i %i %i %i %i %i \r\n",
-		  animationBuf[i*width+0],animationBuf[i*width+1],animationBuf[i*width+2],animationBuf[i*width+3],animationBuf[i*width+4],animationBuf[i*width+5],animationBuf[i*width+6],
-		  animationBuf[i*width+7],animationBuf[i*width+8],animationBuf[i*width+9],animationBuf[i*width+10] );
-		}*/
-	}
-	// Serial.printf("buf = %08x\r\n", animationBuf);
-	this->set( animationBuf, palette, true );
-}
+template void LEDMatrix::renderTime( PackedBuffer<2>& target, int h, int m, int s, int ms );
+template void LEDMatrix::renderTime( PackedBuffer<4>& target, int h, int m, int s, int ms );
 
 const palette_entry LEDMatrix::black = { 0, 0, 0 };
-// clang-format off
-const palette_entry LEDMatrix::firePalette[256] = {
-	{0, 0, 0}, {4, 0, 0}, {8, 0, 0}, {12, 0, 0}, {16, 0, 0}, {20, 0, 0}, {24, 0, 0}, {28, 0, 0},
-	{32, 0, 0}, {36, 0, 0}, {40, 0, 0}, {44, 0, 0}, {48, 0, 0}, {52, 0, 0}, {56, 0, 0}, {60, 0, 0},
-	{64, 0, 0}, {68, 0, 0}, {72, 0, 0}, {76, 0, 0}, {80, 0, 0}, {85, 0, 0}, {89, 0, 0}, {93, 0, 0},
-	{97, 0, 0}, {101, 0, 0}, {105, 0, 0}, {109, 0, 0}, {113, 0, 0}, {117, 0, 0}, {121, 0, 0}, {125, 0, 0},
-	{129, 0, 0}, {133, 0, 0}, {137, 0, 0}, {141, 0, 0}, {145, 0, 0}, {149, 0, 0}, {153, 0, 0}, {157, 0, 0},
-	{161, 0, 0}, {165, 0, 0}, {170, 0, 0}, {174, 0, 0}, {178, 0, 0}, {182, 0, 0}, {186, 0, 0}, {190, 0, 0},
-	{194, 0, 0}, {198, 0, 0}, {202, 0, 0}, {206, 0, 0}, {210, 0, 0}, {214, 0, 0}, {218, 0, 0}, {222, 0, 0},
-	{226, 0, 0}, {230, 0, 0}, {234, 0, 0}, {238, 0, 0}, {242, 0, 0}, {246, 0, 0}, {250, 0, 0}, {255, 0, 0},
-	{255, 0, 0}, {255, 8, 0}, {255, 16, 0}, {255, 24, 0}, {255, 32, 0}, {255, 41, 0}, {255, 49, 0}, {255, 57, 0},
-	{255, 65, 0}, {255, 74, 0}, {255, 82, 0}, {255, 90, 0}, {255, 98, 0}, {255, 106, 0}, {255, 115, 0}, {255, 123, 0},
-	{255, 131, 0}, {255, 139, 0}, {255, 148, 0}, {255, 156, 0}, {255, 164, 0}, {255, 172, 0}, {255, 180, 0}, {255, 189, 0},
-	{255, 197, 0}, {255, 205, 0}, {255, 213, 0}, {255, 222, 0}, {255, 230, 0}, {255, 238, 0}, {255, 246, 0}, {255, 255, 0},
-	{255, 255, 0}, {255, 255, 1}, {255, 255, 3}, {255, 255, 4}, {255, 255, 6}, {255, 255, 8}, {255, 255, 9}, {255, 255, 11},
-	{255, 255, 12}, {255, 255, 14}, {255, 255, 16}, {255, 255, 17}, {255, 255, 19}, {255, 255, 20}, {255, 255, 22}, {255, 255, 24},
-	{255, 255, 25}, {255, 255, 27}, {255, 255, 28}, {255, 255, 30}, {255, 255, 32}, {255, 255, 33}, {255, 255, 35}, {255, 255, 36},
-	{255, 255, 38}, {255, 255, 40}, {255, 255, 41}, {255, 255, 43}, {255, 255, 44}, {255, 255, 46}, {255, 255, 48}, {255, 255, 49},
-	{255, 255, 51}, {255, 255, 52}, {255, 255, 54}, {255, 255, 56}, {255, 255, 57}, {255, 255, 59}, {255, 255, 60}, {255, 255, 62},
-	{255, 255, 64}, {255, 255, 65}, {255, 255, 67}, {255, 255, 68}, {255, 255, 70}, {255, 255, 72}, {255, 255, 73}, {255, 255, 75},
-	{255, 255, 76}, {255, 255, 78}, {255, 255, 80}, {255, 255, 81}, {255, 255, 83}, {255, 255, 85}, {255, 255, 86}, {255, 255, 88},
-	{255, 255, 89}, {255, 255, 91}, {255, 255, 93}, {255, 255, 94}, {255, 255, 96}, {255, 255, 97}, {255, 255, 99}, {255, 255, 101},
-	{255, 255, 102}, {255, 255, 104}, {255, 255, 105}, {255, 255, 107}, {255, 255, 109}, {255, 255, 110}, {255, 255, 112}, {255, 255, 113},
-	{255, 255, 115}, {255, 255, 117}, {255, 255, 118}, {255, 255, 120}, {255, 255, 121}, {255, 255, 123}, {255, 255, 125}, {255, 255, 126},
-	{255, 255, 128}, {255, 255, 129}, {255, 255, 131}, {255, 255, 133}, {255, 255, 134}, {255, 255, 136}, {255, 255, 137}, {255, 255, 139},
-	{255, 255, 141}, {255, 255, 142}, {255, 255, 144}, {255, 255, 145}, {255, 255, 147}, {255, 255, 149}, {255, 255, 150}, {255, 255, 152},
-	{255, 255, 153}, {255, 255, 155}, {255, 255, 157}, {255, 255, 158}, {255, 255, 160}, {255, 255, 161}, {255, 255, 163}, {255, 255, 165},
-	{255, 255, 166}, {255, 255, 168}, {255, 255, 170}, {255, 255, 171}, {255, 255, 173}, {255, 255, 174}, {255, 255, 176}, {255, 255, 178},
-	{255, 255, 179}, {255, 255, 181}, {255, 255, 182}, {255, 255, 184}, {255, 255, 186}, {255, 255, 187}, {255, 255, 189}, {255, 255, 190},
-	{255, 255, 192}, {255, 255, 194}, {255, 255, 195}, {255, 255, 197}, {255, 255, 198}, {255, 255, 200}, {255, 255, 202}, {255, 255, 203},
-	{255, 255, 205}, {255, 255, 206}, {255, 255, 208}, {255, 255, 210}, {255, 255, 211}, {255, 255, 213}, {255, 255, 214}, {255, 255, 216},
-	{255, 255, 218}, {255, 255, 219}, {255, 255, 221}, {255, 255, 222}, {255, 255, 224}, {255, 255, 226}, {255, 255, 227}, {255, 255, 229},
-	{255, 255, 230}, {255, 255, 232}, {255, 255, 234}, {255, 255, 235}, {255, 255, 237}, {255, 255, 238}, {255, 255, 240}, {255, 255, 242},
-	{255, 255, 243}, {255, 255, 245}, {255, 255, 246}, {255, 255, 248}, {255, 255, 250}, {255, 255, 251}, {255, 255, 253}, {255, 255, 255}
-};
-const palette_entry LEDMatrix::plasmaPalette[256] = {
-	{255, 0, 0}, {255, 6, 0}, {255, 12, 0}, {255, 18, 0}, {255, 24, 0}, {255, 30, 0}, {255, 36, 0}, {255, 42, 0},
-	{255, 48, 0}, {255, 54, 0}, {255, 60, 0}, {255, 66, 0}, {255, 72, 0}, {255, 78, 0}, {255, 84, 0}, {255, 90, 0},
-	{255, 96, 0}, {255, 102, 0}, {255, 108, 0}, {255, 114, 0}, {255, 120, 0}, {255, 126, 0}, {255, 131, 0}, {255, 137, 0},
-	{255, 143, 0}, {255, 149, 0}, {255, 155, 0}, {255, 161, 0}, {255, 167, 0}, {255, 173, 0}, {255, 179, 0}, {255, 185, 0},
-	{255, 191, 0}, {255, 197, 0}, {255, 203, 0}, {255, 209, 0}, {255, 215, 0}, {255, 221, 0}, {255, 227, 0}, {255, 233, 0},
-	{255, 239, 0}, {255, 245, 0}, {255, 251, 0}, {253, 255, 0}, {247, 255, 0}, {241, 255, 0}, {235, 255, 0}, {229, 255, 0},
-	{223, 255, 0}, {217, 255, 0}, {211, 255, 0}, {205, 255, 0}, {199, 255, 0}, {193, 255, 0}, {187, 255, 0}, {181, 255, 0},
-	{175, 255, 0}, {169, 255, 0}, {163, 255, 0}, {157, 255, 0}, {151, 255, 0}, {145, 255, 0}, {139, 255, 0}, {133, 255, 0},
-	{128, 255, 0}, {122, 255, 0}, {116, 255, 0}, {110, 255, 0}, {104, 255, 0}, {98, 255, 0}, {92, 255, 0}, {86, 255, 0},
-	{80, 255, 0}, {74, 255, 0}, {68, 255, 0}, {62, 255, 0}, {56, 255, 0}, {50, 255, 0}, {44, 255, 0}, {38, 255, 0},
-	{32, 255, 0}, {26, 255, 0}, {20, 255, 0}, {14, 255, 0}, {8, 255, 0}, {2, 255, 0}, {0, 255, 4}, {0, 255, 10},
-	{0, 255, 16}, {0, 255, 22}, {0, 255, 28}, {0, 255, 34}, {0, 255, 40}, {0, 255, 46}, {0, 255, 52}, {0, 255, 58},
-	{0, 255, 64}, {0, 255, 70}, {0, 255, 76}, {0, 255, 82}, {0, 255, 88}, {0, 255, 94}, {0, 255, 100}, {0, 255, 106},
-	{0, 255, 112}, {0, 255, 118}, {0, 255, 124}, {0, 255, 129}, {0, 255, 135}, {0, 255, 141}, {0, 255, 147}, {0, 255, 153},
-	{0, 255, 159}, {0, 255, 165}, {0, 255, 171}, {0, 255, 177}, {0, 255, 183}, {0, 255, 189}, {0, 255, 195}, {0, 255, 201},
-	{0, 255, 207}, {0, 255, 213}, {0, 255, 219}, {0, 255, 225}, {0, 255, 231}, {0, 255, 237}, {0, 255, 243}, {0, 255, 249},
-	{0, 255, 255}, {0, 249, 255}, {0, 243, 255}, {0, 237, 255}, {0, 231, 255}, {0, 225, 255}, {0, 219, 255}, {0, 213, 255},
-	{0, 207, 255}, {0, 201, 255}, {0, 195, 255}, {0, 189, 255}, {0, 183, 255}, {0, 177, 255}, {0, 171, 255}, {0, 165, 255},
-	{0, 159, 255}, {0, 153, 255}, {0, 147, 255}, {0, 141, 255}, {0, 135, 255}, {0, 129, 255}, {0, 124, 255}, {0, 118, 255},
-	{0, 112, 255}, {0, 106, 255}, {0, 100, 255}, {0, 94, 255}, {0, 88, 255}, {0, 82, 255}, {0, 76, 255}, {0, 70, 255},
-	{0, 64, 255}, {0, 58, 255}, {0, 52, 255}, {0, 46, 255}, {0, 40, 255}, {0, 34, 255}, {0, 28, 255}, {0, 22, 255},
-	{0, 16, 255}, {0, 10, 255}, {0, 4, 255}, {2, 0, 255}, {8, 0, 255}, {14, 0, 255}, {20, 0, 255}, {26, 0, 255},
-	{32, 0, 255}, {38, 0, 255}, {44, 0, 255}, {50, 0, 255}, {56, 0, 255}, {62, 0, 255}, {68, 0, 255}, {74, 0, 255},
-	{80, 0, 255}, {86, 0, 255}, {92, 0, 255}, {98, 0, 255}, {104, 0, 255}, {110, 0, 255}, {116, 0, 255}, {122, 0, 255},
-	{128, 0, 255}, {133, 0, 255}, {139, 0, 255}, {145, 0, 255}, {151, 0, 255}, {157, 0, 255}, {163, 0, 255}, {169, 0, 255},
-	{175, 0, 255}, {181, 0, 255}, {187, 0, 255}, {193, 0, 255}, {199, 0, 255}, {205, 0, 255}, {211, 0, 255}, {217, 0, 255},
-	{223, 0, 255}, {229, 0, 255}, {235, 0, 255}, {241, 0, 255}, {247, 0, 255}, {253, 0, 255}, {255, 0, 251}, {255, 0, 245},
-	{255, 0, 239}, {255, 0, 233}, {255, 0, 227}, {255, 0, 221}, {255, 0, 215}, {255, 0, 209}, {255, 0, 203}, {255, 0, 197},
-	{255, 0, 191}, {255, 0, 185}, {255, 0, 179}, {255, 0, 173}, {255, 0, 167}, {255, 0, 161}, {255, 0, 155}, {255, 0, 149},
-	{255, 0, 143}, {255, 0, 137}, {255, 0, 131}, {255, 0, 126}, {255, 0, 120}, {255, 0, 114}, {255, 0, 108}, {255, 0, 102},
-	{255, 0, 96}, {255, 0, 90}, {255, 0, 84}, {255, 0, 78}, {255, 0, 72}, {255, 0, 66}, {255, 0, 60}, {255, 0, 54},
-	{255, 0, 48}, {255, 0, 42}, {255, 0, 36}, {255, 0, 30}, {255, 0, 24}, {255, 0, 18}, {255, 0, 12}, {255, 0, 6}
-};
-// clang-format on
-
-double _time = 0;
-void LEDMatrix::renderPlasma() {
-	int color;
-	double cx, cy, xx, yy;
-
-	_time += 0.05;
-
-	for( int y = 0; y < LEDMatrix::height; y++ ) {
-		yy = (double)y / (double)LEDMatrix::height / 3.0;
-		for( int x = 0; x < LEDMatrix::width; x++ ) {
-			xx = (double)x / (double)LEDMatrix::width / 3.0;
-			cx = xx + 0.5 * sin( _time / 5.0 );
-			cy = (double)y / (double)LEDMatrix::height / 3.0 + 0.5 * sin( _time / 3.0 );
-			color = ( sin( sqrt( 100 * ( cx * cx + cy * cy ) + 1 + _time ) +
-			               6.0 * ( xx * sin( _time / 2 ) + yy * cos( _time / 3 ) + _time / 4.0 ) ) +
-			          1.0 ) *
-			        128.0;
-			plasmaBuf[x + y * LEDMatrix::width] = color;
-		}
-	}
-	// for(int i = width*height; i < width*height+4; i++ ) plasmaBuf[i]=0;
-	this->set( plasmaBuf, (palette_entry*)plasmaPalette, true );
-}
-
-void LEDMatrix::renderFire() {
-	int f;
-
-	// iterate over bottom row, create fire seed
-	for( int i = 0; i < LEDMatrix::width; i++ ) {
-		// only set hot spot with probability of 1/4
-		f = ( random( 4 ) == 0 ) ? random( 256 ) : 0;
-
-		// update one pixel in bottom row
-		fireBuf[i + ( LEDMatrix::height - 1 ) * LEDMatrix::width] = f;
-	}
-
-	int y1, y2, l, r;
-	for( int y = 0; y < LEDMatrix::height - 1; y++ ) {
-		y1 = y + 1;
-		if( y1 >= LEDMatrix::height )
-			y1 = LEDMatrix::height - 1;
-		y2 = y + 2;
-		if( y2 >= LEDMatrix::height )
-			y2 = LEDMatrix::height - 1;
-		for( int x = 0; x < LEDMatrix::width; x++ ) {
-			l = x - 1;
-			if( l < 0 )
-				l = 0;
-			r = x + 1;
-			if( r >= LEDMatrix::width )
-				r = LEDMatrix::width - 1;
-			fireBuf[x + y * LEDMatrix::width] =
-			    ( ( fireBuf[y1 * LEDMatrix::width + l] + fireBuf[y1 * LEDMatrix::width + x] +
-			        fireBuf[y1 * LEDMatrix::width + r] + fireBuf[y2 * LEDMatrix::width + x] ) *
-			      32 ) /
-			    129;
-		}
-	}
-	this->set( fireBuf, (palette_entry*)firePalette, true );
-	delay( 100 );
-}
-
-//---------------------------------------------------------------------------------------
-// renderStars
-//
-// Renders one frame of the stars animation and displays it immediately
-//
-// -> --
-// <- --
-//---------------------------------------------------------------------------------------
-void LEDMatrix::renderStars() {
-	// clear buffer
-	memset( this->currentValues, 0, sizeof( this->currentValues ) );
-
-	for( StarObject& s : this->stars )
-		s.render( this->currentValues, this->stars );
-}
-
-//---------------------------------------------------------------------------------------
-// renderHeart
-//
-// Renders one frame of the heart animation and displays it immediately
-//
-// -> --
-// <- --
-//---------------------------------------------------------------------------------------
-void LEDMatrix::renderHeart() {
-	palette_entry palette[2];
-	// clang-format off
-	uint8_t heart[] = {
-		0, 1, 1, 1, 0, 0, 0, 1, 1, 1, 0,
-		1, 1, 1, 1, 1, 0, 1, 1, 1, 1, 1,
-		1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
-		1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
-		0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0,
-		0, 0, 1, 1, 1, 1, 1, 1, 1, 0, 0,
-		0, 0, 0, 1, 1, 1, 1, 1, 0, 0, 0,
-		0, 0, 0, 0, 1, 1, 1, 0, 0, 0, 0,
-		0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0,
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-		1, 1, 1, 1
-	};
-	// clang-format on
-	palette[0] = { 0, 0, 0 };
-	palette[1] = { (uint8_t)this->heartBrightness, 0, 0 };
-	this->set( heart, palette, true );
-
-	switch( this->heartState ) {
-	case 0:
-		if( this->heartBrightness >= 255 )
-			this->heartState = 1;
-		else
-			this->heartBrightness += 32;
-		break;
-
-	case 1:
-		if( this->heartBrightness < 128 )
-			this->heartState = 2;
-		else
-			this->heartBrightness -= 32;
-		break;
-
-	case 2:
-		if( this->heartBrightness >= 255 )
-			this->heartState = 3;
-		else
-			this->heartBrightness += 32;
-		break;
-
-	case 3:
-	default:
-		if( this->heartBrightness <= 0 )
-			this->heartState = 0;
-		else
-			this->heartBrightness -= 4;
-		break;
-	}
-
-	if( this->heartBrightness > 255 )
-		this->heartBrightness = 255;
-	if( this->heartBrightness < 0 )
-		this->heartBrightness = 0;
-}
-
-//---------------------------------------------------------------------------------------
-// prepareExplosion
-//
-// Prepare particles based on current screen state
-//
-//
-// -> source: buffer to read the currently active LEDs from
-// <- --
-//---------------------------------------------------------------------------------------
-void LEDMatrix::prepareExplosion( uint8_t* source ) {
-#define PARTICLE_COUNT 16
-#define PARTICLE_SPEED 0.15f
-
-	float vx, vy, angle;
-	int ofs = 0;
-	Particle* p;
-	int delay;
-	Serial.printf( "prepare explosion ... \n\r" );
-	// compute angle increment
-	float angle_increment = 2.0f * 3.141592654f / (float)( PARTICLE_COUNT );
-
-	/*if( this->particles.size() == 0 ) {
-	  for (int i = 0; i < PARTICLE_COUNT; i++) { // init
-	    p = new Particle(0, 0, 0, 0, 100);
-	    this->particles.push_back(p);
-	  }
-	}*/
-	// iterate over every position in the screen buffer
-	for( int y = 0; y < LEDMatrix::height; y++ ) {
-		for( int x = 0; x < LEDMatrix::width; x++ ) {
-			// create entry in particles vector if current pixel is foreground
-			if( source[ofs++] == 1 ) {
-				// add a random delay of zero to approx. 3 seconds to each
-				// explosion
-				delay = random( 300 );
-
-				// start with angle of zero radians, assign velocity vector
-				// placed on a circle to each particle
-				angle = 0;
-				for( int i = 0; i < PARTICLE_COUNT; i++ ) {
-					// calculate particle speed vector based on angle and
-					// absolute speed value
-					vx = PARTICLE_SPEED * sin( angle );
-					vy = PARTICLE_SPEED * cos( angle );
-
-					// this->particles[i]->init(x, y, vx, vy, delay);
-					p = new Particle( x, y, vx, vy, delay );
-					this->particles.push_back( p );
-					angle += angle_increment;
-				}
-			}
-		}
-	}
-}
-
-bool LEDMatrix::activeParticles() {
-	int c = 0;
-	for( Particle* p : this->particles )
-		if( p->alive )
-			c++;
-	return c;
-}
-
-void LEDMatrix::renderSnake( bool transition, int h, int m ) {
-	uint8_t buf[NUM_PIXELS] __attribute__( ( aligned( 4 ) ) );
-	uint8_t act[NUM_PIXELS] __attribute__( ( aligned( 4 ) ) );
-	palette_entry palette[5]; // 4/5. color for snake
-	this->preparePalette( palette );
-
-	palette[3] = { 255, 0, 0 };
-	palette[4] = { 0, 255, 0 };
-
-	if( transition ) {
-		// prepare new animation with old time
-		this->renderTime( this->animationBuf, h, m, 0, 0 );
-		snakeX = 0;
-		snakeY = 0;
-		snakeDX = 1;
-		snakeHead = 0;
-		snakeTail = 0;
-		snake[snakeHead++] = 0;
-		snakeTicker = snakeSpeed;
-		Serial.printf( "prepare snake ... \n\r" );
-	}
-
-	// create empty buffer filled with seconds color
-	this->fillBackground( this->s, this->ms, buf );
-	this->fillBackground( this->s, this->ms, act );
-
-	this->renderCorner( buf, m );
-
-	this->renderTime( act, this->h, this->m, this->s, this->ms );
-
-	// animate
-	int len = snakeHead > snakeTail ? snakeHead - snakeTail : snakeTail - snakeHead;
-	if( snakeY < height || len > 0 ) { // animate until the tail has vanished
-		if( snakeTicker <= 0 ) {
-			snakeTicker = snakeSpeed;
-
-			if( snakeY < height ) { // move
-				// check if there is someting in current line
-				int hit = 0;
-				for( int x = 0; x < width; x++ ) {
-					if( animationBuf[x + snakeY * width] == 1 || act[x + snakeY * width] == 1 ) {
-						hit = 1;
-						break;
-					}
-				}
-				if( hit )
-					snakeX += snakeDX;
-				else
-					snakeY++;
-				if( snakeX < 0 || snakeX > width - 1 ) {
-					snakeY++;
-					snakeDX = snakeDX == 1 ? -1 : 1;
-					snakeX += snakeDX;
-				}
-				Serial.printf( "snake moved x=%i, y=%i\n\r", snakeX, snakeY );
-				snake[snakeHead++] = snakeY * width + snakeX;
-			}
-			int len = snakeHead > snakeTail ? snakeHead - snakeTail : snakeTail - snakeHead;
-			if( len > 8 || snakeY >= height )
-				snakeTail++;
-			if( snakeHead == SNAKE_LEN )
-				snakeHead = 0;
-			if( snakeTail == SNAKE_LEN )
-				snakeTail = 0;
-		} else {
-			snakeTicker--;
-		}
-		for( int y = 0; y < height; y++ ) {
-			for( int x = 0; x < width; x++ ) {
-				if( y < snakeY ) {
-					buf[x + y * width] = act[x + y * width];
-				} else if( y > snakeY ) {
-					buf[x + y * width] = animationBuf[x + y * width];
-				} else {
-					if( snakeDX == 1 ) { // rennt rechts
-						buf[x + y * width] = x < snakeX ? act[x + y * width] : animationBuf[x + y * width];
-					} else {
-						buf[x + y * width] = x > snakeX ? act[x + y * width] : animationBuf[x + y * width];
-					}
-				}
-			}
-		}
-		uint8_t t = snakeTail;
-		while( t != snakeHead ) {
-			buf[snake[t]] = 4;
-			t++;
-			if( t == SNAKE_LEN )
-				t = 0;
-		}
-		if( snakeY * width + snakeX < width * height )
-			buf[snakeY * width + snakeX] = 3;
-		this->set( buf, palette, true );
-	} else {
-		this->renderTime( buf, this->h, this->m, this->s, this->ms );
-		this->set( buf, palette, true );
-		this->fade();
-	}
-}
-
-//---------------------------------------------------------------------------------------
-// renderExplosion
-//
-// Renders the exploding letters animation
-//
-// -> --
-// <- --
-//---------------------------------------------------------------------------------------
-void LEDMatrix::renderExplosion( bool transition, int h, int m ) {
-	uint8_t buf[NUM_PIXELS] __attribute__( ( aligned( 4 ) ) );
-
-	palette_entry palette[3];
-	this->preparePalette( palette );
-
-	// check if the displayed time has changed
-	if( transition ) {
-		// prepare new animation with old time
-		this->renderTime( buf, h, m, 0, 0 );
-		this->prepareExplosion( buf );
-	}
-
-	// create empty buffer filled with seconds color
-	this->fillBackground( this->s, this->ms, buf );
-
-	this->renderCorner( buf, m );
-
-	// Do we have something to explode?
-	if( this->activeParticles() > 0 ) {
-		// transfer background created by fillBackground to target buffer
-		this->set( buf, palette, true );
-		// iterate over all particles
-		for( Particle* p : this->particles ) {
-			// move and render current particle
-			if( p->alive )
-				p->render( this->currentValues, palette );
-		}
-	} else {
-		for( int i = this->particles.size() - 1; i >= 0; i-- )
-			delete this->particles[i]; // delete in reverse order
-		this->particles.clear();
-		// present the current time in boring mode with simple fading
-		this->renderTime( buf, this->h, this->m, this->s, this->ms );
-		this->set( buf, palette, false );
-		this->fade();
-	}
-}
-
-//---------------------------------------------------------------------------------------
-// prepareFlyingLetters
-//
-// Sets the current buffer as target state for flying letters, initializes current
-// positions of the letters below the visible area with some random jitter
-//
-// -> source: buffer to read the currently active LEDs from
-// <- --
-//---------------------------------------------------------------------------------------
-void LEDMatrix::prepareFlyingLetters( uint8_t* source ) {
-	// transfer the previous flying letters in the leaving letters vector to prepare for
-	// outgoing animation
-	this->leavingLetters.clear();
-	for( xy_t& p : this->arrivingLetters ) {
-		// delay every letter depending on its position
-		// and set new target coordinate
-		if( this->mode == DisplayMode::flyingLettersVerticalUp ) {
-			p.delay = p.y * 2 + p.x + 1 + random( 5 );
-			p.yTarget = -1;
-		} else {
-			p.delay = ( LEDMatrix::height - p.y - 1 ) * 2 + p.x + 1 + random( 5 );
-			p.yTarget = LEDMatrix::height;
-		}
-		this->leavingLetters.push_back( p );
-	}
-
-	// initialize arriving letters from scratch
-	this->arrivingLetters.clear();
-	int ofs = 0;
-
-	// iterate over every position in the screen buffer
-	for( int y = 0; y < LEDMatrix::height; y++ ) {
-		for( int x = 0; x < LEDMatrix::width; x++ ) {
-			// create entry in arrivingLetters vector if current pixel is foreground
-			if( source[ofs++] == 1 ) {
-				if( this->mode == DisplayMode::flyingLettersVerticalUp ) {
-					xy_t p = { x, y, x, LEDMatrix::height, y * 2 + x + 1 + random( 5 ), 200, 0 };
-					this->arrivingLetters.push_back( p );
-				} else {
-					xy_t p = { x, y, x, -1, ( LEDMatrix::height - y - 1 ) * 2 + x + 1 + random( 5 ), 200, 0 };
-					this->arrivingLetters.push_back( p );
-				}
-			}
-		}
-	}
-
-	// DEBUG
-	Serial.printf( "h=%i, m=%i, s=%i, lastH=%i, lastM=%i\r\n", this->h, this->m, this->s, this->lastH, this->lastM );
-	Serial.println( "leavingLetters:" );
-	for( xy_t& p : this->leavingLetters ) {
-		Serial.printf( "  counter=%i, delay=%i, speed=%i, x=%i, y=%i, xTarget=%i, yTarget=%i\r\n", p.counter, p.delay,
-		               p.speed, p.x, p.y, p.xTarget, p.yTarget );
-	}
-	Serial.println( "arrivingLetters:" );
-	for( xy_t& p : this->arrivingLetters ) {
-		Serial.printf( "  counter=%i, delay=%i, speed=%i, x=%i, y=%i, xTarget=%i, yTarget=%i\r\n", p.counter, p.delay,
-		               p.speed, p.x, p.y, p.xTarget, p.yTarget );
-	}
-}
 
 bool LEDMatrix::displayTimeChanged() {
 	bool r = forceTransition || ( this->m / 5 != this->lastM / 5 ) || ( this->h != this->lastH );
 	forceTransition = false;
 	return r;
 }
-
-//---------------------------------------------------------------------------------------
-// renderFlyingLetters
-//
-// Takes the current arrivingLetters and leavingLetters to render the flying letters
-// animation
-//
-// -> --
-// <- --
-//---------------------------------------------------------------------------------------
-void LEDMatrix::renderFlyingLetters( bool transition ) {
-	uint8_t buf[NUM_PIXELS] __attribute__( ( aligned( 4 ) ) );
-
-	palette_entry palette[3];
-	this->preparePalette( palette );
-
-	// check if the displayed time has changed
-	if( transition ) {
-		// prepare new animation
-		this->renderTime( buf, this->h, this->m, this->s, this->ms );
-		this->prepareFlyingLetters( buf );
-	}
-
-	// create empty buffer filled with seconds color
-	this->fillBackground( this->s, this->ms, buf );
-
-	this->renderCorner( buf, m );
-
-	// leaving letters animation has priority
-	if( this->leavingLetters.size() > 0 ) {
-		// count actually moved letters to detect end of animation
-		int movedLetters = 0;
-
-		// iterate over all leavingLetters
-		for( xy_t& p : this->leavingLetters ) {
-			// draw letter only if inside visible area
-			if( p.x >= 0 && p.y >= 0 && p.x < LEDMatrix::width && p.y < LEDMatrix::height )
-				buf[p.x + p.y * LEDMatrix::width] = 1;
-
-			// continue with next letter if the current letter already
-			// reached its target position
-			if( p.y == p.yTarget && p.x == p.xTarget )
-				continue;
-			p.counter += p.speed;
-			movedLetters++;
-			if( p.counter >= 1000 ) {
-				p.counter -= 1000;
-				if( p.delay > 0 ) {
-					// do not move if animation of current letter is delayed
-					p.delay--;
-				} else {
-					if( p.y > p.yTarget )
-						p.y--;
-					else
-						p.y++;
-				}
-			}
-		}
-		if( movedLetters == 0 )
-			this->leavingLetters.clear();
-	} else {
-		// iterate over all arrivingLetters
-		for( xy_t& p : this->arrivingLetters ) {
-			// draw letter only if inside visible area
-			if( p.x >= 0 && p.y >= 0 && p.x < LEDMatrix::width && p.y < LEDMatrix::height )
-				buf[p.x + p.y * LEDMatrix::width] = 1;
-
-			// continue with next letter if the current letter already
-			// reached its target position
-			if( p.y == p.yTarget && p.x == p.xTarget )
-				continue;
-			p.counter += p.speed;
-			if( p.counter >= 1000 ) {
-				p.counter -= 1000;
-				if( p.delay > 0 ) {
-					// do not move if animation of current letter is delayed
-					p.delay--;
-				} else {
-					if( p.y > p.yTarget )
-						p.y--;
-					else
-						p.y++;
-				}
-			}
-		}
-	}
-
-	// present the current content immediately without fading
-	this->set( buf, palette, true );
-}
-
-//---------------------------------------------------------------------------------------
-// renderRed
-//
-// Renders a complete red frame for testing purposes.
-//
-// -> --
-// <- --
-//---------------------------------------------------------------------------------------
-void LEDMatrix::renderRed() {
-	palette_entry palette[2];
-	uint8_t heart[] = { 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
-	                    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
-	                    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
-	                    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1 };
-	palette[0] = { 0, 0, 0 };
-	palette[1] = { 32, 0, 0 };
-	this->set( heart, palette, true );
-}
-
-//---------------------------------------------------------------------------------------
-// renderGreen
-//
-// Renders a complete green frame for testing purposes.
-//
-// -> --
-// <- --
-//---------------------------------------------------------------------------------------
-void LEDMatrix::renderGreen() {
-	palette_entry palette[2];
-	uint8_t heart[] = { 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
-	                    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
-	                    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
-	                    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1 };
-	palette[0] = { 0, 0, 0 };
-	palette[1] = { 0, 32, 0 };
-	this->set( heart, palette, true );
-}
-
-//---------------------------------------------------------------------------------------
-// renderBlue
-//
-// Renders a complete blue frame for testing purposes.
-//
-// -> --
-// <- --
-//---------------------------------------------------------------------------------------
-void LEDMatrix::renderBlue() {
-	palette_entry palette[2];
-	uint8_t heart[] = { 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
-	                    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
-	                    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
-	                    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1 };
-	palette[0] = { 0, 0, 0 };
-	palette[1] = { 0, 0, 32 };
-	this->set( heart, palette, true );
-}
-
-//---------------------------------------------------------------------------------------
-// renderUpdate
-//
-// Renders the OTA update screen with progress information depending on
-// Config.updateProgress
-//
-// -> --
-// <- --
-//---------------------------------------------------------------------------------------
-void LEDMatrix::renderUpdate() {
-	// clang-format off
-	uint8_t update[] = {
-		0, 0, 0, 1, 1, 1, 1, 1, 0, 0, 0,
-		0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0,
-		0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0,
-		0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0,
-		0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0,
-		0, 1, 1, 1, 0, 0, 0, 1, 1, 1, 0,
-		0, 0, 1, 0, 0, 0, 0, 0, 1, 0, 0,
-		0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0,
-		0, 0, 0, 0, 1, 0, 1, 0, 0, 0, 0,
-		0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0,
-		1, 1, 1, 1
-	};
-	// clang-format on
-	palette_entry p[] = { { 0, 0, 0 }, { 255, 0, 0 }, { 42, 21, 0 }, { 255, 85, 0 } };
-	for( int i = 0; i < 110; i++ ) {
-		if( i < Config.updateProgress ) {
-			if( update[i] == 0 )
-				update[i] = 2;
-			else
-				update[i] = 3;
-		}
-	}
-	this->set( update, p, true );
-}
-
-//---------------------------------------------------------------------------------------
-// renderUpdateComplete
-//
-// Renders the OTA update complete screen
-//
-// -> --
-// <- --
-//---------------------------------------------------------------------------------------
-void LEDMatrix::renderUpdateComplete() {
-	// clang-format off
-	const uint8_t update_ok[] = {
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0,
-		0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0,
-		0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0,
-		0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0,
-		0, 0, 0, 1, 0, 1, 0, 0, 0, 0, 0,
-		0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0,
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-		1, 1, 1, 1
-	};
-	// clang-format on
-	palette_entry p[] = { { 0, 21, 0 }, { 0, 255, 0 } };
-	this->set( update_ok, p, true );
-}
-
-//---------------------------------------------------------------------------------------
-// renderUpdateError
-//
-// Renders the OTA update error screen
-//
-// -> --
-// <- --
-//---------------------------------------------------------------------------------------
-void LEDMatrix::renderUpdateError() {
-	// clang-format off
-	const uint8_t update_err[] = {
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-		0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0,
-		0, 0, 0, 0, 1, 0, 1, 0, 0, 0, 0,
-		0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0,
-		0, 0, 0, 0, 1, 0, 1, 0, 0, 0, 0,
-		0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0,
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-		1, 1, 1, 1
-	};
-	// clang-format on
-	palette_entry p[] = { { 0, 0, 0 }, { 255, 0, 0 } };
-	this->set( update_err, p, true );
-}
-
-//---------------------------------------------------------------------------------------
-// renderWifiManager
-//
-// Renders the WifiManager screen
-//
-// -> --
-// <- --
-//---------------------------------------------------------------------------------------
-void LEDMatrix::renderWifiManager() {
-	// clang-format off
-	const uint8_t wifimanager[] = {
-		0, 0, 0, 1, 1, 1, 1, 0, 0, 0, 0,
-		0, 0, 1, 1, 0, 0, 1, 1, 0, 0, 0,
-		0, 0, 1, 1, 0, 0, 1, 1, 0, 0, 0,
-		0, 0, 0, 0, 0, 0, 1, 1, 0, 0, 0,
-		0, 0, 0, 0, 0, 1, 1, 0, 0, 0, 0,
-		0, 0, 0, 0, 1, 1, 0, 0, 0, 0, 0,
-		0, 0, 0, 0, 1, 1, 0, 0, 0, 0, 0,
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-		0, 0, 0, 0, 1, 1, 0, 0, 0, 0, 0,
-		0, 0, 0, 0, 1, 1, 0, 0, 0, 0, 0,
-		1, 1, 1, 1
-	};
-	// clang-format on
-	palette_entry p[] = { { 0, 0, 0 }, { 255, 255, 0 } };
-	this->set( wifimanager, p, true );
-}
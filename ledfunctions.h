@@ -29,23 +29,43 @@
 #include <stdint.h>
 #include <vector>
 
+#include "brightnesscurves.h"
+#include "compositor.h"
 #include "config.h"
+#include "effect.h"
+#include "effects.h"
+#include "fadeengine.h"
+#include "fbkernels.h"
+#include "fire.h"
+#include "frameinterpolator.h"
+#include "ledoutput.h"
 #include "matrixobject.h"
+#include "packedbuffer.h"
 #include "particle.h"
+#include "particlepool.h"
+#include "plasma.h"
+#include "powerlimiter.h"
 #include "starobject.h"
-
-typedef struct _leds_template_t {
-	int param0, param1, param2;
-	const std::vector<int> LEDs;
-} leds_template_t;
-
-typedef struct _xy_t {
-	int xTarget, yTarget, x, y, delay, speed, counter;
-} xy_t;
-
-#define NUM_MATRIX_OBJECTS 25
-#define NUM_STARS 10
-#define NUM_BRIGHTNESS_CURVES 2
+#include "timemasks.h"
+
+// frame period of the display modes in milliseconds, see effectTable[] in effects.cpp
+#define DEFAULT_FRAME_PERIOD 10
+// fraction bits below the 8 bit output that are dithered over consecutive frames and
+// the frame period in milliseconds while dithering, see show() and refresh()
+#define DITHER_BITS 2
+#define DITHER_FRAME_PERIOD 5
+#define DITHER_MASK ( ( 0xFF << ( 8 - DITHER_BITS ) ) & 0xFF )
+
+// The effects render 8 bit colors. By default show() crossfades these bytes and looks
+// up curve and brightness with an 8 bit curve. The 16 bit pipeline looks up 8.8 fixed
+// point curves first and blends the running fade and crossfade in linear light, the
+// output is only quantized (or dithered) once. The brightness tables are 16 bit in
+// both pipelines, the 8.8 curves cost about 1.5 KB flash more. currentValues and
+// targetValues (and with them the particles) stay 8 bit: 16 bit buffers would only
+// cost 684 bytes RAM, but every effect writes bytes into them. Compare the conversion
+// cycles of both (getConvertCycles(), debug output) on the ESP8266, or frame_bench
+// with frame_bench16 of the host build.
+// #define LED_PIPELINE_16BIT
 
 class LEDMatrix {
 public:
@@ -61,22 +81,52 @@ public:
 	}
 	void setBrightness( int brightness );
 	void setMode( DisplayMode newMode );
-	void show();
+	int getFramePeriod() { return LEDMatrix::getFramePeriod( this->mode ); }
+	static int getFramePeriod( DisplayMode m );
+	void show() { this->show( 0, false ); }
+	void refresh();
+	void flush();
+	bool isDithering() { return this->brightness < Config.ditherBrightness; }
 	void resetRainbowColor();
 	void setDisplayOn( bool val ) { this->displayOn = val; }
+	bool isDisplayOn() { return this->displayOn; }
+	uint32_t getFramesSent() { return this->framesSent; }
+	uint32_t getFramesSkipped() { return this->framesSkipped; }
+	uint32_t getFramesDeferred() { return this->framesDeferred; }
+	uint32_t getRenderMicros() { return this->renderMicros; }
+	uint32_t getRenderMaxMicros() { return this->renderMaxMicros; }
+	uint32_t getConvertCycles() { return this->convertCycles; }
+	uint32_t getConvertMaxCycles() { return this->convertMaxCycles; }
+	uint32_t getTransferMicros() { return this->output->getTransferMicros(); }
+	void setOutput( LedOutputMethod method );
+	LedOutput* getOutput() { return this->output; }
+	PowerLimiter& getPowerLimiter() { return this->powerLimiter; }
+	bool isCrossfading() { return this->crossfadeWeight < FADE_WEIGHT_MAX; }
 	static int getOffset( int x, int y );
+	// offset without bounds check, only for coordinates inside the matrix
+	static int getOffsetUnchecked( int x, int y ) { return LEDMatrix::mapping[x + y * LEDMatrix::width] * 3; }
+	// offset of a logical pixel 0...NUM_PIXELS - 1 (row by row, then the corners)
+	static int getPixelOffset( int i ) { return LEDMatrix::mapping[i] * 3; }
 	static const int width = 11;
 	static const int height = 10;
-	uint8_t currentValues[NUM_PIXELS * 3];
+	uint8_t currentValues[NUM_PIXELS * 3] __attribute__( ( aligned( 4 ) ) );
+
+	// helpers for the effects, see effects.cpp
+	void preparePalette( palette_entry* palette );
+	template <int BITS> void fillBackground( int seconds, int milliseconds, PackedBuffer<BITS>& buf );
+	template <int BITS> void renderCorner( PackedBuffer<BITS>& target, int m );
+	template <int BITS> void renderTime( PackedBuffer<BITS>& target, int h, int m, int s, int ms );
+	void fade();
+	void renderEffect( Effect* effect, DisplayMode m, const effect_frame_t& frame ) {
+		this->interpolator.render( effect, m, *this, frame );
+	}
+	void set( const uint8_t* buf, palette_entry palette[] );
+	void set( const uint8_t* buf, palette_entry palette[], bool immediately );
+	template <int BITS> void set( const PackedBuffer<BITS>& buf, palette_entry palette[], bool immediately );
 
 private:
-	static const std::vector<leds_template_t> hoursTemplate[3];
-	static const std::vector<leds_template_t> minutesTemplate[3][2];
-	static const palette_entry firePalette[];
-	static const palette_entry plasmaPalette[];
 	static const palette_entry black;
 	static const DisplayMode randomModes[];
-	static const uint32_t moonphases[8][10];
 
 	DisplayMode mode = DisplayMode::plain;
 	DisplayMode randomMode = DisplayMode::plain;
@@ -86,17 +136,28 @@ private:
 	int rainbowIndex = 0;
 	palette_entry currentRainbowColor;
 
-	std::vector<Particle*> particles;
-	std::vector<xy_t> arrivingLetters;
-	std::vector<xy_t> leavingLetters;
-	std::vector<MatrixObject> matrix;
-	std::vector<StarObject> stars;
-	uint8_t targetValues[NUM_PIXELS * 3];
-	uint8_t animationBuf[NUM_PIXELS];
+	// state of the current display mode
+	EffectArena<EFFECT_ARENA_SIZE> effects;
+	// steps of the simulation effects, shared by the mode and the background effect
+	FrameInterpolator interpolator;
+	uint8_t targetValues[NUM_PIXELS * 3] __attribute__( ( aligned( 4 ) ) );
+	// colors at the beginning of the running fade, see fade()
+	uint8_t fadeStartValues[NUM_PIXELS * 3] __attribute__( ( aligned( 4 ) ) );
+	uint32_t fadeStartMillis = 0;
+	uint32_t targetDigest = 0;
+	bool fadeActive = false;
+	// weight of the fade rendered into the current frame by fade(), the 16 bit pipeline
+	// blends fadeStartValues and targetValues in show() instead of currentValues
+	uint16_t fadeShownWeight = FADE_WEIGHT_MAX;
+	// frame shown when the mode changed, show() blends it with the frames of the new
+	// mode for Config.crossfadeTime milliseconds, see startCrossfade()
+	uint8_t crossfadeStartValues[NUM_PIXELS * 3] __attribute__( ( aligned( 4 ) ) );
+	uint32_t crossfadeStartMillis = 0;
+	uint16_t crossfadeWeight = FADE_WEIGHT_MAX;
 	// Adafruit_NeoPixel *pixels = NULL;
-	NeoPixelBus<NeoGrbFeature, NeoEsp8266Dma800KbpsMethod>* strip = NULL; //(NUM_PIXELS);
-	int heartBrightness = 0;
-	int heartState = 0;
+	LedOutput* output = NULL;
+	LedOutputMethod outputMethod = LedOutputMethod::invalid;
+	int pin = 0;
 	int brightness = 96;
 	int h = 0;
 	int m = 0;
@@ -110,60 +171,60 @@ private:
 	bool forceTransition = false;
 	int lastFillPos = 0;
 
-	u_int8_t snakeX = 0;
-	u_int8_t snakeY = 0;
-#define SNAKE_LEN 20
-	u_int8_t snake[SNAKE_LEN + 1];
-	u_int8_t snakeHead;
-	u_int8_t snakeTail;
-	int snakeDX = 1;
-	int snakeTicker = 0;
-	int snakeSpeed = 10;
+	// brightness correction curve and global brightness folded into one 8.8 fixed point
+	// table per curve and color channel, rebuilt by setBrightness(), see show()
+	uint16_t brightnessLut[NUM_BRIGHTNESS_CURVES][3][256];
+	// brightness curve for each physical LED position
+	uint8_t outputCurve[NUM_PIXELS];
+	// fraction carried to the next frame for each byte in the strip buffer while
+	// dithering, see show()
+	uint8_t ditherError[LED_BUFFER_SIZE];
+	// the last frame sent has dithered pixels, refresh() sends it again
+	bool ditherPending = false;
+	uint32_t lastShowMicros = 0;
+
+	// digest of the last frame transmitted to the LEDs, see show()
+	uint32_t lastFrameDigest = 0;
+	bool lastFrameDigestValid = false;
+	uint32_t framesSent = 0;
+	uint32_t framesSkipped = 0;
+
+	// the strip transfers a frame (DMA) while the next one is rendered into its pixel
+	// buffer, show() leaves the frame pending until the transfer is done, see flush()
+	bool showPending = false;
+	uint32_t framesDeferred = 0;
+	// render time (effect and conversion into the pixel buffer) of the last frame and
+	// the maximum
+	uint32_t renderMicros = 0;
+	uint32_t renderMaxMicros = 0;
+	// CPU cycles of writePixels() for the last frame and the maximum, the cost of the
+	// 8 or 16 bit pipeline
+	uint32_t convertCycles = 0;
+	uint32_t convertMaxCycles = 0;
+
+	// scales frames above Config.powerLimit down, the scale still rises after the load
+	// dropped, show() sends the same colors again then
+	PowerLimiter powerLimiter;
+	bool powerPending = false;
 
 	bool fillInvers;
 
-	int getMoonphase( int y, int m, int d );
-	bool activeParticles();
-	void fillBackground( int seconds, int milliseconds, uint8_t* buf );
-	void renderCorner( uint8_t* target, int m );
-	void renderRed();
-	void renderGreen();
-	void renderBlue();
-	void renderMatrix();
-	void renderHeart();
-	void renderFire();
-	void renderPlasma();
-	void renderStars();
-	void renderMoon();
-	void renderUpdate();
-	void renderUpdateComplete();
-	void renderUpdateError();
-	void renderHourglass( uint8_t animationStep, bool green );
-	void renderWifiManager();
-	void renderTime( uint8_t* target, int h, int m, int s, int ms );
-	void renderFlyingLetters( bool transition );
-	void prepareFlyingLetters( uint8_t* source );
-	void renderExplosion( bool transition, int initHour, int initMinute );
-	void renderSnake( bool transition, int initHour, int initMinute );
-	void prepareExplosion( uint8_t* source );
-	void fade();
-	void preparePalette( palette_entry* palette );
+	static uint32_t bufferDigest( const uint8_t* buf, uint32_t seed );
+	void updateBrightnessLut();
 	bool displayTimeChanged();
-	bool modeHasTransition( DisplayMode m );
+	void startCrossfade();
+	void show( uint32_t frameStartMicros, bool rendered );
+	template <bool CROSSFADE, bool DITHER> bool writePixels( uint8_t* out );
 
-	void set( const uint8_t* buf, palette_entry palette[] );
-	void set( const uint8_t* buf, palette_entry palette[], bool immediately );
 	void setBuffer( uint8_t* target, const uint8_t* source, palette_entry palette[] );
+	template <int BITS> void setBuffer( uint8_t* target, const PackedBuffer<BITS>& source, palette_entry palette[] );
+	void updateTarget( bool immediately );
 
 	// this mapping table maps the linear memory buffer structure used throughout the
 	// project to the physical layout of the LEDs
 	static const uint32_t PROGMEM mapping[NUM_PIXELS];
 
 	static const uint32_t PROGMEM brightnessCurveSelect[NUM_PIXELS];
-	static const uint32_t PROGMEM brightnessCurvesR[256 * NUM_BRIGHTNESS_CURVES];
-	static const uint32_t PROGMEM brightnessCurvesG[256 * NUM_BRIGHTNESS_CURVES];
-	static const uint32_t PROGMEM brightnessCurvesB[256 * NUM_BRIGHTNESS_CURVES];
-	;
 };
 
 extern LEDMatrix LED;
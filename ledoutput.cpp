@@ -0,0 +1,114 @@
+// ESP8266 Wordclock
+// Copyright (C) 2016 Thoralt Franz, https://github.com/thoralt
+// also (C) 2021 by Stefan Rinke, https://github.com/sker65
+//
+//  Output backends for the LED strip. LEDMatrix writes each frame into the pixel
+//  buffer of a LedOutput and calls show(), the backend is chosen at runtime with
+//  Config.ledOutput: the DMA (I2S), UART1 or bit bang method of NeoPixelBus, or the
+//  recorder which sends nothing and is used by the host tests. Every backend reports
+//  the CPU cycles spent in show() and the time until the transfer is done, so the
+//  methods can be compared on a board without recompiling.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#include <string.h>
+
+#include "ledoutput.h"
+
+//---------------------------------------------------------------------------------------
+// show
+//
+// Starts the transfer of the pixel buffer and measures the CPU cycles it takes. The
+// bit bang method sends the whole frame with interrupts disabled, the DMA and UART
+// methods only encode the frame and return.
+//
+// -> --
+// <- --
+//---------------------------------------------------------------------------------------
+void LedOutput::show() {
+	this->poll();
+	uint32_t start = ESP.getCycleCount();
+	this->send();
+	this->showCycles = ESP.getCycleCount() - start;
+	if( this->showCycles > this->showMaxCycles )
+		this->showMaxCycles = this->showCycles;
+	this->transferStartMicros = micros();
+	this->transferActive = true;
+	this->showCount++;
+}
+
+//---------------------------------------------------------------------------------------
+// poll
+//
+// Measures the transfer time: the time between show() and the first call finding the
+// backend ready again, exact to the loop() cycle
+//
+// -> --
+// <- --
+//---------------------------------------------------------------------------------------
+void LedOutput::poll() {
+	if( this->transferActive && this->canShow() ) {
+		this->transferMicros = micros() - this->transferStartMicros;
+		this->transferActive = false;
+	}
+}
+
+#ifdef WORDCLOCK_HOST
+//---------------------------------------------------------------------------------------
+// RecordingOutput
+//---------------------------------------------------------------------------------------
+
+bool RecordingOutput::canShow() { return micros() - this->sendMicros >= this->simulatedTransferMicros; }
+
+//---------------------------------------------------------------------------------------
+// send
+//
+// Records the frame and adds it to the digest (FNV-1a over all frames sent)
+//
+// -> --
+// <- --
+//---------------------------------------------------------------------------------------
+void RecordingOutput::send() {
+	if( !this->canShow() )
+		this->blockedShows++;
+	memcpy( this->frame, this->pixels, sizeof( this->frame ) );
+	for( uint8_t b : this->frame )
+		this->digest = ( this->digest ^ b ) * 16777619u;
+	this->sendMicros = micros();
+}
+#endif
+
+//---------------------------------------------------------------------------------------
+// createLedOutput
+//
+// Creates the backend for an output method
+//
+// -> method: backend, see Config.ledOutput
+//    pin: data pin, only used by the bit bang method (DMA sends on RX, UART1 on GPIO2)
+// <- new backend, the DMA method for unknown values
+//---------------------------------------------------------------------------------------
+LedOutput* createLedOutput( LedOutputMethod method, uint8_t pin ) {
+	switch( method ) {
+	case LedOutputMethod::uart:
+		return new NeoPixelOutput<NeoEsp8266Uart1800KbpsMethod>( "uart", pin );
+	case LedOutputMethod::bitBang:
+		return new NeoPixelOutput<NeoEsp8266BitBang800KbpsMethod>( "bitbang", pin );
+#ifdef WORDCLOCK_HOST
+	case LedOutputMethod::recorder:
+		return new RecordingOutput();
+#endif
+	case LedOutputMethod::dma:
+	default:
+		return new NeoPixelOutput<NeoEsp8266Dma800KbpsMethod>( "dma", pin );
+	}
+}
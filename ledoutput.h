@@ -0,0 +1,118 @@
+// ESP8266 Wordclock
+// Copyright (C) 2016 Thoralt Franz, https://github.com/thoralt
+// also (C) 2021 by Stefan Rinke, https://github.com/sker65
+//
+//  See ledoutput.cpp for description.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#pragma once
+
+#include <NeoPixelBus.h>
+#include <stdint.h>
+
+#include "config.h"
+
+// byte order of the LEDs, LEDMatrix::show() writes directly into the pixel buffer
+typedef NeoGrbFeature LedColorFeature;
+// color channel (0...2 for r, g, b) of each byte of a pixel in the strip buffer,
+// must match LedColorFeature (GRB)
+#define WIRE_ORDER_0 1
+#define WIRE_ORDER_1 0
+#define WIRE_ORDER_2 2
+
+#define LED_BUFFER_SIZE ( NUM_PIXELS * LedColorFeature::PixelSize )
+
+// index is Config.ledOutput, the recorder only exists in the host build
+enum class LedOutputMethod { dma, uart, bitBang, recorder, invalid };
+
+class LedOutput {
+public:
+	virtual ~LedOutput() {}
+	virtual const char* getName() = 0;
+	// buffer for the next frame, may be written while the previous frame is sent
+	virtual uint8_t* getPixels() = 0;
+	// the previous transfer is done, show() would not wait
+	virtual bool canShow() = 0;
+	void show();
+	void poll();
+
+	// CPU cycles of the last show() and the maximum, duration of the last transfer
+	// as seen by poll()
+	uint32_t getShowCycles() { return this->showCycles; }
+	uint32_t getShowMaxCycles() { return this->showMaxCycles; }
+	uint32_t getTransferMicros() { return this->transferMicros; }
+	uint32_t getShowCount() { return this->showCount; }
+
+protected:
+	// starts the transfer of getPixels()
+	virtual void send() = 0;
+
+private:
+	uint32_t showCycles = 0;
+	uint32_t showMaxCycles = 0;
+	uint32_t transferMicros = 0;
+	uint32_t transferStartMicros = 0;
+	bool transferActive = false;
+	uint32_t showCount = 0;
+};
+
+// one of the NeoPixelBus output methods
+template <typename T_METHOD> class NeoPixelOutput : public LedOutput {
+public:
+	NeoPixelOutput( const char* name, uint8_t pin ) : name( name ), strip( NUM_PIXELS, pin ) { this->strip.Begin(); }
+	const char* getName() override { return this->name; }
+	uint8_t* getPixels() override { return this->strip.Pixels(); }
+	bool canShow() override { return this->strip.CanShow(); }
+
+protected:
+	void send() override {
+		this->strip.Dirty();
+		this->strip.Show();
+	}
+
+private:
+	const char* name;
+	NeoPixelBus<LedColorFeature, T_METHOD> strip;
+};
+
+#ifdef WORDCLOCK_HOST
+// sends nothing, keeps the last frame and a digest over all frames sent, for the host
+// tests and benchmarks
+class RecordingOutput : public LedOutput {
+public:
+	const char* getName() override { return "recorder"; }
+	uint8_t* getPixels() override { return this->pixels; }
+	bool canShow() override;
+
+	const uint8_t* getFrame() { return this->frame; }
+	uint32_t getDigest() { return this->digest; }
+	// time a transfer would take, canShow() is false for that long after show()
+	void setTransferMicros( uint32_t transferMicros ) { this->simulatedTransferMicros = transferMicros; }
+	// show() called while the simulated transfer was running, a strip would wait
+	uint32_t getBlockedShows() { return this->blockedShows; }
+
+protected:
+	void send() override;
+
+private:
+	uint8_t pixels[LED_BUFFER_SIZE] __attribute__( ( aligned( 4 ) ) ) = {};
+	uint8_t frame[LED_BUFFER_SIZE] = {};
+	uint32_t digest = 2166136261u;
+	uint32_t simulatedTransferMicros = 0;
+	uint32_t sendMicros = 0;
+	uint32_t blockedShows = 0;
+};
+#endif
+
+LedOutput* createLedOutput( LedOutputMethod method, uint8_t pin );
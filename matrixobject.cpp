@@ -3,6 +3,13 @@
 //
 //  This class represents one "Matrix Pixel" for the matrix screen saver.
 //
+//  The objects do not draw into the RGB buffer directly. Each one writes the
+//  brightness level of its trail into a level buffer stored column by column,
+//  keeping the maximum of all trails per pixel. As the gradient gets darker with
+//  every step, the brightest level is what drawing the objects from bottom to top
+//  produced before, without sorting them. resolve() finally converts the levels to
+//  colors from the gradient table in flash.
+//
 // This program is free software: you can redistribute it and/or modify
 // it under the terms of the GNU General Public License as published by
 // the Free Software Foundation, either version 3 of the License, or
@@ -18,12 +25,13 @@
 
 #include "matrixobject.h"
 #include "ledfunctions.h"
+#include <algorithm>
 
+// clang-format off
 //---------------------------------------------------------------------------------------
-// initializes the static gradient palette
+// gradient from the head of the trail upwards
 //---------------------------------------------------------------------------------------
-// clang-format off
-const std::vector<palette_entry> MatrixObject::MatrixGradient = {
+static const matrix_gradient_t PROGMEM matrixGradient = { {
 	{ 255, 255, 255 },
 	{ 128, 255, 128 },
 	{ 64, 255, 64 },
@@ -35,8 +43,9 @@ const std::vector<palette_entry> MatrixObject::MatrixGradient = {
 	{ 0, 8, 0 },
 	{ 0, 2, 0 },
 	{ 0, 1, 0 },
-	{ 0, 0, 0 } };
+	{ 0, 0, 0 } } };
 // clang-format on
+
 //---------------------------------------------------------------------------------------
 // MatrixObject
 //
@@ -45,7 +54,7 @@ const std::vector<palette_entry> MatrixObject::MatrixGradient = {
 // -> --
 // <- --
 //---------------------------------------------------------------------------------------
-MatrixObject::MatrixObject() { this->randomize(); }
+MatrixObject::MatrixObject() { this->randomize( DEFAULT_MATRIX_DENSITY ); }
 
 //---------------------------------------------------------------------------------------
 // move
@@ -53,17 +62,17 @@ MatrixObject::MatrixObject() { this->randomize(); }
 // Moves the matrix object using prescaler. Assigns new random coordinates if object
 // leaves screen.
 //
-// -> --
+// -> density: see randomize()
 // <- --
 //---------------------------------------------------------------------------------------
-void MatrixObject::move() {
+void MatrixObject::move( int density ) {
 	this->prescaler += this->speed;
 	if( this->prescaler > 30000 ) {
 		this->prescaler -= 30000;
 		this->y++;
-		int limit = LEDMatrix::height + MatrixObject::MatrixGradient.size();
+		int limit = LEDMatrix::height + MATRIX_GRADIENT_LENGTH;
 		if( this->y > limit )
-			this->randomize();
+			this->randomize( density );
 	}
 }
 
@@ -72,12 +81,14 @@ void MatrixObject::move() {
 //
 // Assigns new random coordinates, initializes speed and prescaler counter.
 //
-// -> --
+// -> density: in percent, the object restarts up to 25 * 100 / density rows above
+//             the screen, so higher values shorten the gaps between the trails
 // <- --
 //---------------------------------------------------------------------------------------
-void MatrixObject::randomize() {
+void MatrixObject::randomize( int density ) {
+	int range = 25 * 100 / density;
 	this->x = random( LEDMatrix::width ); //   0 ... width
-	this->y = random( 25 ) - 25;          // -25 ... -1
+	this->y = random( range ) - range;    // -range ... -1
 	this->speed = MatrixObject::MinMatrixSpeed + random( MatrixObject::MaxMatrixSpeed - MatrixObject::MinMatrixSpeed );
 	this->prescaler = 0;
 }
@@ -85,30 +96,63 @@ void MatrixObject::randomize() {
 //---------------------------------------------------------------------------------------
 // render
 //
-// Moves and renders the matrix object to an RGB buffer. Uses the MatrixGradient palette
-// to draw the matrix stream object from bottom to top.
+// Moves the matrix object and adds its trail to the level buffer.
 //
-// -> buf: Pointer to render target (linear RGB buffer)
+// -> levels: brightness levels, LEDMatrix::height bytes per column
+//    density: see randomize()
 // <- --
 //---------------------------------------------------------------------------------------
-void MatrixObject::render( uint8_t* buf ) {
-	this->move();
+void MatrixObject::render( uint8_t* levels, int density ) {
+	this->move( density );
+	MatrixObject::compositeTrail( levels, this->x, this->y );
+}
 
-	// check boundaries
-	if( this->x < 0 || this->x >= LEDMatrix::width )
+//---------------------------------------------------------------------------------------
+// compositeTrail
+//
+// Adds a trail with its head at the given position to the level buffer. The level
+// is MATRIX_GRADIENT_LENGTH at the head and decreases by one per row upwards, every
+// pixel keeps the highest level.
+//
+// -> levels: brightness levels, LEDMatrix::height bytes per column, 0 is off
+//    x, y: position of the head
+// <- --
+//---------------------------------------------------------------------------------------
+void MatrixObject::compositeTrail( uint8_t* levels, int x, int y ) {
+	// check boundaries, clip the trail to the visible rows
+	if( x < 0 || x >= LEDMatrix::width )
 		return;
+	int top = std::max( y - MATRIX_GRADIENT_LENGTH + 1, 0 );
+	int bottom = std::min( y, LEDMatrix::height - 1 );
 
-	int currentY = this->y;
-	int ofs;
+	uint8_t* column = levels + x * LEDMatrix::height;
+	for( int row = top; row <= bottom; row++ ) {
+		uint8_t level = MATRIX_GRADIENT_LENGTH - ( y - row );
+		if( level > column[row] )
+			column[row] = level;
+	}
+}
 
-	for( palette_entry p : MatrixObject::MatrixGradient ) {
-		// only render if inside screen rectangle
-		if( currentY >= 0 && currentY < LEDMatrix::height ) {
-			ofs = LEDMatrix::getOffset( this->x, currentY );
-			buf[ofs + 0] = p.r;
-			buf[ofs + 1] = p.g;
-			buf[ofs + 2] = p.b;
+//---------------------------------------------------------------------------------------
+// resolve
+//
+// Converts the level buffer to colors
+//
+// -> levels: brightness levels, LEDMatrix::height bytes per column, 0 is off
+//    buf: Pointer to render target (linear RGB buffer)
+// <- --
+//---------------------------------------------------------------------------------------
+void MatrixObject::resolve( const uint8_t* levels, uint8_t* buf ) {
+	for( int x = 0; x < LEDMatrix::width; x++ ) {
+		for( int y = 0; y < LEDMatrix::height; y++ ) {
+			uint8_t level = *levels++;
+			if( level ) {
+				const palette_entry* p = &matrixGradient.colors[MATRIX_GRADIENT_LENGTH - level];
+				uint8_t* pixel = buf + LEDMatrix::getOffsetUnchecked( x, y );
+				pixel[0] = pgm_read_byte( &p->r );
+				pixel[1] = pgm_read_byte( &p->g );
+				pixel[2] = pgm_read_byte( &p->b );
+			}
 		}
-		currentY--;
 	}
 }
@@ -19,20 +19,28 @@
 #pragma once
 
 #include "config.h"
-#include <algorithm>
-#include <vector>
+#include <stdint.h>
+
+#define MATRIX_GRADIENT_LENGTH 12
+// upper limit of Config.matrixCount
+#define MAX_MATRIX_OBJECTS 64
+
+typedef struct _matrix_gradient_t {
+	palette_entry colors[MATRIX_GRADIENT_LENGTH];
+} matrix_gradient_t;
 
 class MatrixObject {
 public:
-	bool operator<( const MatrixObject& other ) const { return other.y < this->y; }
-	void render( uint8_t* buf );
+	void render( uint8_t* levels, int density );
 	MatrixObject();
 
+	static void compositeTrail( uint8_t* levels, int x, int y );
+	static void resolve( const uint8_t* levels, uint8_t* buf );
+
 private:
-	void randomize();
-	void move();
+	void randomize( int density );
+	void move( int density );
 
-	static const std::vector<palette_entry> MatrixGradient;
 	static const int MinMatrixSpeed = 1000;
 	static const int MaxMatrixSpeed = 6000;
 
@@ -0,0 +1,109 @@
+// ESP8266 Wordclock
+// Copyright (C) 2016 Thoralt Franz, https://github.com/thoralt
+// also (C) 2021 by Stefan Rinke, https://github.com/sker65
+//
+//  Indexed frame buffer with 2 or 4 bits per pixel. The time and the transitions only
+//  use palette indexes 0...2 (0...4 for the snake), so a frame takes 32 or 60 bytes
+//  instead of NUM_PIXELS. Pixels are stored in logical order, 16 (8) per 32 bit word,
+//  pixel i in the lowest bits of its word first. Fill, copy and mask operations work
+//  on whole words, LEDMatrix::set() expands the buffer straight into colors.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#pragma once
+
+#include <stdint.h>
+
+#include "config.h"
+
+template <int BITS> class PackedBuffer {
+	static_assert( BITS == 2 || BITS == 4, "2 or 4 bits per pixel" );
+
+public:
+	static const int PIXELS_PER_WORD = 32 / BITS;
+	static const int WORDS = ( NUM_PIXELS + PIXELS_PER_WORD - 1 ) / PIXELS_PER_WORD;
+	static const uint8_t MAX_INDEX = ( 1 << BITS ) - 1;
+	// lowest bit of every pixel in a word
+	static const uint32_t LANES = BITS == 2 ? 0x55555555u : 0x11111111u;
+
+	uint8_t get( int i ) const {
+		return ( this->words[i / PIXELS_PER_WORD] >> ( ( i % PIXELS_PER_WORD ) * BITS ) ) & MAX_INDEX;
+	}
+
+	void set( int i, uint8_t index ) {
+		int shift = ( i % PIXELS_PER_WORD ) * BITS;
+		uint32_t& w = this->words[i / PIXELS_PER_WORD];
+		w = ( w & ~( (uint32_t)MAX_INDEX << shift ) ) | ( (uint32_t)index << shift );
+	}
+
+	void fill( uint8_t index ) {
+		for( int w = 0; w < WORDS; w++ )
+			this->words[w] = LANES * index;
+	}
+
+	// sets the pixels first...last - 1
+	void fill( uint8_t index, int first, int last ) {
+		for( int w = first / PIXELS_PER_WORD; w * PIXELS_PER_WORD < last; w++ ) {
+			uint32_t m = PackedBuffer::rangeMask( w, first, last );
+			this->words[w] = ( this->words[w] & ~m ) | ( LANES * index & m );
+		}
+	}
+
+	// copies the pixels first...last - 1 of source
+	void copy( const PackedBuffer& source, int first, int last ) {
+		for( int w = first / PIXELS_PER_WORD; w * PIXELS_PER_WORD < last; w++ ) {
+			uint32_t m = PackedBuffer::rangeMask( w, first, last );
+			this->words[w] = ( this->words[w] & ~m ) | ( source.words[w] & m );
+		}
+	}
+
+	// sets the pixels 32 * word32...32 * word32 + 31 whose bit is set in bits, e. g. one
+	// word of a led_mask_t
+	void setBits( int word32, uint32_t bits, uint8_t index ) {
+		for( int part = 0; part < 32 / PIXELS_PER_WORD; part++ ) {
+			int w = word32 * ( 32 / PIXELS_PER_WORD ) + part;
+			if( w >= WORDS )
+				break;
+			uint32_t m = PackedBuffer::spread( bits >> ( part * PIXELS_PER_WORD ) ) * MAX_INDEX;
+			this->words[w] = ( this->words[w] & ~m ) | ( LANES * index & m );
+		}
+	}
+
+	uint32_t words[WORDS];
+
+private:
+	// all bits of the pixels first...last - 1 within word w
+	static uint32_t rangeMask( int w, int first, int last ) {
+		int from = first - w * PIXELS_PER_WORD;
+		int to = last - w * PIXELS_PER_WORD;
+		uint32_t m = to >= PIXELS_PER_WORD ? 0xFFFFFFFFu : ( 1u << ( to * BITS ) ) - 1;
+		if( from > 0 )
+			m &= ~( ( 1u << ( from * BITS ) ) - 1 );
+		return m;
+	}
+
+	// moves the lowest PIXELS_PER_WORD bits to the lowest bit of each pixel
+	static uint32_t spread( uint32_t x ) {
+		if( BITS == 2 ) {
+			x &= 0x0000FFFFu;
+			x = ( x | ( x << 8 ) ) & 0x00FF00FFu;
+			x = ( x | ( x << 4 ) ) & 0x0F0F0F0Fu;
+			x = ( x | ( x << 2 ) ) & 0x33333333u;
+			return ( x | ( x << 1 ) ) & 0x55555555u;
+		}
+		x &= 0x000000FFu;
+		x = ( x | ( x << 12 ) ) & 0x000F000Fu;
+		x = ( x | ( x << 6 ) ) & 0x03030303u;
+		return ( x | ( x << 3 ) ) & 0x11111111u;
+	}
+};
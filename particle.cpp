@@ -1,7 +1,11 @@
 // ESP8266 Wordclock
 // Copyright (C) 2016 Thoralt Franz, https://github.com/thoralt
 //
-//  This module encapsulates a single particle used for the exploding letters effect.
+//  This module encapsulates a single particle moving in a straight line from its
+//  starting point and fading out with the distance travelled. Positions and speeds
+//  are 16.16 fixed point, the distance is compared squared and mapped to a gradient
+//  table by its integer part, so no floating point math or sqrt() is needed per
+//  frame. The explode transition uses the same gradient in ParticlePool.
 //
 // This program is free software: you can redistribute it and/or modify
 // it under the terms of the GNU General Public License as published by
@@ -17,37 +21,84 @@
 // along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "particle.h"
 #include "ledfunctions.h"
-#include <math.h>
+
+// floor(sqrt(i)) for the integer part i of a squared distance below the maximum
+typedef struct _distance_table_t {
+	uint8_t values[MAX_PARTICLE_DISTANCE * MAX_PARTICLE_DISTANCE];
+} distance_table_t;
+
+static constexpr distance_table_t generateDistanceTable() {
+	distance_table_t t = {};
+	for( int i = 0; i < MAX_PARTICLE_DISTANCE * MAX_PARTICLE_DISTANCE; i++ ) {
+		int d = 0;
+		while( ( d + 1 ) * ( d + 1 ) <= i )
+			d++;
+		t.values[i] = d;
+	}
+	return t;
+}
+
+static constexpr distance_table_t distanceTable = generateDistanceTable();
 
 //---------------------------------------------------------------------------------------
 // brightness gradient for moving particle
 //---------------------------------------------------------------------------------------
-const float Particle::ParticleGradient[MAX_PARTICLE_DISTANCE] = { 1, 0.75, 0.5, 0.25, 0.125, 0.06, 0.03, 0.01 };
+const uint16_t particleGradient[MAX_PARTICLE_DISTANCE] = { 256, 192, 128, 64, 32, 15, 8, 3 };
+
+//---------------------------------------------------------------------------------------
+// blendLimit
+//
+// Adds a weighted color to a pixel, each channel is limited to the value of the
+// color, so overlapping particles never get brighter than the color itself
+//
+// -> pixel: first byte of the pixel in an RGB buffer
+//    color: color to add
+//    weight: [0...256]
+// <- --
+//---------------------------------------------------------------------------------------
+void blendLimit( uint8_t* pixel, const palette_entry& color, uint16_t weight ) {
+	int r = pixel[0] + ( ( color.r * weight ) >> 8 );
+	int g = pixel[1] + ( ( color.g * weight ) >> 8 );
+	int b = pixel[2] + ( ( color.b * weight ) >> 8 );
+	pixel[0] = r > color.r ? color.r : r;
+	pixel[1] = g > color.g ? color.g : g;
+	pixel[2] = b > color.b ? color.b : b;
+}
+
+//---------------------------------------------------------------------------------------
+// blendAddSaturate
+//
+// Adds a weighted color to a pixel, each channel saturates at 255
+//
+// -> pixel: first byte of the pixel in an RGB buffer
+//    color: color to add
+//    weight: [0...256]
+// <- --
+//---------------------------------------------------------------------------------------
+void blendAddSaturate( uint8_t* pixel, const palette_entry& color, uint16_t weight ) {
+	int r = pixel[0] + ( ( color.r * weight ) >> 8 );
+	int g = pixel[1] + ( ( color.g * weight ) >> 8 );
+	int b = pixel[2] + ( ( color.b * weight ) >> 8 );
+	pixel[0] = r > 255 ? 255 : r;
+	pixel[1] = g > 255 ? 255 : g;
+	pixel[2] = b > 255 ? 255 : b;
+}
 
 //---------------------------------------------------------------------------------------
 // Particle
 //
 // Constructor. Initializes coordinates and speed with given values.
 //
-// -> x: x of start coordinate
-//    y: y of start coordinate
-//    vx: x velocity
-//    vy: y velocity
+// -> x: x of start coordinate in 16.16
+//    y: y of start coordinate in 16.16
+//    vx: x velocity in 16.16 pixels per frame
+//    vy: y velocity in 16.16 pixels per frame
 //    delay: time to wait until the particle starts moving
 // <- --
 //---------------------------------------------------------------------------------------
-Particle::Particle( float x, float y, float vx, float vy, int delay ) {
-	this->x = x;
-	this->y = y;
-	this->vx = vx;
-	this->vy = vy;
-	this->x0 = x;
-	this->y0 = y;
-	this->delay = delay;
-	this->alive = true;
-}
+Particle::Particle( int32_t x, int32_t y, int32_t vx, int32_t vy, int delay ) { this->init( x, y, vx, vy, delay ); }
 
-void Particle::init( float x, float y, float vx, float vy, int delay ) {
+void Particle::init( int32_t x, int32_t y, int32_t vx, int32_t vy, int delay ) {
 	this->x = x;
 	this->y = y;
 	this->vx = vx;
@@ -69,27 +120,28 @@ void Particle::init( float x, float y, float vx, float vy, int delay ) {
 Particle::~Particle() {}
 
 //---------------------------------------------------------------------------------------
-// distance
+// distanceSquared
 //
-// Calculates the distance to the starting point of the particle
+// Calculates the squared distance to the starting point of the particle
 //
 // -> --
-// <- --
+// <- squared distance in 16.16
 //---------------------------------------------------------------------------------------
-float Particle::distance() { return this->distanceTo( this->x0, this->y0 ); }
+uint32_t Particle::distanceSquared() { return this->distanceSquaredTo( this->x0, this->y0 ); }
 
 //---------------------------------------------------------------------------------------
-// distanceTo
+// distanceSquaredTo
 //
-// Calculates the distance to a given point
+// Calculates the squared distance to a given point with 8 fractional bits per
+// coordinate, distances of 128 pixels and more are limited
 //
-// -> x, y: Point for distance test
-// <- --
+// -> x, y: Point for distance test in 16.16
+// <- squared distance in 16.16
 //---------------------------------------------------------------------------------------
-float Particle::distanceTo( float x, float y ) {
-	float dx = this->x - x;
-	float dy = this->y - y;
-	return sqrt( dx * dx + dy * dy );
+uint32_t Particle::distanceSquaredTo( int32_t x, int32_t y ) {
+	int32_t dx = std::min( std::max( ( this->x - x ) >> 8, -32767 ), 32767 );
+	int32_t dy = std::min( std::max( ( this->y - y ) >> 8, -32767 ), 32767 );
+	return (uint32_t)( dx * dx ) + (uint32_t)( dy * dy );
 }
 
 //---------------------------------------------------------------------------------------
@@ -98,9 +150,9 @@ float Particle::distanceTo( float x, float y ) {
 // Moves the particle according to the current speed.
 //
 // -> --
-// <- distance to starting point
+// <- integer part of the distance to starting point
 //---------------------------------------------------------------------------------------
-float Particle::move() {
+int Particle::move() {
 	// do not move until given delay has expired
 	if( this->delay ) {
 		this->delay--;
@@ -111,17 +163,34 @@ float Particle::move() {
 	this->y += this->vy;
 
 	// mark movement as finished if distance has reached maximum
-	float d = this->distance();
-	if( d > MAX_PARTICLE_DISTANCE )
+	uint32_t d = this->distanceSquared();
+	if( d > ( MAX_PARTICLE_DISTANCE * MAX_PARTICLE_DISTANCE ) << 16 )
 		this->alive = false;
 
-	return d;
+	d >>= 16;
+	return d < MAX_PARTICLE_DISTANCE * MAX_PARTICLE_DISTANCE ? distanceTable.values[d] : MAX_PARTICLE_DISTANCE;
+}
+
+//---------------------------------------------------------------------------------------
+// pixel
+//
+// -> target: RGB target buffer
+// <- first byte of the pixel at the current position, NULL if outside the matrix
+//---------------------------------------------------------------------------------------
+uint8_t* Particle::pixel( uint8_t* target ) {
+	// negative coordinates become large unsigned values
+	if( (uint32_t)this->x >= ( (uint32_t)LEDMatrix::width << 16 ) ||
+	    (uint32_t)this->y >= ( (uint32_t)LEDMatrix::height << 16 ) )
+		return NULL;
+	return target + LEDMatrix::getOffsetUnchecked( this->x >> 16, this->y >> 16 );
 }
 
 //---------------------------------------------------------------------------------------
 // render
 //
-// Moves the particle, renders it to the given buffer.
+// Moves the particle, renders it to the given buffer. The color fades with the
+// distance from the starting point and is added to the pixel, limited to the
+// foreground color.
 //
 // -> target: RGB target buffer (i. e. LEDMatrix::currentValues)
 //    palette: palette with background color, foreground color
@@ -129,42 +198,37 @@ float Particle::move() {
 //---------------------------------------------------------------------------------------
 void Particle::render( uint8_t* target, palette_entry palette[] ) {
 	// move particle and save traveled distance
-	int d = (int)this->move();
+	int d = this->move();
 
-	// check boundaries
-	if( this->x < 0 || this->x >= LEDMatrix::width )
-		return;
-	if( this->y < 0 || this->y >= LEDMatrix::height )
+	uint8_t* p = this->pixel( target );
+	if( !p )
 		return;
 
 	// limit distance
 	if( d >= MAX_PARTICLE_DISTANCE )
 		d = MAX_PARTICLE_DISTANCE - 1;
+	blendLimit( p, palette[1], particleGradient[d] );
+}
 
-	// get palette color for foreground
-	float pr = (float)palette[1].r;
-	float pg = (float)palette[1].g;
-	float pb = (float)palette[1].b;
-
-	// calculate offset in buffer from given coordinates
-	int ofs = LEDMatrix::getOffset( this->x, this->y );
-
-	// calculate fading color depending on distance from starting point and add it
-	// to the previous value of the pixel corresponding to the particle
-	float r = (float)target[ofs + 0] + pr * ParticleGradient[d];
-	float g = (float)target[ofs + 1] + pg * ParticleGradient[d];
-	float b = (float)target[ofs + 2] + pb * ParticleGradient[d];
-
-	// limit brightness value of each component to foreground color values
-	if( r > pr )
-		r = pr;
-	if( g > pg )
-		g = pg;
-	if( b > pb )
-		b = pb;
-
-	// write back pixel color
-	target[ofs + 0] = r;
-	target[ofs + 1] = g;
-	target[ofs + 2] = b;
+//---------------------------------------------------------------------------------------
+// renderAdd
+//
+// Moves the particle, renders it to the given buffer. The color fades with the
+// distance from the starting point and is added to the pixel, saturating at full
+// brightness.
+//
+// -> target: RGB target buffer (i. e. LEDMatrix::currentValues)
+//    color: particle color
+// <- --
+//---------------------------------------------------------------------------------------
+void Particle::renderAdd( uint8_t* target, const palette_entry& color ) {
+	int d = this->move();
+
+	uint8_t* p = this->pixel( target );
+	if( !p )
+		return;
+
+	if( d >= MAX_PARTICLE_DISTANCE )
+		d = MAX_PARTICLE_DISTANCE - 1;
+	blendAddSaturate( p, color, particleGradient[d] );
 }
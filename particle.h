@@ -20,26 +20,36 @@
 
 #include "config.h"
 #include <algorithm>
+#include <stdint.h>
 #include <vector>
 
 #define MAX_PARTICLE_DISTANCE 8
 
+// brightness gradient of a moving particle per pixel of distance from its starting
+// point in 1/256
+extern const uint16_t particleGradient[MAX_PARTICLE_DISTANCE];
+
+void blendLimit( uint8_t* pixel, const palette_entry& color, uint16_t weight );
+void blendAddSaturate( uint8_t* pixel, const palette_entry& color, uint16_t weight );
+
 class Particle {
 private:
-	static const float ParticleGradient[MAX_PARTICLE_DISTANCE];
-	float x, y, vx, vy, x0, y0;
+	// position, velocity and starting point in 16.16 fixed point
+	int32_t x, y, vx, vy, x0, y0;
 	int delay;
 
-	float move();
+	int move();
+	uint8_t* pixel( uint8_t* target );
 
 public:
 	bool alive;
 
-	Particle( float x, float y, float vx, float vy, int delay );
+	Particle( int32_t x, int32_t y, int32_t vx, int32_t vy, int delay );
 	virtual ~Particle();
-	void init( float x, float y, float vx, float vy, int delay );
+	void init( int32_t x, int32_t y, int32_t vx, int32_t vy, int delay );
 
 	void render( uint8_t* target, palette_entry palette[] );
-	float distance();
-	float distanceTo( float x, float y );
+	void renderAdd( uint8_t* target, const palette_entry& color );
+	uint32_t distanceSquared();
+	uint32_t distanceSquaredTo( int32_t x, int32_t y );
 };
@@ -0,0 +1,125 @@
+// ESP8266 Wordclock
+// Copyright (C) 2016 Thoralt Franz, https://github.com/thoralt
+// also (C) 2021 by Stefan Rinke, https://github.com/sker65
+//
+//  Fixed capacity particle pool for the explode transition. The particles are kept
+//  as structure of arrays in the pool itself, so a transition does not touch the
+//  heap. Every particle flies from its start pixel in one of PARTICLE_DIRECTIONS
+//  directions at constant speed, its position is derived from the number of frames
+//  moved and a velocity table computed by the compiler, in 16.16 fixed point.
+//
+//  The live particles are always the first count() entries: a particle reaching
+//  MAX_PARTICLE_DISTANCE is replaced by the last live one, so neither dead entries
+//  nor a separate live flag have to be scanned.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#include "particlepool.h"
+#include "ledfunctions.h"
+
+static constexpr particle_directions_t PROGMEM __attribute__( ( aligned( 4 ) ) ) particleDirections =
+    generateParticleDirections();
+
+//---------------------------------------------------------------------------------------
+// add
+//
+// Adds a particle
+//
+// -> x, y: start pixel
+//    direction: [0...PARTICLE_DIRECTIONS - 1]
+//    delay: frames to wait until the particle starts moving
+// <- false if the pool is full
+//---------------------------------------------------------------------------------------
+bool ParticlePool::add( int x, int y, int direction, uint16_t delay ) {
+	if( this->live >= PARTICLE_POOL_SIZE )
+		return false;
+
+	int i = this->live++;
+	this->originX[i] = x;
+	this->originY[i] = y;
+	this->direction[i] = direction;
+	this->steps[i] = 0;
+	this->delay[i] = delay;
+	return true;
+}
+
+//---------------------------------------------------------------------------------------
+// addExplosion
+//
+// Adds one particle per direction starting at the given pixel
+//
+// -> x, y: start pixel
+//    delay: frames to wait until the particles start moving
+// <- number of particles added
+//---------------------------------------------------------------------------------------
+int ParticlePool::addExplosion( int x, int y, uint16_t delay ) {
+	int added = 0;
+	for( int i = 0; i < PARTICLE_DIRECTIONS; i++ )
+		if( this->add( x, y, i, delay ) )
+			added++;
+	return added;
+}
+
+//---------------------------------------------------------------------------------------
+// render
+//
+// Moves all particles by one frame and adds them to the given buffer, fading with
+// the distance from the start pixel. Particles beyond MAX_PARTICLE_DISTANCE are
+// rendered a last time and removed.
+//
+// -> target: RGB target buffer (i. e. LEDMatrix::currentValues)
+//    color: particle color, also the upper limit of each channel
+// <- --
+//---------------------------------------------------------------------------------------
+void ParticlePool::render( uint8_t* target, const palette_entry& color ) {
+	int i = 0;
+	while( i < this->live ) {
+		int32_t x = this->originX[i] << 16;
+		int32_t y = this->originY[i] << 16;
+		int d = 0;
+		bool finished = false;
+
+		// do not move until given delay has expired
+		if( this->delay[i] ) {
+			this->delay[i]--;
+		} else {
+			int32_t n = ++this->steps[i];
+			int dir = this->direction[i];
+			x += n * (int16_t)pgm_read_word( &particleDirections.vx[dir] );
+			y += n * (int16_t)pgm_read_word( &particleDirections.vy[dir] );
+
+			// constant speed, the distance is proportional to the frames moved
+			uint32_t distance = n * PARTICLE_SPEED_Q16;
+			finished = distance > ( MAX_PARTICLE_DISTANCE << 16 );
+			d = distance >> 16;
+			if( d >= MAX_PARTICLE_DISTANCE )
+				d = MAX_PARTICLE_DISTANCE - 1;
+		}
+
+		// add the faded color to the pixel, limited to the particle color
+		if( x >= 0 && y >= 0 && ( x >> 16 ) < LEDMatrix::width && ( y >> 16 ) < LEDMatrix::height )
+			blendLimit( target + LEDMatrix::getOffsetUnchecked( x >> 16, y >> 16 ), color, particleGradient[d] );
+
+		if( finished ) {
+			// swap remove, the moved particle is processed in this iteration slot
+			int last = --this->live;
+			this->originX[i] = this->originX[last];
+			this->originY[i] = this->originY[last];
+			this->direction[i] = this->direction[last];
+			this->steps[i] = this->steps[last];
+			this->delay[i] = this->delay[last];
+		} else {
+			i++;
+		}
+	}
+}
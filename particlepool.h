@@ -0,0 +1,78 @@
+// ESP8266 Wordclock
+// Copyright (C) 2016 Thoralt Franz, https://github.com/thoralt
+// also (C) 2021 by Stefan Rinke, https://github.com/sker65
+//
+//  See particlepool.cpp for description.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#pragma once
+
+#include <stdint.h>
+
+#include "config.h"
+#include "fixedmath.h"
+#include "particle.h"
+
+// particles per exploding pixel, evenly spread over the full circle
+#define PARTICLE_DIRECTIONS 16
+// 0.15 pixels per frame in 16.16
+#define PARTICLE_SPEED_Q16 9830
+// upper limit of lit pixels in a time text, see the check in ledfunctions.cpp
+#define MAX_EXPLODING_PIXELS 24
+#define PARTICLE_POOL_SIZE ( MAX_EXPLODING_PIXELS * PARTICLE_DIRECTIONS )
+
+// velocity per direction in 16.16
+typedef struct _particle_directions_t {
+	int16_t vx[PARTICLE_DIRECTIONS];
+	int16_t vy[PARTICLE_DIRECTIONS];
+} particle_directions_t;
+
+//---------------------------------------------------------------------------------------
+// generateParticleDirections
+//
+// Creates the velocity table, only evaluated by the compiler
+//
+// -> --
+// <- table with speed * sin(angle), speed * cos(angle)
+//---------------------------------------------------------------------------------------
+constexpr particle_directions_t generateParticleDirections() {
+	particle_directions_t t = {};
+	sine_table_t sine = generateSineTable();
+	for( int i = 0; i < PARTICLE_DIRECTIONS; i++ ) {
+		int step = i * SINE_TABLE_STEPS / PARTICLE_DIRECTIONS;
+		t.vx[i] = PARTICLE_SPEED_Q16 * sine.values[step] / 32767;
+		t.vy[i] = PARTICLE_SPEED_Q16 * sine.values[( step + SINE_TABLE_STEPS / 4 ) % SINE_TABLE_STEPS] / 32767;
+	}
+	return t;
+}
+
+class ParticlePool {
+public:
+	void clear() { this->live = 0; }
+	bool add( int x, int y, int direction, uint16_t delay );
+	int addExplosion( int x, int y, uint16_t delay );
+	void render( uint8_t* target, const palette_entry& color );
+	int count() const { return this->live; }
+
+private:
+	// one entry per particle: start pixel, index into the direction table, frames to
+	// wait before moving and frames moved
+	uint8_t originX[PARTICLE_POOL_SIZE];
+	uint8_t originY[PARTICLE_POOL_SIZE];
+	uint8_t direction[PARTICLE_POOL_SIZE];
+	uint8_t steps[PARTICLE_POOL_SIZE];
+	uint16_t delay[PARTICLE_POOL_SIZE];
+	// particles [0...live) are alive
+	uint16_t live = 0;
+};
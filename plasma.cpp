@@ -0,0 +1,107 @@
+// ESP8266 Wordclock
+// Copyright (C) 2016 Thoralt Franz, https://github.com/thoralt
+// also (C) 2021 by Stefan Rinke, https://github.com/sker65
+//
+//  Fixed point plasma. Computes the same pattern as the former floating point
+//  version of LEDMatrix::renderPlasma()
+//
+//      sin(sqrt(100 * (cx^2 + cy^2) + 1 + t) + 6 * (xx * sin(t / 2) + yy * cos(t / 3) + t / 4))
+//      xx = x / width / 3, cx = xx + 0.5 * sin(t / 5)
+//      yy = y / height / 3, cy = yy + 0.5 * sin(t / 3)
+//
+//  with integer arithmetic only: sin() comes from a flash table with linear
+//  interpolation (see fixedmath.cpp), the squared distances are split into one table per column and
+//  row, and the square root is an integer square root. All terms that depend on t
+//  only are evaluated once per frame, leaving one square root and one table lookup
+//  per pixel.
+//
+//  The time advances with the elapsed milliseconds, so the speed of the animation
+//  does not depend on the frame rate.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#include "plasma.h"
+
+// 2^32 / (2 * pi): multiplied with radians in 16.16 and shifted by 32 gives an angle
+#define RAD_Q16_TO_ANGLE 683565276ull
+// 65536 / (2 * pi) / 256 * 1024: radians in Q8 to angle, shifted by 10
+#define RAD_Q8_TO_ANGLE_Q10 41722u
+
+// angle of radians given in 16.16, negative values wrap around
+static uint16_t radToAngle( int32_t rad ) { return (uint16_t)( ( (int64_t)rad * (int64_t)RAD_Q16_TO_ANGLE ) >> 32 ); }
+
+// angle of time * num / den, time in 16.16
+static uint16_t timeToAngle( uint32_t time, uint32_t num, uint32_t den ) {
+	return (uint16_t)( ( (uint64_t)time * num * RAD_Q16_TO_ANGLE / den ) >> 32 );
+}
+
+//---------------------------------------------------------------------------------------
+// advancePlasmaTime
+//
+// -> time: current plasma time in 16.16
+//    elapsedMs: milliseconds since the last frame, limited to PLASMA_MAX_STEP_MS
+//    speed: animation speed in percent
+// <- new plasma time in 16.16, wrapped at PLASMA_TIME_WRAP
+//---------------------------------------------------------------------------------------
+uint32_t advancePlasmaTime( uint32_t time, uint32_t elapsedMs, uint8_t speed ) {
+	if( elapsedMs > PLASMA_MAX_STEP_MS )
+		elapsedMs = PLASMA_MAX_STEP_MS;
+	time += ( elapsedMs * speed * 65536 ) / ( 1000 * 100 / PLASMA_UNITS_PER_SECOND );
+	if( time >= PLASMA_TIME_WRAP )
+		time -= PLASMA_TIME_WRAP;
+	return time;
+}
+
+//---------------------------------------------------------------------------------------
+// renderPlasmaFrame
+//
+// -> buf: palette index per pixel, width * height bytes, row by row
+//    width, height: size of the matrix, up to PLASMA_MAX_SIZE each
+//    time: plasma time in 16.16, below PLASMA_TIME_WRAP
+// <- --
+//---------------------------------------------------------------------------------------
+void renderPlasmaFrame( uint8_t* buf, int width, int height, uint32_t time ) {
+	// 100 * cx^2, 100 * cy^2 in 16.16 and the linear terms as angles
+	uint32_t cxSquare[PLASMA_MAX_SIZE], cySquare[PLASMA_MAX_SIZE];
+	uint16_t colAngle[PLASMA_MAX_SIZE], rowAngle[PLASMA_MAX_SIZE];
+
+	// 0.5 * sin() in 16.16 is sin() in Q15
+	int32_t centerX = sin16( timeToAngle( time, 1, 5 ) );
+	int32_t centerY = sin16( timeToAngle( time, 1, 3 ) );
+	int32_t waveX = sin16( timeToAngle( time, 1, 2 ) );
+	int32_t waveY = cos16( timeToAngle( time, 1, 3 ) );
+	uint16_t drift = timeToAngle( time, 6, 4 );
+
+	for( int x = 0; x < width; x++ ) {
+		int32_t xx = ( x << 16 ) / ( width * 3 );
+		int64_t cx = xx + centerX;
+		cxSquare[x] = ( cx * cx * 100 ) >> 16;
+		colAngle[x] = radToAngle( ( (int64_t)xx * 6 * waveX ) >> 15 );
+	}
+	for( int y = 0; y < height; y++ ) {
+		int32_t yy = ( y << 16 ) / ( height * 3 );
+		int64_t cy = yy + centerY;
+		cySquare[y] = ( cy * cy * 100 ) >> 16;
+		rowAngle[y] = radToAngle( ( (int64_t)yy * 6 * waveY ) >> 15 ) + drift;
+	}
+
+	for( int y = 0; y < height; y++ ) {
+		uint32_t rowBase = cySquare[y] + 65536 + time;
+		for( int x = 0; x < width; x++ ) {
+			// square root of a 16.16 value is 8.8
+			uint32_t r = isqrt32( cxSquare[x] + rowBase );
+			uint16_t angle = ( ( r * RAD_Q8_TO_ANGLE_Q10 ) >> 10 ) + colAngle[x] + rowAngle[y];
+			*buf++ = ( sin16( angle ) + 32768 ) >> 8;
+		}
+	}
+}
@@ -0,0 +1,36 @@
+// ESP8266 Wordclock
+// Copyright (C) 2016 Thoralt Franz, https://github.com/thoralt
+// also (C) 2021 by Stefan Rinke, https://github.com/sker65
+//
+//  See plasma.cpp for description.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#pragma once
+
+#include <stdint.h>
+
+#include "fixedmath.h"
+
+// plasma time is kept in units of the former formula as 16.16 fixed point, 5 units
+// per second at 100 % speed
+#define PLASMA_UNITS_PER_SECOND 5
+// all periodic terms of the plasma repeat after 60 * pi units, the time wraps after
+// a multiple of that which still keeps the radial term within 32 bits
+#define PLASMA_TIME_WRAP ( (uint32_t)( 340 * 60 * 3.14159265358979323846 * 65536 + 0.5 ) )
+// longest time step per frame, avoids jumps after switching modes or stalls
+#define PLASMA_MAX_STEP_MS 100
+#define PLASMA_MAX_SIZE 16
+
+uint32_t advancePlasmaTime( uint32_t time, uint32_t elapsedMs, uint8_t speed );
+void renderPlasmaFrame( uint8_t* buf, int width, int height, uint32_t time );
@@ -0,0 +1,125 @@
+// ESP8266 Wordclock
+// Copyright (C) 2016 Thoralt Franz, https://github.com/thoralt
+// also (C) 2021 by Stefan Rinke, https://github.com/sker65
+//
+//  Power estimation and current limiting of the output. Every frame written into the
+//  pixel buffer is summed up, the colors already include brightness and curves, so the
+//  sum times the current per channel is an estimate of what the LEDs draw. A frame
+//  above the budget (Config.powerLimit) is scaled down as a whole, which keeps the
+//  colors. The scale follows a rising load immediately and recovers within
+//  POWER_RELEASE_MS when the load drops, so a short peak (e. g. the seconds fill at 59)
+//  does not make the whole display flicker.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#include "powerlimiter.h"
+#include "fbkernels.h"
+
+static_assert( MIN_POWER_LIMIT > NUM_PIXELS * POWER_IDLE_MA, "power budget below the idle current" );
+
+//---------------------------------------------------------------------------------------
+// channelSum
+//
+// Sums up all bytes of a pixel buffer, two 16 bit lanes per 32 bit word.
+//
+// -> pixels: pixel buffer, aligned at 32 bit
+//    len: number of bytes, at most 512 so the 16 bit lanes do not overflow
+// <- sum of all bytes
+//---------------------------------------------------------------------------------------
+static uint32_t channelSum( const uint8_t* pixels, int len ) {
+	const uint32_t* words = (const uint32_t*)pixels;
+	uint32_t lanes = 0;
+	int count = len >> 2;
+	for( int i = 0; i < count; i++ ) {
+		uint32_t w = words[i];
+		lanes += ( w & 0x00FF00FF ) + ( ( w >> 8 ) & 0x00FF00FF );
+	}
+	uint32_t sum = ( lanes & 0xFFFF ) + ( lanes >> 16 );
+	for( int i = count << 2; i < len; i++ )
+		sum += pixels[i];
+	return sum;
+}
+
+static inline uint32_t channelMilliamps( uint32_t sum ) { return sum * POWER_CHANNEL_MA / 255; }
+
+//---------------------------------------------------------------------------------------
+// estimate
+//
+// Estimates the current a frame draws with the model of POWER_CHANNEL_MA and
+// POWER_IDLE_MA.
+//
+// -> pixels: pixel buffer as sent to the LEDs, aligned at 32 bit
+//    len: number of bytes
+//    pixelSize: bytes per LED
+// <- current in mA
+//---------------------------------------------------------------------------------------
+uint32_t PowerLimiter::estimate( const uint8_t* pixels, int len, int pixelSize ) {
+	return len / pixelSize * POWER_IDLE_MA + channelMilliamps( channelSum( pixels, len ) );
+}
+
+//---------------------------------------------------------------------------------------
+// apply
+//
+// Estimates the current of a frame and scales the frame down in place if it exceeds
+// the budget. The scale is chosen so the estimate of the scaled frame stays within the
+// budget, it rises by at most POWER_SCALE_MAX per POWER_RELEASE_MS and by 1/16 per
+// frame.
+//
+// -> pixels: pixel buffer as sent to the LEDs, aligned at 32 bit
+//    len: number of bytes
+//    pixelSize: bytes per LED
+//    budget: maximum current in mA, 0 = unlimited, at least MIN_POWER_LIMIT
+//    now: current time in ms
+// <- true while the scale is still rising, the next frame differs even if the colors
+//    stay the same
+//---------------------------------------------------------------------------------------
+bool PowerLimiter::apply( uint8_t* pixels, int len, int pixelSize, uint16_t budget, uint32_t now ) {
+	uint32_t idle = len / pixelSize * POWER_IDLE_MA;
+	uint32_t sum = channelSum( pixels, len );
+	// a budget at or below the idle current would leave only black frames
+	if( budget != 0 && budget < MIN_POWER_LIMIT )
+		budget = MIN_POWER_LIMIT;
+	this->milliamps = idle + channelMilliamps( sum );
+	if( this->milliamps > this->maxMilliamps )
+		this->maxMilliamps = this->milliamps;
+
+	uint16_t target = POWER_SCALE_MAX;
+	if( budget != 0 && sum != 0 && this->milliamps > budget ) {
+		// largest channel sum within the budget, the scaled sum is rounded down
+		uint32_t allowed = budget > idle ? ( budget - idle ) * 255 / POWER_CHANNEL_MA : 0;
+		target = allowed * POWER_SCALE_MAX / sum;
+	}
+
+	uint32_t elapsed = now - this->scaleMillis;
+	this->scaleMillis = now;
+	if( target < this->scale ) {
+		this->scale = target;
+	} else if( target > this->scale ) {
+		// identical frames are not shown, the first one after a pause must not jump
+		uint32_t step = elapsed < POWER_RELEASE_MS ? elapsed * POWER_SCALE_MAX / POWER_RELEASE_MS : POWER_SCALE_MAX;
+		if( step > POWER_SCALE_MAX / 16 )
+			step = POWER_SCALE_MAX / 16;
+		else if( step == 0 )
+			step = 1;
+		this->scale = (uint32_t)( target - this->scale ) > step ? this->scale + step : target;
+	}
+
+	if( this->scale < POWER_SCALE_MAX ) {
+		fbScale( pixels, pixels, len, this->scale );
+		this->limitedMilliamps = idle + channelMilliamps( sum * this->scale / POWER_SCALE_MAX );
+		this->framesLimited++;
+	} else {
+		this->limitedMilliamps = this->milliamps;
+	}
+	return this->scale < target;
+}
@@ -0,0 +1,54 @@
+// ESP8266 Wordclock
+// Copyright (C) 2016 Thoralt Franz, https://github.com/thoralt
+// also (C) 2021 by Stefan Rinke, https://github.com/sker65
+//
+//  See powerlimiter.cpp for description.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#pragma once
+
+#include <stdint.h>
+
+// current model of a WS2812B: each color channel draws up to POWER_CHANNEL_MA at 255,
+// linear with the PWM duty cycle, plus POWER_IDLE_MA per LED for the controller
+#define POWER_CHANNEL_MA 20
+#define POWER_IDLE_MA 1
+// the scale of a limited frame rises back to full within this time (milliseconds)
+// after the load dropped, it falls immediately
+#define POWER_RELEASE_MS 500
+#define POWER_SCALE_MAX 256
+
+class PowerLimiter {
+public:
+	static uint32_t estimate( const uint8_t* pixels, int len, int pixelSize );
+	bool apply( uint8_t* pixels, int len, int pixelSize, uint16_t budget, uint32_t now );
+
+	// estimated current of the last frame in mA before and after limiting and the
+	// maximum estimate before limiting
+	uint32_t getMilliamps() { return this->milliamps; }
+	uint32_t getLimitedMilliamps() { return this->limitedMilliamps; }
+	uint32_t getMaxMilliamps() { return this->maxMilliamps; }
+	// factor 0...POWER_SCALE_MAX applied to the last frame
+	uint16_t getScale() { return this->scale; }
+	// frames scaled down so far
+	uint32_t getFramesLimited() { return this->framesLimited; }
+
+private:
+	uint32_t milliamps = 0;
+	uint32_t limitedMilliamps = 0;
+	uint32_t maxMilliamps = 0;
+	uint16_t scale = POWER_SCALE_MAX;
+	uint32_t scaleMillis = 0;
+	uint32_t framesLimited = 0;
+};
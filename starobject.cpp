@@ -1,7 +1,10 @@
 // ESP8266 Wordclock
 // Copyright (C) 2016 Thoralt Franz, https://github.com/thoralt
 //
-//  This class represents a start object for the stars screen saver.
+//  This class represents a start object for the stars screen saver. The stars
+//  share a grid with one occupancy bit per pixel, a new position is drawn from the
+//  cells far enough from all other stars with a fixed number of row operations
+//  instead of retrying random positions.
 //
 // This program is free software: you can redistribute it and/or modify
 // it under the terms of the GNU General Public License as published by
@@ -18,6 +21,7 @@
 
 #include "starobject.h"
 #include "ledfunctions.h"
+#include <string.h>
 
 //---------------------------------------------------------------------------------------
 // StarObject
@@ -30,52 +34,116 @@
 StarObject::StarObject() {}
 
 //---------------------------------------------------------------------------------------
-// randomize
+// clear
 //
-// Assigns new random coordinates and speed, retries until new coordinates have a
-// distance of minimum 2 LEDs.
+// Marks all cells as free
 //
-// -> allStars: Reference to outer container for distance calculation to other stars
+// -> --
 // <- --
 //---------------------------------------------------------------------------------------
-void StarObject::randomize( std::vector<StarObject>& allStars ) {
-	// set coordinates of self to default value
-	this->x = -1;
-	this->y = -1;
+void StarGrid::clear() { memset( this->rows, 0, sizeof( this->rows ) ); }
 
-	int retryCount = 0;
-	bool distanceOK;
-	int newX = 0, newY = 0, dx, dy;
-
-	do {
-		// assume distance is OK
-		distanceOK = true;
+//---------------------------------------------------------------------------------------
+// freeCells
+//
+// Calculates the cells with a distance of at least minimumDistanceSquared to all
+// occupied cells by spreading each row of the occupancy bits to its neighbours.
+//
+// -> free: STAR_GRID_HEIGHT rows receiving one bit per free cell
+// <- number of free cells
+//---------------------------------------------------------------------------------------
+int StarGrid::freeCells( uint16_t* free ) const {
+	// dx * dx + dy * dy < 5 covers dx = -2...2 in the same row, -1...1 in the rows
+	// above and below and dx = 0 two rows away
+	static_assert( StarGrid::minimumDistanceSquared == 5, "exclusion shape" );
+	uint16_t blocked[STAR_GRID_HEIGHT + 4] = {};
+	for( int y = 0; y < STAR_GRID_HEIGHT; y++ ) {
+		uint16_t r = this->rows[y];
+		uint16_t near = r | ( r << 1 ) | ( r >> 1 );
+		blocked[y] |= r;
+		blocked[y + 1] |= near;
+		blocked[y + 2] |= near | ( r << 2 ) | ( r >> 2 );
+		blocked[y + 3] |= near;
+		blocked[y + 4] |= r;
+	}
 
-		// create new random pair
-		newX = random( LEDMatrix::width );
-		newY = random( LEDMatrix::height );
-		retryCount++;
+	int count = 0;
+	for( int y = 0; y < STAR_GRID_HEIGHT; y++ ) {
+		free[y] = ~blocked[y + 2] & ( ( 1 << STAR_GRID_WIDTH ) - 1 );
+		count += __builtin_popcount( free[y] );
+	}
+	return count;
+}
 
-		// iterate over all other stars and check distance to newly generated coordinate
-		for( StarObject s : allStars ) {
-			// skip if default value
-			if( s.x == -1 )
-				continue;
+//---------------------------------------------------------------------------------------
+// place
+//
+// Chooses a random cell keeping the minimum distance to all occupied cells and marks
+// it as occupied. If there is no such cell, any unoccupied cell is chosen.
+//
+// -> x, y: receive the chosen cell
+// <- false if all cells are occupied
+//---------------------------------------------------------------------------------------
+bool StarGrid::place( int& x, int& y ) {
+	uint16_t free[STAR_GRID_HEIGHT];
+	int count = this->freeCells( free );
+	if( count == 0 ) {
+		for( int row = 0; row < STAR_GRID_HEIGHT; row++ ) {
+			free[row] = ~this->rows[row] & ( ( 1 << STAR_GRID_WIDTH ) - 1 );
+			count += __builtin_popcount( free[row] );
+		}
+		if( count == 0 )
+			return false;
+	}
 
-			// calculate distance
-			dx = newX - s.x;
-			dy = newY - s.y;
-			if( dx * dx + dy * dy < StarObject::minimumDistanceSquared ) {
-				// retry if distance to any star is below limit
-				distanceOK = false;
-				break;
-			}
+	// find the n-th free cell
+	int n = random( count );
+	for( int row = 0; row < STAR_GRID_HEIGHT; row++ ) {
+		uint16_t bits = free[row];
+		int c = __builtin_popcount( bits );
+		if( n >= c ) {
+			n -= c;
+			continue;
 		}
-	} while( !distanceOK && retryCount < 100 );
+		while( n-- )
+			bits &= bits - 1;
+		x = __builtin_ctz( bits );
+		y = row;
+		this->rows[y] |= 1 << x;
+		return true;
+	}
+	return false;
+}
+
+//---------------------------------------------------------------------------------------
+// release
+//
+// Marks a cell as free
+//
+// -> x, y: cell
+// <- --
+//---------------------------------------------------------------------------------------
+void StarGrid::release( int x, int y ) { this->rows[y] &= ~( 1 << x ); }
 
-	this->x = newX;
-	this->y = newY;
-	this->speed = 15 + random( 15 );
+//---------------------------------------------------------------------------------------
+// randomize
+//
+// Assigns new random coordinates with a distance of minimum 2 LEDs to the other stars
+// if possible and a new speed.
+//
+// -> grid: occupancy of all stars, updated with the new coordinates
+// <- --
+//---------------------------------------------------------------------------------------
+void StarObject::randomize( StarGrid& grid ) {
+	if( this->x >= 0 )
+		grid.release( this->x, this->y );
+	if( !grid.place( this->x, this->y ) ) {
+		// more stars than pixels, share one
+		this->x = random( STAR_GRID_WIDTH );
+		this->y = random( STAR_GRID_HEIGHT );
+	}
+	// 15...29 per 10 ms
+	this->speed = ( 15 + random( 15 ) ) * STAR_STEP_MS / 10;
 	this->state = 0;
 	this->brightness = 0;
 }
@@ -86,11 +154,10 @@ void StarObject::randomize( std::vector<StarObject>& allStars ) {
 // Updates the state of the star object. Increases brightness up to maximum, then
 // decreases to zero, then randomizes to new coordinates and speed and starts again.
 //
-// -> allStars: Reference to vector containing all stars, necessary for distance
-//              calculation when creating new random position
+// -> grid: occupancy of all stars, necessary for choosing a new random position
 // <- --
 //---------------------------------------------------------------------------------------
-void StarObject::update( std::vector<StarObject>& allStars ) {
+void StarObject::update( StarGrid& grid ) {
 	// increase or decrease brightness depending on current state
 	if( this->state == 0 ) {
 		this->brightness += this->speed;
@@ -105,7 +172,7 @@ void StarObject::update( std::vector<StarObject>& allStars ) {
 			// switch to increasing mode and get new random coordinates
 			this->brightness = 0;
 			this->state = 0;
-			this->randomize( allStars );
+			this->randomize( grid );
 		}
 	}
 }
@@ -116,12 +183,11 @@ void StarObject::update( std::vector<StarObject>& allStars ) {
 // Updates own status (see StarObject::update()) and renders self to buffer.
 //
 // -> buf: RGB buffer for LED colors
-//    allStars: Reference to vector containing all stars, necessary for distance
-//              calculation when creating new random position
+//    grid: occupancy of all stars, necessary for choosing a new random position
 // <- --
 //---------------------------------------------------------------------------------------
-void StarObject::render( uint8_t* buf, std::vector<StarObject>& allStars ) {
-	this->update( allStars );
+void StarObject::render( uint8_t* buf, StarGrid& grid ) {
+	this->update( grid );
 
 	// write brightness to target buffer
 	int offset = LEDMatrix::getOffset( this->x, this->y );
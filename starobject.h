@@ -19,21 +19,41 @@
 #pragma once
 
 #include <stdint.h>
-#include <vector>
+
+// size of the star grid, equals the LED matrix
+#define STAR_GRID_WIDTH 11
+#define STAR_GRID_HEIGHT 10
+// one brightness step per STAR_STEP_MS, the frames in between are interpolated
+#define STAR_STEP_MS 50
+
+class StarGrid {
+public:
+	// stars closer than this (squared distance in pixels) exclude each other
+	const static int minimumDistanceSquared = 5;
+
+	void clear();
+	bool place( int& x, int& y );
+	void release( int x, int y );
+	bool isOccupied( int x, int y ) const { return this->rows[y] & ( 1 << x ); }
+	int freeCells( uint16_t* free ) const;
+
+private:
+	// one bit per occupied pixel, bit x of rows[y]
+	uint16_t rows[STAR_GRID_HEIGHT] = {};
+};
 
 class StarObject {
 public:
 	StarObject();
-	void render( uint8_t* buf, std::vector<StarObject>& allStars );
-	void randomize( std::vector<StarObject>& allStars );
+	void render( uint8_t* buf, StarGrid& grid );
+	void randomize( StarGrid& grid );
 
 private:
-	const static int minimumDistanceSquared = 5;
 	int x = -1;
 	int y = -1;
 	int speed = 0;
 	int count = 0;
 	int brightness = 0;
 	int state = 0;
-	void update( std::vector<StarObject>& allStars );
+	void update( StarGrid& grid );
 };
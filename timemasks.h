@@ -0,0 +1,139 @@
+// ESP8266 Wordclock
+// Copyright (C) 2016 Thoralt Franz, https://github.com/thoralt
+// also (C) 2021 by Stefan Rinke, https://github.com/sker65
+//
+//  Compile time index for the time word templates. The minute and hour templates
+//  (see ledfunctions.cpp) are turned by the compiler into one bit mask over all LEDs
+//  per layout, minute type and 5 minute slot and per layout, full hour flag and hour,
+//  so rendering the time is an OR of two masks read from flash.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#pragma once
+
+#include <initializer_list>
+#include <stdint.h>
+
+#include "config.h"
+
+#define NUM_LAYOUTS 3
+#define NUM_MINUTE_TYPES 2
+#define NUM_MINUTE_SLOTS 12
+#define NUM_HOUR_TEMPLATES 13
+#define MAX_TEMPLATE_LEDS 16
+#define LED_MASK_WORDS ( ( NUM_PIXELS + 31 ) / 32 )
+
+// list of LED indexes, initialized like an array: { 7, 8, 9, 10 }
+typedef struct _led_list_t {
+	uint8_t count;
+	uint8_t leds[MAX_TEMPLATE_LEDS];
+
+	constexpr _led_list_t( std::initializer_list<int> l ) : count( 0 ), leds{} {
+		for( int i : l )
+			leds[count++] = i;
+	}
+} led_list_t;
+
+typedef struct _leds_template_t {
+	int param0, param1, param2;
+	led_list_t LEDs;
+} leds_template_t;
+
+// one bit per LED, bit i of word i / 32 for LED i
+typedef struct _led_mask_t {
+	uint32_t words[LED_MASK_WORDS];
+} led_mask_t;
+
+typedef struct _time_masks_t {
+	led_mask_t minutes[NUM_LAYOUTS][NUM_MINUTE_TYPES][NUM_MINUTE_SLOTS];
+	// 1 if the next hour has to be displayed (e. g. 09:45 = quarter to *TEN*)
+	uint8_t hourAdjust[NUM_LAYOUTS][NUM_MINUTE_TYPES][NUM_MINUTE_SLOTS];
+	// index 0: minute < 5 (full hour), 1: minute >= 5; hours 0...11
+	led_mask_t hours[NUM_LAYOUTS][2][12];
+} time_masks_t;
+
+constexpr void addToMask( led_mask_t& mask, const led_list_t& l ) {
+	for( int i = 0; i < l.count; i++ )
+		mask.words[l.leds[i] >> 5] |= 1u << ( l.leds[i] & 31 );
+}
+
+//---------------------------------------------------------------------------------------
+// generateTimeMasks
+//
+// Creates the mask index from the minute and hour templates, using the same matching
+// rules renderTime() applied to the templates before: the first minute template
+// containing the minute and the first hour template matching hour and special case.
+//
+// -> minutes: minute templates per layout and minute type
+//    hours: hour templates per layout
+// <- mask index
+//---------------------------------------------------------------------------------------
+constexpr time_masks_t generateTimeMasks(
+    const leds_template_t ( &minutes )[NUM_LAYOUTS][NUM_MINUTE_TYPES][NUM_MINUTE_SLOTS],
+    const leds_template_t ( &hours )[NUM_LAYOUTS][NUM_HOUR_TEMPLATES] ) {
+	time_masks_t t = {};
+	for( int l = 0; l < NUM_LAYOUTS; l++ ) {
+		for( int mt = 0; mt < NUM_MINUTE_TYPES; mt++ ) {
+			for( int slot = 0; slot < NUM_MINUTE_SLOTS; slot++ ) {
+				int m = slot * 5;
+				for( const leds_template_t& tp : minutes[l][mt] ) {
+					if( m >= tp.param1 && m <= tp.param2 ) {
+						addToMask( t.minutes[l][mt][slot], tp.LEDs );
+						t.hourAdjust[l][mt][slot] = tp.param0;
+						break;
+					}
+				}
+			}
+		}
+
+		for( int full = 0; full < 2; full++ ) {
+			for( int h = 0; h < 12; h++ ) {
+				for( const leds_template_t& tp : hours[l] ) {
+					if( ( tp.param1 == h || tp.param2 == h ) &&
+					    ( ( tp.param0 == 1 && full == 0 ) || ( tp.param0 == 2 && full == 1 ) || tp.param0 == 0 ) ) {
+						addToMask( t.hours[l][full][h], tp.LEDs );
+						break;
+					}
+				}
+			}
+		}
+	}
+	return t;
+}
+
+//---------------------------------------------------------------------------------------
+// maxTimeLeds
+//
+// Counts the LEDs of the longest time text, only evaluated by the compiler
+//
+// -> t: mask index
+// <- highest number of LEDs lit by minute and hour words together
+//---------------------------------------------------------------------------------------
+constexpr int maxTimeLeds( const time_masks_t& t ) {
+	int result = 0;
+	for( int l = 0; l < NUM_LAYOUTS; l++ ) {
+		for( int mt = 0; mt < NUM_MINUTE_TYPES; mt++ ) {
+			for( int slot = 0; slot < NUM_MINUTE_SLOTS; slot++ ) {
+				for( int h = 0; h < 12; h++ ) {
+					int count = 0;
+					for( int w = 0; w < LED_MASK_WORDS; w++ )
+						count += __builtin_popcount( t.minutes[l][mt][slot].words[w] |
+						                             t.hours[l][slot > 0 ? 1 : 0][h].words[w] );
+					if( count > result )
+						result = count;
+				}
+			}
+		}
+	}
+	return result;
+}
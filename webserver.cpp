@@ -23,6 +23,7 @@
 #include <stdio.h>
 
 #include "brightness.h"
+#include "framescheduler.h"
 #include "ledfunctions.h"
 #include "ntp.h"
 #include "webserver.h"
@@ -72,6 +73,7 @@ void WebServer::begin() {
 	this->server = new ESP8266WebServer( 80 );
 
 	this->server->on( "/info", std::bind( &WebServer::handleInfo, this ) );
+	this->server->on( "/power", std::bind( &WebServer::handlePower, this ) );
 	this->server->on( "/saveconfig", std::bind( &WebServer::handleSaveConfig, this ) );
 	this->server->on( "/loadconfig", std::bind( &WebServer::handleLoadConfig, this ) );
 	this->server->on( "/config", std::bind( &WebServer::handleGetConfig, this ) );
@@ -442,6 +444,94 @@ void WebServer::handleSetVar() {
 			} else {
 				err = "ERR: fillMode not in range 0..?";
 			}
+		} else if( this->server->arg( "name" ) == "fadeTime" ) {
+			int v = this->server->arg( "value" ).toInt();
+			if( v < 0 || v > MAX_FADE_TIME ) {
+				err = "ERR: fadeTime not in range 0..10000";
+			} else {
+				Config.fadeTime = v;
+				mustSave = true;
+			}
+		} else if( this->server->arg( "name" ) == "fadeEasing" ) {
+			int v = this->server->arg( "value" ).toInt();
+			if( v < 0 || v > MAX_FADE_EASING ) {
+				err = "ERR: fadeEasing not in range 0..3";
+			} else {
+				Config.fadeEasing = v;
+				mustSave = true;
+			}
+		} else if( this->server->arg( "name" ) == "plasmaSpeed" ) {
+			int v = this->server->arg( "value" ).toInt();
+			if( v < MIN_PLASMA_SPEED || v > MAX_PLASMA_SPEED ) {
+				err = "ERR: plasmaSpeed not in range 10..250";
+			} else {
+				Config.plasmaSpeed = v;
+				mustSave = true;
+			}
+		} else if( this->server->arg( "name" ) == "matrixCount" ) {
+			int v = this->server->arg( "value" ).toInt();
+			if( v < 1 || v > MAX_MATRIX_COUNT ) {
+				err = "ERR: matrixCount not in range 1..64";
+			} else {
+				Config.matrixCount = v;
+				mustSave = true;
+			}
+		} else if( this->server->arg( "name" ) == "matrixDensity" ) {
+			int v = this->server->arg( "value" ).toInt();
+			if( v < MIN_MATRIX_DENSITY || v > MAX_MATRIX_DENSITY ) {
+				err = "ERR: matrixDensity not in range 25..250";
+			} else {
+				Config.matrixDensity = v;
+				mustSave = true;
+			}
+		} else if( this->server->arg( "name" ) == "background" ) {
+			int v = this->server->arg( "value" ).toInt();
+			if( v < 0 || v > MAX_BACKGROUND ) {
+				err = "ERR: background not in range 0..4";
+			} else {
+				Config.background = v;
+				mustSave = true;
+			}
+		} else if( this->server->arg( "name" ) == "backgroundLevel" ) {
+			int v = this->server->arg( "value" ).toInt();
+			if( v < 0 || v > 255 ) {
+				err = "ERR: backgroundLevel not in range 0..255";
+			} else {
+				Config.backgroundLevel = v;
+				mustSave = true;
+			}
+		} else if( this->server->arg( "name" ) == "crossfadeTime" ) {
+			int v = this->server->arg( "value" ).toInt();
+			if( v < 0 || v > MAX_FADE_TIME ) {
+				err = "ERR: crossfadeTime not in range 0..10000";
+			} else {
+				Config.crossfadeTime = v;
+				mustSave = true;
+			}
+		} else if( this->server->arg( "name" ) == "ditherBrightness" ) {
+			int v = this->server->arg( "value" ).toInt();
+			if( v < 0 || v > MAX_DITHER_BRIGHTNESS ) {
+				err = "ERR: ditherBrightness not in range 0..256";
+			} else {
+				Config.ditherBrightness = v;
+				mustSave = true;
+			}
+		} else if( this->server->arg( "name" ) == "ledOutput" ) {
+			int v = this->server->arg( "value" ).toInt();
+			if( v < 0 || v > MAX_LED_OUTPUT ) {
+				err = "ERR: ledOutput not in range 0..2";
+			} else {
+				Config.ledOutput = v;
+				mustSave = true;
+			}
+		} else if( this->server->arg( "name" ) == "powerLimit" ) {
+			int v = this->server->arg( "value" ).toInt();
+			if( v != 0 && ( v < MIN_POWER_LIMIT || v > MAX_POWER_LIMIT ) ) {
+				err = "ERR: powerLimit not 0 or in range 500..10000";
+			} else {
+				Config.powerLimit = v;
+				mustSave = true;
+			}
 		} else {
 			err = "ERR: var name not valid";
 		}
@@ -503,6 +593,17 @@ void WebServer::handleGetConfig() {
 	          "\"tmpl\": %i, "
 	          "\"displaymode\": %i, "
 	          "\"fillMode\": %i, "
+	          "\"fadeTime\": %i, "
+	          "\"fadeEasing\": %i, "
+	          "\"plasmaSpeed\": %i, "
+	          "\"matrixCount\": %i, "
+	          "\"matrixDensity\": %i, "
+	          "\"background\": %i, "
+	          "\"backgroundLevel\": %i, "
+	          "\"crossfadeTime\": %i, "
+	          "\"ditherBrightness\": %i, "
+	          "\"ledOutput\": %i, "
+	          "\"powerLimit\": %i, "
 	          "\"fg\": \"#%02x%02x%02x\", "
 	          "\"bg\": \"#%02x%02x%02x\", "
 	          "\"s\": \"#%02x%02x%02x\" "
@@ -511,8 +612,10 @@ void WebServer::handleGetConfig() {
 	          Config.showItIs ? "true" : "false", Config.fgRainbow ? "true" : "false",
 	          Config.autoOnOff ? "true" : "false", Config.minuteType, Config.rainbowSpeed, Config.timeZone,
 	          Brightness.brightnessOverride, Config.autoOnHour, Config.autoOnMin, Config.autoOffHour, Config.autoOffMin,
-	          Config.tmpl, (int)Config.defaultMode, Config.fillMode, Config.fg.r, Config.fg.g, Config.fg.b, Config.bg.r,
-	          Config.bg.g, Config.bg.b, Config.s.r, Config.s.g, Config.s.b );
+	          Config.tmpl, (int)Config.defaultMode, Config.fillMode, Config.fadeTime, Config.fadeEasing, Config.plasmaSpeed,
+	          Config.matrixCount, Config.matrixDensity, Config.background, Config.backgroundLevel, Config.crossfadeTime,
+	          Config.ditherBrightness, Config.ledOutput, Config.powerLimit, Config.fg.r, Config.fg.g, Config.fg.b,
+	          Config.bg.r, Config.bg.g, Config.bg.b, Config.s.r, Config.s.g, Config.s.b );
 	Serial.printf( "WebServer::handleConfig %s\r\n", buf );
 	this->server->send( 200, applicationJson, buf );
 }
@@ -530,6 +633,8 @@ void WebServer::handleInfo() {
 	snprintf( buf, RESPONSE_BUF_SIZE,
 	          "{"
 	          "\"heap\": %i, "
+	          "\"heapfragmentation\": %i, "
+	          "\"maxfreeblock\": %i, "
 	          "\"sketchsize\": %i, "
 	          "\"sketchspace\": %i, "
 	          "\"cpufrequency\": %i, "
@@ -541,15 +646,60 @@ void WebServer::handleInfo() {
 	          "\"flashspeed\": %i, "
 	          "\"flashsize\": %i, "
 	          "\"resetreason\": \"%s\", "
-	          "\"resetinfo\": \"%s\" "
+	          "\"resetinfo\": \"%s\", "
+	          "\"framessent\": %u, "
+	          "\"framesskipped\": %u, "
+	          "\"framesmissed\": %u, "
+	          "\"framejitteravg\": %u, "
+	          "\"framejittermax\": %u, "
+	          "\"framesdeferred\": %u, "
+	          "\"framerender\": %u, "
+	          "\"framerendermax\": %u, "
+	          "\"frametransfer\": %u, "
+	          "\"ledoutput\": \"%s\", "
+	          "\"showcycles\": %u, "
+	          "\"showcyclesmax\": %u "
 	          "}",
-	          ESP.getFreeHeap(), ESP.getSketchSize(), ESP.getFreeSketchSpace(), ESP.getCpuFreqMHz(), ESP.getChipId(),
-	          ESP.getSdkVersion(), ESP.getBootVersion(), ESP.getBootMode(), ESP.getFlashChipId(), ESP.getFlashChipSpeed(),
-	          ESP.getFlashChipRealSize(), ESP.getResetReason().c_str(), ESP.getResetInfo().c_str() );
+	          ESP.getFreeHeap(), ESP.getHeapFragmentation(), ESP.getMaxFreeBlockSize(), ESP.getSketchSize(),
+	          ESP.getFreeSketchSpace(), ESP.getCpuFreqMHz(), ESP.getChipId(), ESP.getSdkVersion(), ESP.getBootVersion(),
+	          ESP.getBootMode(), ESP.getFlashChipId(), ESP.getFlashChipSpeed(), ESP.getFlashChipRealSize(),
+	          ESP.getResetReason().c_str(), ESP.getResetInfo().c_str(), LED.getFramesSent(), LED.getFramesSkipped(),
+	          FrameScheduler.missedDeadlines, FrameScheduler.jitterAvgMicros(), FrameScheduler.jitterMaxMicros,
+	          LED.getFramesDeferred(), LED.getRenderMicros(), LED.getRenderMaxMicros(), LED.getTransferMicros(),
+	          LED.getOutput()->getName(), LED.getOutput()->getShowCycles(), LED.getOutput()->getShowMaxCycles() );
 	Serial.printf( "WebServer::handleInfo %s\r\n", buf );
 	this->server->send( 200, applicationJson, buf );
 }
 
+//---------------------------------------------------------------------------------------
+// handlePower
+//
+// Handles requests to "/power", replies with JSON structure containing the estimated
+// current of the last frame (mA) before and after the power limiter, the maximum
+// estimate, the budget (Config.powerLimit, 0 = no limit), the scale 0...256 applied
+// to the last frame and the number of frames scaled down so far
+//
+// -> --
+// <- --
+//---------------------------------------------------------------------------------------
+void WebServer::handlePower() {
+	char buf[RESPONSE_BUF_SIZE];
+	PowerLimiter& limiter = LED.getPowerLimiter();
+	snprintf( buf, RESPONSE_BUF_SIZE,
+	          "{"
+	          "\"current\": %u, "
+	          "\"currentlimited\": %u, "
+	          "\"currentmax\": %u, "
+	          "\"limit\": %u, "
+	          "\"limiting\": %s, "
+	          "\"scale\": %u, "
+	          "\"frameslimited\": %u "
+	          "}",
+	          limiter.getMilliamps(), limiter.getLimitedMilliamps(), limiter.getMaxMilliamps(), Config.powerLimit,
+	          limiter.getScale() < POWER_SCALE_MAX ? "true" : "false", limiter.getScale(), limiter.getFramesLimited() );
+	this->server->send( 200, applicationJson, buf );
+}
+
 //---------------------------------------------------------------------------------------
 // extractColor
 //
@@ -53,6 +53,7 @@ private:
 	void handleSetHeartbeat();
 	void handleGetHeartbeat();
 	void handleInfo();
+	void handlePower();
 	void handleD();
 	void handleH();
 	void handleM();